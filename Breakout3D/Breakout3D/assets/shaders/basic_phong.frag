@@ -10,8 +10,12 @@ uniform vec3 uAlbedo;
 
 uniform int uUseTex;
 uniform sampler2D uTex;
+// Texture array (unit 1): frames de animações, amostrados por layer.
+uniform sampler2DArray uTexArray;
+uniform float uTexLayer;
 // 0: modulate base RGB with texture RGB (default for meshes/backgrounds)
 // 1: treat texture R as an alpha mask (default for font atlases)
+// 2: like 0, but from uTexArray at layer uTexLayer
 uniform int uTexMode;
 
 // UI vs 3D controls
@@ -32,8 +36,13 @@ void main() {
     vec3 base = uAlbedo;
     float texMask = 1.0;
     if (uUseTex == 1) {
-        vec4 tex = texture(uTex, vUV);
-        if (uTexMode == 0) {
+        vec4 tex;
+        if (uTexMode == 2) {
+            tex = texture(uTexArray, vec3(vUV, uTexLayer));
+        } else {
+            tex = texture(uTex, vUV);
+        }
+        if (uTexMode == 0 || uTexMode == 2) {
             base *= tex.rgb;
         } else if (uTexMode == 1) {
             texMask = tex.r;
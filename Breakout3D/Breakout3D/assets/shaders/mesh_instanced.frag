@@ -0,0 +1,39 @@
+#version 330 core
+in vec3 vWorldPos;
+in vec3 vNormal;
+in vec2 vUV;
+flat in float vLayer;
+
+uniform vec3 uViewPos;
+uniform vec3 uLightPos;
+uniform vec3 uLightColor;
+uniform vec3 uAlbedo;
+
+uniform sampler2DArray uTexArray;
+
+uniform float uAmbientK;
+uniform float uDiffuseK;
+uniform float uSpecK;
+uniform float uShininess;
+
+out vec4 FragColor;
+
+// Mesmo Phong do basic_phong.frag (modo 3D), com a textura vinda do array por layer.
+void main() {
+    vec3 base = uAlbedo * texture(uTexArray, vec3(vUV, vLayer)).rgb;
+
+    vec3 N = normalize(vNormal);
+    vec3 L = normalize(uLightPos - vWorldPos);
+    vec3 V = normalize(uViewPos - vWorldPos);
+
+    vec3 color = uAmbientK * base;
+
+    float diff = max(dot(N, L), 0.0);
+    color += (uDiffuseK * diff) * base * uLightColor;
+
+    vec3 R = reflect(-L, N);
+    float spec = pow(max(dot(V, R), 0.0), uShininess);
+    color += (uSpecK * spec) * uLightColor;
+
+    FragColor = vec4(color, 1.0);
+}
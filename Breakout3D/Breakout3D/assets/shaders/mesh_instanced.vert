@@ -0,0 +1,26 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+
+// Por instância: posição + layer do texture array, e escala (M = translate * scale).
+layout(location = 3) in vec4 iPosLayer;
+layout(location = 4) in vec3 iSize;
+
+uniform mat4 uV;
+uniform mat4 uP;
+
+out vec3 vWorldPos;
+out vec3 vNormal;
+out vec2 vUV;
+flat out float vLayer;
+
+void main() {
+    vec3 world = iPosLayer.xyz + aPos * iSize;
+    vWorldPos = world;
+    // Só escala (sem rotação): inverse-transpose = divisão pela escala.
+    vNormal = aNormal / iSize;
+    vUV = aUV;
+    vLayer = iPosLayer.w;
+    gl_Position = uP * uV * vec4(world, 1.0);
+}
@@ -0,0 +1,59 @@
+// AssetFS.hpp
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @file AssetFS.hpp
+ * @brief Camada de ficheiros virtual: lê assets do pack `.b3dpak` (mmap) ou do disco.
+ *
+ * Notas:
+ * - `mountPack()` é chamado uma vez no arranque (antes de carregar assets); sem pack, tudo vem do disco.
+ * - Ordem de procura: pack montado -> ficheiro solto (útil em desenvolvimento, sem re-empacotar).
+ * - Paths lógicos são relativos à pasta do jogo (ex.: "assets/models/Ball.obj");
+ *   paths absolutos dentro da pasta actual também são aceites.
+ * - Depois de montado, o pack é só leitura: `read()`/`exists()` podem correr em threads de decode.
+ */
+
+/// Bytes de um asset: aponta para o mmap do pack (zero-copy) ou para `owned`.
+struct AssetData {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    std::vector<unsigned char> owned;
+
+    AssetData() = default;
+    AssetData(const AssetData&) = delete;
+    AssetData& operator=(const AssetData&) = delete;
+    AssetData(AssetData&&) = default;
+    AssetData& operator=(AssetData&&) = default;
+
+    bool empty() const { return size == 0; }
+};
+
+class AssetFS {
+public:
+    /// Abre e mapeia o pack. Devolve false (com log) se não existir ou for inválido.
+    static bool mountPack(const std::string& pakPath);
+    static void unmountPack();
+    static bool packMounted();
+
+    /// true se o asset existir no pack ou no disco.
+    static bool exists(const std::string& path);
+
+    /// Lê o asset inteiro. Zero-copy para entries do pack não comprimidas.
+    static bool read(const std::string& path, AssetData& out);
+
+    /// Igual a read(), mas devolve sempre uma cópia (para APIs que precisam de std::string/istream).
+    static bool readText(const std::string& path, std::string& out);
+
+    /// Paths (lógicos) no pack que começam por `dirPrefix/`. Vazio se não houver pack.
+    static std::vector<std::string> listPacked(const std::string& dirPrefix);
+
+    /// true se o path existir dentro do pack (sem olhar para o disco).
+    static bool inPack(const std::string& path);
+};
+
+} // namespace engine
@@ -0,0 +1,40 @@
+// FixedStep.hpp
+#pragma once
+
+namespace engine {
+
+/**
+ * @file FixedStep.hpp
+ * @brief Acumulador de passo fixo: converte o dt variável do frame num nº inteiro de passos de simulação.
+ *
+ * Notas:
+ * - O frame "deposita" o dt (`advance`) e recebe quantos passos de `step()` segundos deve correr.
+ * - `maxSteps` limita o trabalho por frame: se o frame foi demasiado longo, o excesso é descartado
+ *   (a simulação abranda em vez de entrar em "spiral of death").
+ * - `alpha()` é a fracção do próximo passo já acumulada (0..1): usada pelo render para interpolar
+ *   entre o estado anterior e o actual.
+ */
+class FixedStep {
+public:
+    explicit FixedStep(float hz = 240.0f, int maxSteps = 8);
+
+    /// Acumula `frameDt` e devolve o nº de passos a correr neste frame (0..maxSteps).
+    int advance(float frameDt);
+
+    /// Esquece o tempo acumulado (ex.: ao reiniciar uma run).
+    void reset();
+
+    float step()  const { return m_step; }
+    float alpha() const { return (float)(m_acc / (double)m_step); }
+
+    /// Passos descartados pelo clamp desde o início (diagnóstico).
+    long long droppedSteps() const { return m_dropped; }
+
+private:
+    float m_step;
+    int m_maxSteps;
+    double m_acc = 0.0; // double: evita drift ao somar milhares de dt pequenos
+    long long m_dropped = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,80 @@
+// FramePacer.hpp
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace engine {
+
+class Window;
+
+/**
+ * @file FramePacer.hpp
+ * @brief Limitador de FPS (sleep + spin) com modo idle de baixo consumo e métricas por modo.
+ *
+ * Notas:
+ * - `endFrame()` chama-se 1x por frame, depois do swap; bloqueia até ao próximo deadline.
+ * - ACTIVE: `sleep_for` até perto do deadline e depois spin (yield) até lá. A margem de spin
+ *   adapta-se ao erro de sleep medido (o scheduler do SO acorda tarde por 0.1..2ms).
+ * - IDLE (menu/pausa/fim de jogo): FPS baixo via `Window::waitEvents(timeout)`; qualquer input
+ *   acorda logo o loop (nunca acima do FPS activo).
+ * - BACKGROUND (janela minimizada): como IDLE, com um FPS ainda mais baixo.
+ * - Mede, por modo: frames, frame time médio, p50/p99, desvio padrão (jitter) e CPU% do processo.
+ */
+class FramePacer {
+public:
+    enum class Mode { Active = 0, Idle = 1, Background = 2 };
+
+    FramePacer();
+
+    /// FPS alvo em gameplay (0 = sem limite).
+    void setTargetFps(double fps) { m_targetFps = fps; }
+    /// FPS em idle (menu/pausa/game over).
+    void setIdleFps(double fps) { m_idleFps = fps; }
+    /// FPS com a janela minimizada.
+    void setBackgroundFps(double fps) { m_backgroundFps = fps; }
+
+    double targetFps() const { return m_targetFps; }
+
+    /// Espera até ao fim do frame actual segundo o modo pedido.
+    void endFrame(Window& window, Mode mode);
+
+    /// Escreve as métricas acumuladas (stderr) e, se `reset`, recomeça a janela de medição.
+    void logStats(bool reset);
+
+    /// Se > 0, `endFrame` faz `logStats(true)` a cada N segundos.
+    void setStatsInterval(double seconds) { m_statsInterval = seconds; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct ModeStats {
+        static constexpr int kBuckets = 1000; // histograma de 0.1ms (0..100ms)
+        std::uint64_t frames = 0;
+        double sumMs = 0.0;
+        double sumSqMs = 0.0;
+        double maxMs = 0.0;
+        double wallSec = 0.0;
+        double cpuSec = 0.0;
+        std::uint32_t hist[kBuckets] = {};
+    };
+
+    void sleepUntil(clock::time_point deadline);
+    void record(Mode mode, double frameMs, double cpuSec);
+
+    double m_targetFps = 0.0;
+    double m_idleFps = 30.0;
+    double m_backgroundFps = 5.0;
+
+    clock::time_point m_frameStart{};   // fim do último endFrame (= início do frame actual)
+    clock::time_point m_deadline{};     // deadline "ideal" (acumulado para não derivar)
+    bool m_hasStart = false;
+    double m_lastCpuSec = 0.0;
+
+    double m_spinMarginSec = 0.002;     // adapta-se ao erro de sleep observado
+
+    ModeStats m_stats[3];
+    double m_statsInterval = 0.0;
+    clock::time_point m_statsStart{};
+};
+
+} // namespace engine
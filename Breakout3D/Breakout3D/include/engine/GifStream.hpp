@@ -0,0 +1,174 @@
+// GifStream.hpp
+#pragma once
+
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @file GifStream.hpp
+ * @brief GIF em streaming: decoder frame-a-frame + reprodução com ring limitado de frames.
+ *
+ * Notas:
+ * - `GifDecoder` devolve um frame composto (RGBA) de cada vez; nunca descodifica o GIF inteiro.
+ * - `StreamingGif` descodifica à frente da reprodução num worker e guarda só um ring pequeno.
+ * - RAM (decoder + ring) e VRAM (array de 2 layers) ficam dentro de `GifStreamOptions::budgetBytes`.
+ * - A timeline (soma prefixa dos delays dos frames mostrados) é montada uma vez no open, a partir
+ *   dos blocos do GIF; `frameAtTime` encontra o frame do instante com `upper_bound` (O(log n)).
+ * - `frameAtTime`/`destroy` requerem contexto OpenGL activo; o worker nunca toca em GL.
+ */
+
+/// Decoder GIF incremental (canvas RGBA já com disposal/transparência aplicados).
+class GifDecoder {
+public:
+    GifDecoder();
+    ~GifDecoder();
+
+    GifDecoder(const GifDecoder&) = delete;
+    GifDecoder& operator=(const GifDecoder&) = delete;
+
+    /// Abre o GIF (pack ou disco). @return false se não existir ou não for GIF.
+    bool open(const std::string& path);
+    void close();
+
+    /// Volta ao primeiro frame (para loop).
+    bool rewind();
+
+    /**
+     * @brief Descodifica o frame seguinte.
+     * @param delayMs Delay do frame em ms (0 se o GIF não definir).
+     * @return Canvas RGBA w*h*4 (válido até à próxima chamada), ou nullptr no fim/erro.
+     */
+    const unsigned char* next(int& delayMs);
+
+    int width() const;
+    int height() const;
+
+    /// Nº de frames (contado no open() percorrendo os blocos, sem descodificar).
+    int frameCount() const;
+
+    /// Delay de cada frame em ms, lido das Graphic Control Extensions no open() (0 se o GIF não definir).
+    const std::vector<int>& frameDelaysMs() const;
+
+    /// Memória de trabalho (canvas, fundo, histórico, bytes comprimidos se não estiverem mapeados).
+    std::size_t workingBytes() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m;
+};
+
+struct GifStreamOptions {
+    std::size_t budgetBytes = 16u << 20; ///< RAM+VRAM máximos por preview (mín. efectivo: 2 frames no ring)
+    int frameStep = 2;                   ///< mostra 1 em cada N frames (delays dos saltados são somados)
+    bool flipY = true;
+};
+
+/**
+ * @brief Preview GIF em streaming (decode num worker, upload de 1 frame quando fica "due").
+ *
+ * O worker enche um ring de frames RGBA e bloqueia quando está cheio; o thread GL consome
+ * pelo relógio (delays do GIF). Na GPU é um GL_TEXTURE_2D_ARRAY de 2 layers: o upload vai
+ * para a layer que não está a ser mostrada e o UI amostra por layer (sem rebind/sem stall).
+ *
+ * Com ARB_buffer_storage o ring é um PBO mapeado de forma persistente: o memcpy acontece no
+ * worker, o thread GL só agenda `glTexSubImage3D` a partir do PBO e usa uma fence para saber
+ * quando o slot pode voltar ao worker. Sem a extensão, o ring fica em RAM (upload síncrono).
+ */
+class StreamingGif {
+public:
+    StreamingGif() = default;
+    ~StreamingGif() { stop(); }
+
+    StreamingGif(const StreamingGif&) = delete;
+    StreamingGif& operator=(const StreamingGif&) = delete;
+
+    /// Lança o worker (não bloqueia: o ficheiro é aberto no worker).
+    void start(const std::string& path, const GifStreamOptions& opt = GifStreamOptions());
+
+    /// Pára o worker e liberta RAM (não toca em GL; seguro em destrutores).
+    void stop();
+
+    /// stop() + apaga o texture array.
+    void destroy();
+
+    bool started() const { return m_worker.joinable(); }
+    bool failed() const { return m_failed.load(); }
+
+    /// true quando já existe um frame na GPU.
+    bool ready() const { return m_layer >= 0; }
+
+    /// GL_TEXTURE_2D_ARRAY do preview (0 enquanto não houver frames).
+    GLuint texture() const { return m_tex; }
+
+    /**
+     * @brief (GL thread) Avança a reprodução até `tSec` e faz upload do frame actual se mudou.
+     * @return Layer de `texture()` a desenhar (-1 enquanto não houver frames).
+     */
+    int frameAtTime(float tSec);
+
+    /// Memória reservada por este preview (decoder + ring + textura).
+    std::size_t residentBytes() const { return m_residentBytes.load(); }
+
+    /// Bytes de um frame RGBA (0 enquanto o worker não abriu o ficheiro).
+    std::size_t frameBytes() const { return (std::size_t)m_w * (std::size_t)m_h * 4; }
+
+private:
+    struct Slot {
+        unsigned char* data = nullptr;  // PBO mapeado (persistente) ou `cpu`
+        std::vector<unsigned char> cpu; // fallback sem ARB_buffer_storage
+        int frame = 0;                  // índice na timeline (frames mostrados, volta a 0 no loop)
+    };
+
+    void run(std::string path, GifStreamOptions opt);
+    void ensureStorage(); // GL thread: cria o ring (PBO) pedido pelo worker
+    void retireUpload();  // GL thread: liberta o slot em voo quando a fence sinaliza
+    void upload(int slot);
+    int timelineFrame(float tSec) const; // frame da timeline no instante (relativo a m_t0)
+    float frameStartSec(int frame) const;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+    std::atomic<bool> m_failed{false};
+    std::atomic<std::size_t> m_residentBytes{0};
+
+    // Ring (protegido por m_mutex; o conteúdo do slot da frente é lido sem lock pelo thread GL).
+    std::vector<Slot> m_slots;
+    int m_head = 0;
+    int m_count = 0;
+    int m_held = 0; // slots à cabeça ainda a ser lidos pela GPU (fence pendente)
+    int m_w = 0;
+    int m_h = 0;
+    bool m_storageRequested = false;
+    bool m_storageReady = false;
+
+    // endMs[i] = fim do frame mostrado i desde o início do loop (escrito pelo worker antes de
+    // pedir o ring; só leitura depois).
+    std::vector<int> m_endMs;
+
+    // PBO persistente que guarda o ring (só thread GL cria/apaga).
+    GLuint m_pbo = 0;
+    unsigned char* m_pboPtr = nullptr;
+    std::size_t m_pboBytes = 0;
+    GLsync m_fence = nullptr;
+
+    // Estado de reprodução (só thread GL).
+    static constexpr int kGpuLayers = 2;
+    GLuint m_tex = 0;
+    int m_layer = -1;
+    int m_frame = -1;     // frame da timeline que está na GPU
+    float m_t0 = 0.0f;    // instante em que o loop começou (re-sincronizado depois de pausas)
+    float m_lastT = 0.0f; // último `tSec` visto
+};
+
+} // namespace engine
@@ -14,13 +14,31 @@ class Window;
  * - `keyDown` = mantida; `keyPressed` = transição (solta->carregada) no frame.
  * - Posição do rato em pixels do framebuffer (útil para UI com DPI scaling).
  * - `update(Window&)` deve ser chamado 1x por frame (após pollEvents).
+ * - Para outro thread (simulação): `sample()` no thread da janela, `applySamples()` no outro.
+ *   Os edges (pressed) já vêm calculados na amostra, por isso não se perdem entre frames.
  */
-enum class Key { Escape, Left, Right, A, D, Space, K1, K2, K3, K4, K5, K6, K7, K8, K9, K0, Minus, L, R };
+enum class Key { Escape, Left, Right, A, D, Space, K1, K2, K3, K4, K5, K6, K7, K8, K9, K0, Minus, L, R, Backspace };
 enum class MouseButton { Left };
 
+/// Amostra de input (POD) para atravessar threads via fila.
+struct InputSample {
+    static constexpr int KEY_COUNT = 20;
+
+    bool keyDown[KEY_COUNT]{};
+    bool keyPressed[KEY_COUNT]{};
+    bool mouseDown[1]{};
+    bool mousePressed[1]{};
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+    float scrollY = 0.0f;
+
+    /// Junta `next` a esta amostra (estado = `next`, edges = OR, scroll = soma).
+    void mergeNewer(const InputSample& next);
+};
+
 class Input {
 public:
-    static constexpr int KEY_COUNT = 19;
+    static constexpr int KEY_COUNT = InputSample::KEY_COUNT;
 
     /// Actualiza estados (down/pressed), posição do rato e delta de scroll do frame.
     void update(Window& window);
@@ -37,12 +55,18 @@ public:
     /// @return Delta de scroll Y desde o último `update()` (positivo = scroll up no GLFW).
     float mouseScrollY() const { return m_scrollY; }
 
+    /// Estado actual como amostra (para enviar ao thread da simulação).
+    InputSample sample() const;
+
+    /// Substitui o estado por um lote de amostras (mais antiga primeiro); count=0 = sem eventos novos.
+    void applySamples(const InputSample* samples, int count);
+
 private:
     bool m_keyDown[KEY_COUNT]{};
-    bool m_keyPrev[KEY_COUNT]{};
+    bool m_keyPressed[KEY_COUNT]{};
 
     bool m_mouseDown[1]{};
-    bool m_mousePrev[1]{};
+    bool m_mousePressed[1]{};
 
     float m_mouseX = 0.0f;
     float m_mouseY = 0.0f;
@@ -0,0 +1,82 @@
+// Ktx2Format.hpp
+#pragma once
+#include <cstdint>
+
+namespace engine::ktx2 {
+
+/**
+ * @file Ktx2Format.hpp
+ * @brief Subconjunto do contentor KTX2 usado pelo motor (texturas 2D com mips pré-calculados).
+ *
+ * Layout (little-endian):
+ *   [identifier 12B][Header][Index][LevelIndex x levelCount][DFD][KVD][mip data]
+ *
+ * Notas:
+ * - Suportado: 2D, 1 layer, 1 face, sem supercompression.
+ * - Formatos: RGBA8 (fallback universal), BC1/BC3 (s3tc) e BC7 (bptc).
+ * - O nível 0 é o maior; os mips vêm guardados por ordem decrescente de offset (mais pequeno primeiro).
+ * - Partilhado entre o runtime (Texture2D::loadKTX2) e a tool offline (tools/ktx2conv).
+ */
+
+constexpr std::uint8_t kIdentifier[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+
+// VkFormat (só os que o motor usa)
+constexpr std::uint32_t kVkR8G8B8A8Unorm = 37;
+constexpr std::uint32_t kVkBc1RgbUnorm   = 131;
+constexpr std::uint32_t kVkBc1RgbaUnorm  = 133;
+constexpr std::uint32_t kVkBc3Unorm      = 137;
+constexpr std::uint32_t kVkBc7Unorm      = 145;
+
+struct Header {
+    std::uint32_t vkFormat;
+    std::uint32_t typeSize;
+    std::uint32_t pixelWidth;
+    std::uint32_t pixelHeight;
+    std::uint32_t pixelDepth;
+    std::uint32_t layerCount;
+    std::uint32_t faceCount;
+    std::uint32_t levelCount;
+    std::uint32_t supercompressionScheme;
+};
+static_assert(sizeof(Header) == 36, "ktx2::Header layout");
+
+struct Index {
+    std::uint32_t dfdByteOffset;
+    std::uint32_t dfdByteLength;
+    std::uint32_t kvdByteOffset;
+    std::uint32_t kvdByteLength;
+    std::uint64_t sgdByteOffset;
+    std::uint64_t sgdByteLength;
+};
+static_assert(sizeof(Index) == 32, "ktx2::Index layout");
+
+struct LevelIndex {
+    std::uint64_t byteOffset;
+    std::uint64_t byteLength;
+    std::uint64_t uncompressedByteLength;
+};
+static_assert(sizeof(LevelIndex) == 24, "ktx2::LevelIndex layout");
+
+constexpr std::uint32_t kLevelIndexOffset = 12 + sizeof(Header) + sizeof(Index); // 80
+
+/// Bytes por bloco 4x4 (0 = formato não comprimido).
+inline std::uint32_t blockBytes(std::uint32_t vkFormat) {
+    switch (vkFormat) {
+        case kVkBc1RgbUnorm:
+        case kVkBc1RgbaUnorm: return 8;
+        case kVkBc3Unorm:
+        case kVkBc7Unorm: return 16;
+        default: return 0;
+    }
+}
+
+/// Tamanho esperado de um nível (w x h em texels) para o formato.
+inline std::uint64_t levelBytes(std::uint32_t vkFormat, std::uint32_t w, std::uint32_t h) {
+    std::uint32_t bb = blockBytes(vkFormat);
+    if (bb == 0) return (std::uint64_t)w * h * 4; // RGBA8
+    return (std::uint64_t)((w + 3) / 4) * ((h + 3) / 4) * bb;
+}
+
+} // namespace engine::ktx2
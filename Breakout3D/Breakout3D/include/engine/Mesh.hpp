@@ -12,7 +12,8 @@ namespace engine {
  * Notas:
  * - `kd` vem do MTL (diffuse).
  * - `textureId` = 0 significa “sem textura”.
- * - `destroy()` liberta VAO/VBO/EBO (contexto GL activo).
+ * - `textureId` vem do TextureCache (partilhado entre meshes com o mesmo map_Kd).
+ * - `destroy()` liberta VAO/VBO/EBO e larga a referência da textura (contexto GL activo).
  * - `setBaseDirPath()` facilita caminhos relativos para assets.
  */
 struct Mesh {
@@ -27,6 +28,10 @@ struct Mesh {
     /// Liberta buffers OpenGL e reseta IDs.
     void destroy();
 
+    /// Atributos 0 pos, 1 normal, 2 uv para o VBO ligado em GL_ARRAY_BUFFER (VAO activo).
+    /// Usado no load e por VAOs extra que reutilizam os buffers (ex.: instancing no Renderer).
+    static void bindVertexLayout();
+
     /// Define a pasta base usada para resolver caminhos relativos (OBJ/MTL/texturas).
     static void setBaseDirPath(const std::string& baseDirPath);
 
@@ -0,0 +1,95 @@
+// PakFormat.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace engine::pak {
+
+/**
+ * @file PakFormat.hpp
+ * @brief Layout binário do ficheiro de assets empacotados (`.b3dpak`).
+ *
+ * Layout (little-endian, tudo POD):
+ *   [Header][payloads alinhados a `alignment`][Entry x entryCount][names blob]
+ *
+ * Notas:
+ * - As entries estão ordenadas por `hash` (FNV-1a 64 do path normalizado) -> lookup por binary search.
+ * - Colisões de hash são resolvidas comparando o nome (names blob, strings terminadas em '\0').
+ * - `flags & kFlagZlib`: payload comprimido (zlib); `rawSize` é o tamanho descomprimido.
+ * - Partilhado entre o runtime (engine::AssetFS) e a tool de empacotamento (tools/b3dpak).
+ */
+
+constexpr char kMagic[8] = {'B', '3', 'D', 'P', 'A', 'K', '\0', '\0'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kDefaultAlignment = 64;
+
+constexpr std::uint32_t kFlagZlib = 1u << 0;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint64_t indexOffset;
+    std::uint64_t namesOffset;
+    std::uint64_t namesSize;
+    std::uint32_t alignment;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(Header) == 48, "pak::Header layout");
+
+struct Entry {
+    std::uint64_t hash;
+    std::uint64_t offset;  // início do payload (absoluto no ficheiro)
+    std::uint64_t size;    // bytes guardados
+    std::uint64_t rawSize; // bytes depois de descomprimir (== size se não comprimido)
+    std::uint32_t nameOffset; // offset dentro do names blob
+    std::uint32_t flags;
+};
+static_assert(sizeof(Entry) == 40, "pak::Entry layout");
+
+/// FNV-1a 64 bits (estável entre plataformas; usado como chave do índice).
+inline std::uint64_t hashPath(std::string_view s) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/// Normaliza um path lógico: '/' como separador, sem "./" inicial nem segmentos "a/..".
+inline std::string normalizePath(std::string_view in) {
+    std::string out;
+    out.reserve(in.size());
+    std::string seg;
+
+    auto flushSeg = [&]() {
+        if (seg.empty() || seg == ".") {
+            // ignora
+        } else if (seg == "..") {
+            size_t cut = out.find_last_of('/');
+            std::string_view last = (cut == std::string::npos) ? std::string_view(out)
+                                                               : std::string_view(out).substr(cut + 1);
+            if (!out.empty() && last != "..") {
+                out.resize(cut == std::string::npos ? 0 : cut);
+            } else {
+                if (!out.empty()) out += '/';
+                out += "..";
+            }
+        } else {
+            if (!out.empty()) out += '/';
+            out += seg;
+        }
+        seg.clear();
+    };
+
+    for (char c : in) {
+        if (c == '/' || c == '\\') flushSeg();
+        else seg += c;
+    }
+    flushSeg();
+    return out;
+}
+
+} // namespace engine::pak
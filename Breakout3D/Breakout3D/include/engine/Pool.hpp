@@ -0,0 +1,187 @@
+// Pool.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace engine {
+
+/**
+ * @file Pool.hpp
+ * @brief Pool de capacidade fixa para entidades transitórias (pickups, VFX, popups).
+ *
+ * Notas:
+ * - Armazenamento inline (`T m_items[N]`): nunca aloca, nem ao copiar (o GameState é copiado
+ *   para o snapshot de render a cada frame e para o ring de rewind).
+ * - Denso: os vivos estão em [0, size()); iterar é percorrer um array.
+ * - `swapRemove(i)` é O(1): o último passa para `i` (a ordem não é estável). Para remover dentro
+ *   de um loop: não avançar `i` depois de remover (o elemento trazido também tem de ser visto).
+ * - `removeIf` compacta numa passagem e mantém a ordem (para quem desenha pela ordem, ex. stacks).
+ * - Cheia: `push` devolve nullptr e conta em `dropped()`; quem chama ignora (o spawn não acontece).
+ * - `Handles = true`: handles estáveis (slot + geração) que sobrevivem aos swaps; um handle de
+ *   um elemento removido deixa de resolver, mesmo que o slot seja reutilizado (verificado no
+ *   `make allocs`).
+ * - Só tipos trivialmente copiáveis: a cópia e o snapshot são memcpy do prefixo vivo.
+ */
+struct PoolHandle {
+    std::uint16_t slot = 0xFFFF;
+    std::uint16_t gen = 0;
+    bool valid() const { return slot != 0xFFFF; }
+};
+
+template <class T, std::size_t N, bool Handles = false>
+class Pool {
+    static_assert(std::is_trivially_copyable<T>::value, "Pool: só tipos trivialmente copiáveis");
+    static_assert(N > 0 && N < 0xFFFF, "Pool: capacidade fora de 1..65534");
+
+public:
+    Pool() {
+        if constexpr (Handles) {
+            for (std::size_t i = 0; i < N; ++i) {
+                m_slotOf[i] = (std::uint16_t)i;
+                m_denseOf[i] = (std::uint16_t)i;
+                m_gen[i] = 0;
+            }
+        }
+    }
+
+    Pool(const Pool& o) { copyFrom(o); }
+    Pool& operator=(const Pool& o) {
+        if (this != &o) copyFrom(o);
+        return *this;
+    }
+
+    static constexpr std::size_t capacity() { return N; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == N; }
+
+    /// Pushes recusados por a pool estar cheia (diagnóstico para afinar N).
+    std::uint32_t dropped() const { return m_dropped; }
+
+    T* data() { return m_items; }
+    const T* data() const { return m_items; }
+    T* begin() { return m_items; }
+    T* end() { return m_items + m_size; }
+    const T* begin() const { return m_items; }
+    const T* end() const { return m_items + m_size; }
+
+    T& operator[](std::size_t i) { return m_items[i]; }
+    const T& operator[](std::size_t i) const { return m_items[i]; }
+
+    /// Acrescenta no fim; nullptr se cheia.
+    T* push(const T& v) {
+        if (m_size == N) {
+            m_dropped++;
+            return nullptr;
+        }
+        if constexpr (Handles) m_denseOf[m_slotOf[m_size]] = (std::uint16_t)m_size;
+        m_items[m_size] = v;
+        return &m_items[m_size++];
+    }
+
+    /// Remove `i` trazendo o último para o seu lugar.
+    void swapRemove(std::size_t i) {
+        const std::size_t last = m_size - 1;
+        if constexpr (Handles) {
+            const std::uint16_t dead = m_slotOf[i];
+            m_gen[dead]++;
+            m_slotOf[i] = m_slotOf[last];
+            m_slotOf[last] = dead; // o slot morto fica na zona livre [size, N)
+            m_denseOf[m_slotOf[i]] = (std::uint16_t)i;
+        }
+        if (i != last) m_items[i] = m_items[last];
+        m_size = last;
+    }
+
+    /// Remove todos os elementos com `pred(e)` verdadeiro, mantendo a ordem dos restantes.
+    template <class Pred>
+    void removeIf(Pred&& pred) {
+        std::size_t w = 0;
+        for (std::size_t i = 0; i < m_size; ++i) {
+            if (pred(m_items[i])) {
+                if constexpr (Handles) m_gen[m_slotOf[i]]++;
+                continue;
+            }
+            if (w != i) {
+                m_items[w] = m_items[i];
+                if constexpr (Handles) {
+                    const std::uint16_t s = m_slotOf[w];
+                    m_slotOf[w] = m_slotOf[i];
+                    m_slotOf[i] = s;
+                    m_denseOf[m_slotOf[w]] = (std::uint16_t)w;
+                }
+            }
+            ++w;
+        }
+        m_size = w;
+    }
+
+    void clear() {
+        if constexpr (Handles) {
+            for (std::size_t i = 0; i < m_size; ++i) m_gen[m_slotOf[i]]++;
+        }
+        m_size = 0;
+    }
+
+    /**
+     * @brief Muda o nº de vivos sem inicializar os novos (para o load do snapshot escrever por cima).
+     * @return false se `n` passa da capacidade (a pool fica como estava).
+     */
+    bool resize(std::size_t n) {
+        static_assert(!Handles, "Pool::resize: pools com handles não entram em snapshots");
+        if (n > N) return false;
+        m_size = n;
+        return true;
+    }
+
+    // --- handles estáveis (Handles = true) ---
+
+    PoolHandle handleAt(std::size_t i) const {
+        static_assert(Handles, "Pool: handles desligados (Handles = false)");
+        const std::uint16_t s = m_slotOf[i];
+        return PoolHandle{ s, m_gen[s] };
+    }
+
+    /// Elemento do handle, ou nullptr se já foi removido.
+    T* get(PoolHandle h) {
+        static_assert(Handles, "Pool: handles desligados (Handles = false)");
+        if (h.slot >= N || m_gen[h.slot] != h.gen) return nullptr;
+        const std::uint16_t d = m_denseOf[h.slot];
+        return d < m_size ? &m_items[d] : nullptr;
+    }
+    const T* get(PoolHandle h) const { return const_cast<Pool*>(this)->get(h); }
+
+    bool remove(PoolHandle h) {
+        if (!get(h)) return false;
+        swapRemove(m_denseOf[h.slot]);
+        return true;
+    }
+
+private:
+    void copyFrom(const Pool& o) {
+        m_size = o.m_size;
+        m_dropped = o.m_dropped;
+        if (m_size) std::memcpy(m_items, o.m_items, m_size * sizeof(T));
+        if constexpr (Handles) {
+            std::memcpy(m_slotOf, o.m_slotOf, sizeof(m_slotOf));
+            std::memcpy(m_denseOf, o.m_denseOf, sizeof(m_denseOf));
+            std::memcpy(m_gen, o.m_gen, sizeof(m_gen));
+        }
+    }
+
+    static constexpr std::size_t kHandleSlots = Handles ? N : 1;
+
+    T m_items[N];
+    std::size_t m_size = 0;
+    std::uint32_t m_dropped = 0;
+
+    // Handles: m_slotOf é uma permutação dos slots (os primeiros size estão vivos, pela ordem
+    // densa); m_denseOf[slot] = posição densa; m_gen[slot] sobe a cada remoção.
+    std::uint16_t m_slotOf[kHandleSlots];
+    std::uint16_t m_denseOf[kHandleSlots];
+    std::uint16_t m_gen[kHandleSlots];
+};
+
+} // namespace engine
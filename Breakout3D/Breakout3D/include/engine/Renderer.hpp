@@ -2,11 +2,22 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "engine/Shader.hpp"
 #include "engine/Mesh.hpp"
+#include "engine/Texture.hpp"
 
 namespace engine {
 
+/// Instância para `Renderer::drawMeshInstanced` (layout igual ao VBO de instâncias: 32 bytes).
+struct MeshInstance {
+    glm::vec3 pos;       ///< centro (M = translate(pos) * scale(size))
+    float layer = 0.0f;  ///< layer do TextureArray2D
+    glm::vec3 size;
+    float pad = 0.0f;
+};
+
 /**
  * @file Renderer.hpp
  * @brief Renderer OpenGL: pass 3D (mundo) + pass UI (ortho) com shader unificado.
@@ -15,6 +26,9 @@ namespace engine {
  * - UI trabalha em pixels do framebuffer (x,y,w,h).
  * - Fonte UI é um atlas baked (stb_truetype) gerido internamente.
  * - Helpers `uiSetDepthTest` e `uiSetScissor` cobrem casos especiais no UI.
+ * - `drawMeshInstanced` desenha N cópias de um mesh num único draw call (textura por layer).
+ * - `instanceScratch()` é a lista de instâncias reutilizada entre frames (a capacidade fica),
+ *   para o render do mundo não alocar nem guardar estado em statics.
  * - Inicialização/destruição requerem contexto OpenGL activo.
  */
 class Renderer {
@@ -37,6 +51,14 @@ public:
     /// Overload completo (matriz modelo).
     void drawMesh(const Mesh& mesh, const glm::mat4& M, const glm::vec3& tint = glm::vec3(1.0f));
 
+    /// Desenha todas as instâncias com um único `glDrawElementsInstanced` (sem rotação).
+    void drawMeshInstanced(const Mesh& mesh, const TextureArray2D& texArray,
+                           const std::vector<MeshInstance>& instances,
+                           const glm::vec3& tint = glm::vec3(1.0f));
+
+    /// Lista de instâncias do renderer, para preencher e passar a `drawMeshInstanced` (fazer `clear()` antes).
+    std::vector<MeshInstance>& instanceScratch() { return m_instScratch; }
+
     // ---------- UI PASS ----------
 
     /// Inicia pass UI em ortho (coords em px do framebuffer).
@@ -49,6 +71,9 @@ public:
     /// Quad UI com textura (tint/alpha via color).
     void drawUIQuad(float x, float y, float w, float h, const glm::vec4& color, unsigned int textureId);
 
+    /// Quad UI a partir de uma layer de um GL_TEXTURE_2D_ARRAY (ex.: frames de GIF; trocar de frame = trocar layer).
+    void drawUIQuadLayer(float x, float y, float w, float h, const glm::vec4& color, unsigned int textureArrayId, int layer);
+
     /// Texto no HUD via atlas baked.
     void drawUIText(float x, float y, const std::string& text, float scale = 1.0f, const glm::vec4& color = glm::vec4(1.0f));
 
@@ -83,6 +108,13 @@ private:
     GLuint m_uiVao = 0;
     GLuint m_uiVbo = 0;
 
+    // Instancing: VBO de instâncias partilhado + um VAO por mesh (chave: mesh.vao).
+    Shader m_instShader;
+    GLuint m_instVbo = 0;
+    std::unordered_map<GLuint, GLuint> m_instVaos;
+    std::vector<MeshInstance> m_instScratch;
+    GLuint instancedVaoFor(const Mesh& mesh);
+
     glm::mat4 m_V{1.0f}, m_P{1.0f};
     glm::vec3 m_camPos{0,0,0};
 
@@ -109,6 +141,9 @@ private:
     int m_uiFbH = 0;
 
     bool loadUIFont(const std::string& ttfPath);
+
+    /// layer < 0: GL_TEXTURE_2D em uTex; caso contrário GL_TEXTURE_2D_ARRAY em uTexArray.
+    void drawUITexturedQuad(float x, float y, float w, float h, const glm::vec4& color, unsigned int textureId, int layer);
 };
 
 } // namespace engine
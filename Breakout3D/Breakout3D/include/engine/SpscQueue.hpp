@@ -0,0 +1,46 @@
+// SpscQueue.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+namespace engine {
+
+/**
+ * @file SpscQueue.hpp
+ * @brief Fila circular lock-free de capacidade fixa (1 produtor, 1 consumidor).
+ *
+ * Notas:
+ * - `push` só no thread produtor, `pop` só no consumidor; nenhum dos dois bloqueia.
+ * - `N` tem de ser potência de 2; cabem N-1 elementos.
+ * - Fila cheia: `push` devolve false e o produtor decide (ex.: fundir com o próximo item).
+ * - head/tail em cache lines separadas para não haver false sharing.
+ */
+template <class T, std::size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue: N tem de ser potência de 2");
+
+public:
+    bool push(const T& v) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t next = (tail + 1) & (N - 1);
+        if (next == m_head.load(std::memory_order_acquire)) return false; // cheia
+        m_items[tail] = v;
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false; // vazia
+        out = m_items[head];
+        m_head.store((head + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+private:
+    T m_items[N];
+    alignas(64) std::atomic<std::size_t> m_head{0}; // consumidor
+    alignas(64) std::atomic<std::size_t> m_tail{0}; // produtor
+};
+
+} // namespace engine
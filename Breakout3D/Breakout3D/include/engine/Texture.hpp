@@ -1,27 +1,57 @@
 // Texture.hpp
 #pragma once
 #include <GL/glew.h>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace engine {
 
 /**
  * @file Texture.hpp
- * @brief Textura 2D OpenGL (load do disco e upload directo de RGBA).
+ * @brief Textura 2D OpenGL (load do disco, KTX2 pré-comprimido e upload directo de RGBA).
  *
  * Notas:
  * - `loadFromFile()` suporta flipY para alinhar UV/origem.
+ * - Se existir um `.ktx2` ao lado da imagem (tools/ktx2conv), é usado em vez do PNG:
+ *   mips pré-calculados e BC1/BC3/BC7 quando o driver suporta (senão volta ao PNG).
  * - `loadFromRGBA()` é útil para atlas de fonte, frames GIF e texturas geradas.
+ * - `TextureArray2D` junta várias imagens (mesmo tamanho) num GL_TEXTURE_2D_ARRAY,
+ *   para desenhar variantes com um único bind (layer escolhida no shader).
  * - `destroy()` liberta o id OpenGL (contexto GL activo).
  */
 struct Texture2D {
     GLuint id = 0;
     int w = 0, h = 0, channels = 0;
+    std::size_t bytes = 0; // VRAM estimada (todos os níveis de mip)
 
     void destroy();
 
     static Texture2D loadFromFile(const std::string& path, bool flipY = true);
+    static Texture2D loadKTX2(const std::string& path, bool flipY = true);
     static Texture2D loadFromRGBA(const unsigned char* rgba, int w, int h, bool generateMips = false);
 };
 
+/// Array de texturas 2D (uma layer por imagem). Também prefere `.ktx2` se todas as layers o tiverem.
+struct TextureArray2D {
+    GLuint id = 0;
+    int w = 0, h = 0, layers = 0;
+    std::size_t bytes = 0;
+
+    void destroy();
+
+    /// Lança std::runtime_error se alguma imagem falhar ou os tamanhos não coincidirem.
+    static TextureArray2D loadFromFiles(const std::vector<std::string>& paths, bool flipY = true);
+};
+
+/// Contadores acumulados dos loads a partir de ficheiro (para reportar custo de arranque).
+struct TextureLoadStats {
+    int decodedImages = 0;   // PNG/JPG decodificados via stb_image
+    int ktx2Images = 0;      // KTX2 carregados directamente
+    double loadMs = 0.0;     // tempo de CPU em decode + upload
+    std::size_t vramBytes = 0;
+};
+
+const TextureLoadStats& textureLoadStats();
+
 } // namespace engine
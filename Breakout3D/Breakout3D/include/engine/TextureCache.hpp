@@ -0,0 +1,37 @@
+// TextureCache.hpp
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <string>
+
+namespace engine {
+
+/**
+ * @file TextureCache.hpp
+ * @brief Cache global de texturas 2D partilhadas (chave = path canónico, com refcount).
+ *
+ * Notas:
+ * - `acquire()` faz decode + upload só na primeira vez; as seguintes só incrementam o refcount.
+ * - Cada `acquire()`/`retain()` tem de ter um `release()` correspondente.
+ * - A textura OpenGL só é apagada quando o refcount chega a 0 (contexto GL activo).
+ * - `residentBytes()` soma `Texture2D::bytes` (VRAM estimada, todos os níveis de mip).
+ */
+class TextureCache {
+public:
+    /// Devolve o id partilhado da textura em `path` (lança std::runtime_error se o load falhar).
+    static GLuint acquire(const std::string& path, bool flipY = true);
+
+    /// Incrementa o refcount de um id já obtido via acquire() (ex.: cópia de um handle).
+    static void retain(GLuint id);
+
+    /// Decrementa o refcount; apaga a textura quando deixa de ter donos.
+    static void release(GLuint id);
+
+    /// Número de texturas distintas actualmente residentes.
+    static std::size_t entryCount();
+
+    /// Bytes estimados ocupados pelas texturas residentes.
+    static std::size_t residentBytes();
+};
+
+} // namespace engine
@@ -0,0 +1,54 @@
+// TripleBuffer.hpp
+#pragma once
+#include <atomic>
+
+namespace engine {
+
+/**
+ * @file TripleBuffer.hpp
+ * @brief Triple buffer lock-free (1 escritor, 1 leitor) para publicar "o último estado".
+ *
+ * Notas:
+ * - O escritor preenche `back()` e chama `publish()`; nunca espera pelo leitor.
+ * - O leitor chama `acquire()` e lê `front()`; o slot da frente é só dele até ao próximo acquire.
+ * - Troca de slots = 1 `exchange` atómico num índice (bit `kFresh` marca "há novo").
+ * - Se o escritor publicar várias vezes entre dois acquire, o leitor só vê o mais recente.
+ * - Os slots são reutilizados: `T` com vectores mantém a capacidade (sem alocar por publish).
+ */
+template <class T>
+class TripleBuffer {
+public:
+    /// (escritor) Slot a preencher antes do próximo publish.
+    T& back() { return m_slots[m_back]; }
+
+    /// (escritor) Torna `back()` visível ao leitor e recebe um slot livre em troca.
+    void publish() {
+        int prev = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+    }
+
+    /**
+     * @brief (leitor) Troca para o último slot publicado, se houver um novo.
+     * @return true se `front()` mudou.
+     */
+    bool acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+        int prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & kIndexMask;
+        return true;
+    }
+
+    /// (leitor) Último estado adquirido.
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFresh = 4;
+
+    T m_slots[3];
+    int m_back = 0;               // só escritor
+    int m_front = 1;              // só leitor
+    std::atomic<int> m_middle{2}; // partilhado
+};
+
+} // namespace engine
@@ -1,5 +1,6 @@
 // Window.hpp
 #pragma once
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -13,6 +14,9 @@ namespace engine {
  * - `getFramebufferSize()` vs `getWindowSize()` (DPI scaling).
  * - Scroll é acumulado (callback) e consumido por frame via `consumeScrollY()`.
  * - `nativeHandle()` devolve um ponteiro opaco (void*).
+ * - V-Sync desligado: o ritmo de frames é controlado pelo `FramePacer` (main loop).
+ * - `getFramebufferSize()` lê um valor em cache (callback do GLFW), por isso pode ser chamado
+ *   do thread da simulação; `requestClose()` também é seguro fora do thread principal.
  */
 class Window {
 public:
@@ -21,6 +25,15 @@ public:
 
     bool create(int width, int height, const std::string& title, bool fullscreen = false);
     void pollEvents();
+
+    /// Bloqueia até chegar um evento ou passar `timeoutSec` (glfwWaitEventsTimeout).
+    void waitEvents(double timeoutSec);
+
+    /// true se a janela está minimizada (não vale a pena render a rate normal).
+    bool isIconified() const;
+
+    /// Refresh rate do monitor principal em Hz (0 se desconhecido).
+    int refreshRate() const;
     bool shouldClose() const;
     void swapBuffers();
     void destroy();
@@ -33,11 +46,16 @@ public:
     float consumeScrollY();
     void addScrollY(float dy);
 
+    /// Chamado pelo callback de resize do framebuffer (thread principal).
+    void setFramebufferSize(int w, int h);
+
     void* nativeHandle() const { return m_window; }
 
 private:
     void* m_window = nullptr; // GLFWwindow* escondido
     float m_scrollY = 0.0f;
+    std::atomic<int> m_fbW{1};
+    std::atomic<int> m_fbH{1};
 };
 
 } // namespace engine
@@ -0,0 +1,104 @@
+// BallSet.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "game/entities/Ball.hpp"
+#include "game/BrickField.hpp" // SimdLevel
+
+namespace game {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @file BallSet.hpp
+ * @brief Bolas em Structure-of-Arrays (pos/vel/prevPos por componente + flags) com swap-remove.
+ *
+ * Notas:
+ * - `Ball` continua a ser o tipo de valor: `add` para spawnar, `get`/`set` para código que trata
+ *   uma bola de cada vez (CCD, lançamento). Loops sobre todas as bolas usam os acessores por índice.
+ * - Remover é swap-remove (O(1), a última bola passa para o slot): a ordem das bolas não é
+ *   estável e índices só valem até à próxima remoção.
+ * - Os arrays têm padding até múltiplo de 4 (lanes SSE2) com flags a 0: o kernel nunca trata caudas.
+ * - `advanceFree` é o caminho rápido do movimento: integra e faz bounce nas paredes para todas as
+ *   bolas em voo livre (longe dos bricks e do paddle), 4 por instrução e sem branches por bola.
+ *   As restantes vão para uma lista e passam pelo `CollisionSystem::moveBall` (CCD completo).
+ */
+class BallSet {
+public:
+    /// Bits de `flags(i)`.
+    enum : std::uint8_t { Alive = 1, Attached = 2, Fireball = 4, HasPrev = 8 };
+
+    /// Limites do caminho rápido (Z do mundo; bolas a tocar estas faixas vão para o CCD).
+    struct FreeBounds {
+        float minX, maxX, minZ;   // paredes da arena (o kernel encolhe-as pelo raio)
+        float brickZoneMaxZ;      // maxZ do brick vivo mais fundo (-inf sem bricks)
+        float paddleZoneMinZ;     // frente do paddle (o shield fica mais atrás)
+        float radius;
+        float maxStep;            // deslocamento máximo por eixo (acima disto há >1 bounce por passo)
+    };
+
+    int size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    void clear();
+
+    /// Acrescenta no fim. @return índice.
+    int add(const Ball& b);
+
+    Ball get(int i) const;
+    void set(int i, const Ball& b);
+
+    /// Swap-remove: a última bola passa para `i`.
+    void removeAt(int i);
+
+    /// Snapshot (ver Snapshot.hpp): só os `size()` primeiros slots (+ padding), não a capacidade.
+    void save(SnapshotWriter& w) const;
+    bool load(SnapshotReader& r);
+
+    /// Remove as bolas com `alive == false` (swap-remove). @return nº removidas.
+    int removeDead();
+
+    glm::vec3 pos(int i) const { return glm::vec3(m_px[(std::size_t)i], m_py[(std::size_t)i], m_pz[(std::size_t)i]); }
+    glm::vec3 vel(int i) const { return glm::vec3(m_vx[(std::size_t)i], m_vy[(std::size_t)i], m_vz[(std::size_t)i]); }
+    glm::vec3 prevPos(int i) const { return glm::vec3(m_qx[(std::size_t)i], m_qy[(std::size_t)i], m_qz[(std::size_t)i]); }
+
+    std::uint8_t flags(int i) const { return m_flags[(std::size_t)i]; }
+    bool alive(int i) const { return m_flags[(std::size_t)i] & Alive; }
+    bool attached(int i) const { return m_flags[(std::size_t)i] & Attached; }
+    bool fireball(int i) const { return m_flags[(std::size_t)i] & Fireball; }
+    bool hasPrev(int i) const { return m_flags[(std::size_t)i] & HasPrev; }
+
+    int attachedCount() const;
+
+    /// prevPos = pos para todas (início de cada passo fixo).
+    void storePrevious();
+
+    /**
+     * @brief Vento em X para as bolas livres, mantendo a velocidade (renormaliza |v| em XZ).
+     * `dvx[i]` é o empurrão da bola i neste passo (ou `dvxAll` para todas se `dvx == nullptr`).
+     */
+    void applyWindX(float dvxAll, const float* dvx = nullptr);
+
+    /**
+     * @brief Caminho rápido: integra `vel*dt` + bounce nas paredes para as bolas livres que ficam
+     * longe dos bricks/paddle; as outras (livres) ficam intocadas e o índice vai para `slow`.
+     * @return nº de bounces em paredes.
+     */
+    int advanceFree(float dt, const FreeBounds& fb, std::vector<int>& slow,
+                    SimdLevel level = SimdLevel::Auto);
+
+private:
+    void reserveSlots(int n);
+
+    int m_count = 0;
+
+    // pos / vel / prevPos por componente; padding até múltiplo de 4 (flags 0).
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_vx, m_vy, m_vz;
+    std::vector<float> m_qx, m_qy, m_qz;
+    std::vector<std::uint8_t> m_flags;
+};
+
+} // namespace game
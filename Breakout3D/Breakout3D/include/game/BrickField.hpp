@@ -0,0 +1,208 @@
+// BrickField.hpp
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "game/entities/Brick.hpp"
+#include "game/BrickGrid.hpp"
+#include "game/FieldStats.hpp"
+
+namespace game {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/// Caminho dos testes em lote (Auto = o melhor que o CPU suporta, detectado 1x).
+enum class SimdLevel { Auto, Scalar, SSE2, AVX2 };
+
+/// Referência estável a um brick: índice do slot + geração (o slot pode ser reciclado).
+struct BrickHandle {
+    int index = -1;
+    std::uint32_t gen = 0;
+};
+
+/**
+ * @file BrickField.hpp
+ * @brief Bricks em Structure-of-Arrays (AABB XZ, hp, alive bitset) + o BrickGrid que os indexa.
+ *
+ * Notas:
+ * - Colisões só lêem minX/maxX/minZ/maxZ e o bitset: arrays float contíguos, sem Y nem padding
+ *   do `Brick` AoS. Y e altura ficam em arrays "frios" só para o render.
+ * - `Brick` continua a ser o tipo de valor para spawnar (`add`) e para leituras pontuais
+ *   (`brick(i)`); o resto do jogo usa índices de slot.
+ * - Os arrays têm padding até múltiplo de 8 (lanes AVX2): os testes em lote nunca tratam caudas
+ *   e os slots de padding têm o bit alive a 0.
+ * - `sweptCandidates` (CCD) e o scan de `queryCircle` testam 4 (SSE2) ou 8 (AVX2) bricks por
+ *   instrução; AVX2 é escolhido em runtime (o binário continua a correr em CPUs sem AVX2). Fora
+ *   de x86 usa o caminho escalar.
+ * - Mantém o `BrickGrid` em sincronia (add/kill/shiftZ/clear): quem usa o campo não mexe na grelha.
+ * - Slots mortos vão para uma free list e são reciclados pelo próximo `add`: numa run Endless
+ *   longa o nº de slots fica no pico de bricks vivos em simultâneo, não no total spawnado.
+ *   Consequência: a ordem dos slots deixa de ser a ordem de spawn.
+ * - Cada slot tem uma geração, incrementada quando o brick morre (e em `clear`). Índices só são
+ *   válidos dentro do mesmo passo; quem guarda uma referência mais tempo usa `BrickHandle`.
+ * - Z é guardado relativo a um scroll global: posição no mundo = Z local + `scrollZ()`. O push
+ *   das rows (Endless/Rogue) só mexe no scroll e roda o ring da grelha, O(1) nos bricks.
+ * - `FieldStats` (vivos, HP, rows, Z mais fundo) é actualizado em add/kill/setHp: as verificações
+ *   por frame (win, danger line, último brick) são leituras O(1). Cada brick conta na row
+ *   (faixa de `cellZ` em Z local) do seu centro.
+ */
+class BrickField {
+public:
+    /// (Re)configura a grelha sobre a arena e limpa o campo.
+    void configureGrid(float minX, float maxX, float minZ, float maxZ, float cellX, float cellZ);
+
+    /// Remove todos os bricks (mantém a grelha configurada).
+    void clear();
+
+    /// Acrescenta um brick (vivo se `b.alive`), reciclando um slot morto se houver. @return índice do slot.
+    int add(const Brick& b);
+
+    /// Nº de slots (inclui mortos à espera de reciclagem).
+    int size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    /// Nº de bricks vivos, O(1).
+    int aliveCount() const { return m_stats.alive(); }
+
+    /// Agregados mantidos incrementalmente (HP, ocupação por row, ...).
+    const FieldStats& stats() const { return m_stats; }
+
+    bool alive(int i) const { return (m_aliveBits[(std::size_t)i >> 6] >> (i & 63)) & 1u; }
+
+    /// Marca o brick como morto, retira-o da grelha e liberta o slot (no-op se já estava morto).
+    void kill(int i);
+
+    /// Handle do brick vivo no slot `i` (índice -1 se estiver morto).
+    BrickHandle handle(int i) const;
+
+    /// Slot do handle, ou -1 se o brick morreu (ou o slot já é de outro brick).
+    int resolve(BrickHandle h) const;
+    bool valid(BrickHandle h) const { return resolve(h) >= 0; }
+
+    /// Bytes reservados pelo campo e pela grelha (soak/diagnóstico).
+    std::size_t memoryBytes() const;
+
+    /**
+     * @brief Snapshot (ver Snapshot.hpp): arrays SoA, free list, gerações, scroll, stats e grelha.
+     * O load repõe o campo exacto (mesmos slots e gerações), sem `add` nem rebuild da grelha.
+     */
+    void save(SnapshotWriter& w) const;
+    bool load(SnapshotReader& r);
+
+    int hp(int i) const { return m_hp[(std::size_t)i]; }
+    int maxHp(int i) const { return m_maxHp[(std::size_t)i]; }
+    /// Dano/cura: actualiza também o histograma de HP das stats (se o brick estiver vivo).
+    void setHp(int i, int hp);
+
+    float minX(int i) const { return m_minX[(std::size_t)i]; }
+    float maxX(int i) const { return m_maxX[(std::size_t)i]; }
+    float minZ(int i) const { return m_minZ[(std::size_t)i] + m_scrollZ; }
+    float maxZ(int i) const { return m_maxZ[(std::size_t)i] + m_scrollZ; }
+
+    glm::vec3 center(int i) const {
+        return glm::vec3((m_minX[(std::size_t)i] + m_maxX[(std::size_t)i]) * 0.5f, m_posY[(std::size_t)i],
+                         (m_minZ[(std::size_t)i] + m_maxZ[(std::size_t)i]) * 0.5f + m_scrollZ);
+    }
+    glm::vec3 size(int i) const;
+
+    /// Cópia AoS do slot (para código que quer tudo de uma vez, ex.: snapshots do finisher).
+    Brick brick(int i) const;
+
+    /// Desloca todos os bricks `dz` em Z (push das rows): soma ao scroll e roda o ring da grelha.
+    void shiftZ(float dz);
+
+    /// Deslocamento Z acumulado desde o `clear` (já incluído em minZ/maxZ/center).
+    float scrollZ() const { return m_scrollZ; }
+
+    /// maxZ (mundo) da row viva mais funda, O(1). Só válido com `aliveCount() > 0`.
+    float deepestMaxZ() const { return m_stats.deepestMaxZLocal() + m_scrollZ; }
+
+    /// Candidatos da grelha para a bola varrida (ver `BrickGrid::querySwept`).
+    void querySwept(const glm::vec3& from, const glm::vec3& to, float radius, std::vector<int>& out) const {
+        m_grid.querySwept(from, to, radius, out);
+    }
+
+    /**
+     * @brief Bricks vivos com o centro dentro do círculo XZ (AoE da fireball); `out` é substituído.
+     * Scan SoA em lote por ordem de slot; `level` fixa o kernel (bench), `Auto` o melhor disponível.
+     */
+    void queryCircle(float cx, float cz, float radius, std::vector<int>& out,
+                     SimdLevel level = SimdLevel::Auto) const;
+
+    const BrickGrid& grid() const { return m_grid; }
+
+    /**
+     * @brief Filtro em lote dos candidatos da bola varrida (p -> p + d, raio r), no sítio e pela
+     * mesma ordem: ficam os bricks vivos cujo AABB expandido por r (+ folga) o segmento atravessa.
+     * Conservador: tudo o que o teste exacto (`CollisionSystem::sweepSphereAabbXZ`) aceita fica.
+     * Com `Auto` fica no SSE2 (nas listas da grelha o gather AVX2 perde) e listas com menos de 4
+     * vão pelo escalar.
+     */
+    void sweptCandidates(const glm::vec3& p, const glm::vec3& d, float r, std::vector<int>& candidates,
+                         SimdLevel level = SimdLevel::Auto) const;
+
+    /// Vista crua dos arrays quentes (Z local; bit alive por slot), para kernels fora do campo.
+    struct HotArrays {
+        const float *minX, *maxX, *minZ, *maxZ;
+        const std::uint64_t* alive;
+        int words;
+    };
+    HotArrays hot() const;
+
+    /// Chama `fn(i)` para cada brick vivo, por ordem de slot (salta palavras do bitset a 0).
+    template <class Fn>
+    void forEachAlive(Fn&& fn) const {
+        for (std::size_t w = 0; w < m_aliveBits.size(); ++w) {
+            std::uint64_t bits = m_aliveBits[w];
+            while (bits) {
+                int b = __builtin_ctzll(bits);
+                fn((int)(w * 64 + (std::size_t)b));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    /// Nível que `SimdLevel::Auto` usa neste CPU.
+    static SimdLevel detectedSimd();
+
+    /// Teste escalar de referência (mesma fórmula que os caminhos SIMD).
+    static bool sphereAabbXZ(float cx, float cz, float r, float minX, float maxX, float minZ, float maxZ) {
+        float dx = std::max(std::max(minX - cx, cx - maxX), 0.0f);
+        float dz = std::max(std::max(minZ - cz, cz - maxZ), 0.0f);
+        return dx * dx + dz * dz <= r * r;
+    }
+
+private:
+    void reserveSlots(int n);
+    void rebuildGrid();
+    int rowKey(float localMinZ, float localMaxZ) const;
+    void rebaseScroll();
+
+    int m_count = 0;
+
+    // Quentes (colisão): padding até múltiplo de 8. Z em coordenadas locais (sem scroll).
+    std::vector<float> m_minX, m_maxX, m_minZ, m_maxZ;
+    std::vector<std::uint64_t> m_aliveBits;
+
+    // Frios (gameplay/render).
+    std::vector<int> m_hp, m_maxHp;
+    std::vector<float> m_posY, m_sizeY;
+
+    std::vector<std::uint32_t> m_gen;  // sobrevive a clear(): handles antigos nunca revalidam
+    std::vector<int> m_free;           // slots mortos (pilha em [0, m_freeCount)); tamanho = slots
+    int m_freeCount = 0;
+
+    // Scroll Z + row de cada slot (para as stats).
+    float m_scrollZ = 0.0f;
+    float m_rowPitch = 1.0f;
+    std::vector<int> m_rowOf;
+
+    FieldStats m_stats;
+
+    BrickGrid m_grid;
+};
+
+} // namespace game
@@ -0,0 +1,113 @@
+// BrickGrid.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace game {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @file BrickGrid.hpp
+ * @brief Índice espacial (grelha uniforme no plano XZ) dos bricks vivos, para as colisões.
+ *
+ * Notas:
+ * - Células do tamanho do "pitch" dos bricks (brick + gap). Um brick regista-se em todas as
+ *   células que o seu AABB toca (tipicamente 1..4).
+ * - Guarda índices de slots do `BrickField` (que é quem a mantém): `insert` no spawn,
+ *   `remove` quando o brick morre, `shiftZ` quando as rows são empurradas.
+ * - As rows são um ring: empurrar o campo um nº inteiro de células só roda a base do ring
+ *   (os bricks não mudam de célula física). Deslocamentos não alinhados pedem um rebuild.
+ * - Armazenamento plano (capacidade fixa por célula + lista de overflow), para a cópia do
+ *   `GameState` no snapshot de render ser um memcpy e não N alocações.
+ * - Fora da grelha: coordenadas são "clamped" às células da borda (continua correcto, só
+ *   menos selectivo).
+ * - Como só guarda bricks vivos, `aliveCount()` é a contagem de vivos em O(1).
+ * - Sem duplicados nem `sort`/`unique`: um brick só é devolvido por uma célula (a primeira da
+ *   intersecção span/query). Um brick que não cabe em todas as suas células vai só para o
+ *   overflow, que as queries acrescentam sempre.
+ * - A ordem dos candidatos é a das células, não a dos slots: quem precisa de desempatar
+ *   (o CCD da bola) fá-lo pelo índice.
+ */
+class BrickGrid {
+public:
+    /// Define a área coberta e o tamanho de célula; limpa o índice.
+    void configure(float minX, float maxX, float minZ, float maxZ, float cellX, float cellZ);
+
+    /// Remove todos os bricks (mantém as dimensões).
+    void clear();
+
+    bool configured() const { return m_cols > 0; }
+
+    /// Regista o brick `index` com o AABB XZ dado (no-op se já estiver registado).
+    void insert(int index, float minX, float maxX, float minZ, float maxZ);
+
+    /// Retira o brick `index` (no-op se não estiver registado).
+    void remove(int index);
+
+    /**
+     * @brief Os bricks registados foram todos deslocados `dz` em Z (push das rows Endless/Rogue).
+     * Com `dz` múltiplo do tamanho de célula roda o ring em O(colunas).
+     * @return false se não deu para rodar: o dono tem de fazer `clear()` + `insert` de novo.
+     */
+    bool shiftZ(float dz);
+
+    /**
+     * @brief Candidatos para uma esfera que se moveu de `from` até `to` (raio `radius`).
+     * Percorre só as células tocadas pelo AABB do varrimento. `out` é substituído por índices
+     * únicos, pela ordem das células (+ overflow no fim).
+     */
+    void querySwept(const glm::vec3& from, const glm::vec3& to, float radius, std::vector<int>& out) const;
+
+    /// Candidatos cujo AABB pode intersectar o rectângulo XZ dado (mesmo contrato de `out`).
+    void queryRect(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const;
+
+    /// Nº de bricks registados (= vivos), mantido em insert/remove/rebuild.
+    int aliveCount() const { return m_alive; }
+
+    int cols() const { return m_cols; }
+    int rows() const { return m_rows; }
+
+    /// Entradas registadas (um brick em 2 células conta 2; um brick em overflow conta 1), O(1).
+    int entryCount() const { return m_entries; }
+
+    /// Bytes reservados (células + spans + overflow).
+    std::size_t memoryBytes() const;
+
+    /// Snapshot (ver Snapshot.hpp): células, spans e overflow copiados em bloco (sem reinserir).
+    void save(SnapshotWriter& w) const;
+    bool load(SnapshotReader& r);
+
+private:
+    static constexpr int kCellCapacity = 12;
+
+    // Células ocupadas por um brick (rows físicas, já com a base do ring aplicada).
+    struct Span {
+        std::int16_t c0 = 0, c1 = -1;
+        std::int16_t r0 = 0, nr = 0;   // nr = 0: não registado
+        bool overflow = false;
+    };
+
+    int colOf(float x) const;
+    int rowOf(float z) const;          // row lógica (0 = topo da grelha)
+    int physRow(int logicalRow) const { return (logicalRow + m_rowBase) % m_rows; }
+    int* cellItems(int col, int prow) { return &m_items[(std::size_t)(prow * m_cols + col) * kCellCapacity]; }
+    const int* cellItems(int col, int prow) const { return &m_items[(std::size_t)(prow * m_cols + col) * kCellCapacity]; }
+
+    float m_minX = 0.0f, m_minZ = 0.0f;
+    float m_cellX = 1.0f, m_cellZ = 1.0f;
+    float m_invCellX = 1.0f, m_invCellZ = 1.0f;
+    int m_cols = 0, m_rows = 0;
+    int m_rowBase = 0;
+    int m_alive = 0;
+    int m_entries = 0;
+
+    std::vector<int> m_items;              // cols*rows*kCellCapacity; índices de slot
+    std::vector<std::uint8_t> m_counts;    // cols*rows
+    std::vector<int> m_overflow;           // bricks com alguma célula cheia (não estão em células)
+    std::vector<Span> m_spans;             // por índice de brick
+};
+
+} // namespace game
@@ -0,0 +1,84 @@
+// FieldStats.hpp
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace game {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @file FieldStats.hpp
+ * @brief Agregados do campo de bricks mantidos incrementalmente (vivos, HP, ocupação por row, Z máximo).
+ *
+ * Notas:
+ * - Quem o mantém é o `BrickField` (spawn/kill/dano); o resto do jogo só lê, em O(1).
+ * - Z em coordenadas locais do campo (sem o scroll): o push das rows não mexe aqui nada,
+ *   o `BrickField` soma o scroll ao ler (`BrickField::deepestMaxZ`).
+ * - Rows: faixas de `cellZ` em Z local, num ring cujas pontas estão sempre ocupadas.
+ *   front = row mais recente (topo), back = row viva mais funda. O ring (potência de 2) só cresce
+ *   quando há mais rows do que nunca: o scroll do Endless não aloca.
+ * - Uma row guarda o maior maxZ que recebeu desde que deixou de estar vazia: exacto para as
+ *   rows uniformes do Endless/Rogue, conservador (nunca menos fundo) nos outros layouts.
+ */
+class FieldStats {
+public:
+    /// HP 0..6 têm bucket próprio; o último junta tudo acima.
+    static constexpr int kHpBuckets = 8;
+
+    void clear();
+
+    void onSpawn(int hp, int rowKey, float localMaxZ);
+    void onKill(int hp, int rowKey);
+    void onDamage(int hpBefore, int hpAfter);
+
+    int alive() const { return m_alive; }
+
+    /// Bricks vivos com este HP (HP >= kHpBuckets-1 contam todos no último bucket).
+    int hpCount(int hp) const { return m_hpCount[(std::size_t)bucket(hp)]; }
+
+    /// Soma do HP dos bricks vivos (dano que falta para limpar o campo).
+    int totalHp() const { return m_totalHp; }
+
+    /// Nº de rows entre a mais recente e a mais funda (inclui rows vazias no meio).
+    int rowCount() const { return m_rowCount; }
+
+    /// Bricks vivos na row `k` (0 = topo, rowCount()-1 = mais funda).
+    int rowAlive(int k) const { return row(k).alive; }
+
+    /// maxZ local da row viva mais funda. Só válido com `alive() > 0`.
+    float deepestMaxZLocal() const { return row(m_rowCount - 1).maxZ; }
+
+    std::size_t memoryBytes() const { return m_ring.capacity() * sizeof(Row); }
+
+    /// Snapshot (ver Snapshot.hpp): contadores + rows do ring, tal como estão.
+    void save(SnapshotWriter& w) const;
+    bool load(SnapshotReader& r);
+
+private:
+    struct Row {
+        int alive = 0;
+        float maxZ = 0.0f;
+    };
+
+    static int bucket(int hp) { return hp < 0 ? 0 : (hp >= kHpBuckets ? kHpBuckets - 1 : hp); }
+
+    Row& row(int k) { return m_ring[(std::size_t)(m_rowHead + k) & (m_ring.size() - 1)]; }
+    const Row& row(int k) const { return m_ring[(std::size_t)(m_rowHead + k) & (m_ring.size() - 1)]; }
+    void pushFrontRow();
+    void pushBackRow();
+    void growRing();
+
+    int m_alive = 0;
+    int m_totalHp = 0;
+    std::array<int, kHpBuckets> m_hpCount{};
+
+    std::vector<Row> m_ring;   // tamanho potência de 2 (ou vazio)
+    int m_rowHead = 0;         // índice do front no ring
+    int m_rowCount = 0;
+    int m_rowFrontKey = 0;
+};
+
+} // namespace game
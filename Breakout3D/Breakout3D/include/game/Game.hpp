@@ -2,12 +2,21 @@
 #pragma once
 #include "engine/Window.hpp"
 #include "engine/Time.hpp"
+#include "engine/FixedStep.hpp"
 #include "engine/Renderer.hpp"
 #include "engine/Input.hpp"
+#include "engine/SpscQueue.hpp"
+#include "engine/TripleBuffer.hpp"
 #include "game/GameConfig.hpp"
 #include "game/GameState.hpp"
+#include "game/RenderSnapshot.hpp"
 #include "game/AudioSystem.hpp"
+#include "game/SimEvents.hpp"
+#include "game/Replay.hpp"
+#include "game/Snapshot.hpp"
+#include <atomic>
 #include <string>
+#include <thread>
 
 // forward declare (não precisa incluir o header aqui)
 namespace game { struct GameAssets; }
@@ -23,6 +32,12 @@ namespace game {
  * - Actualizar o jogo com input por frame (menu, gameplay, overlays).
  * - Renderizar mundo + UI através do renderer.
  * - Orquestrar música/SFX com base em transições de estado (tracking de frame anterior).
+ *
+ * Threads:
+ * - Simulação (update, áudio, GameState) corre no seu thread (`startSimulation(true)`).
+ * - O thread principal (dono do contexto GL) envia input por uma fila lock-free (`submitInput`)
+ *   e desenha a partir do último `RenderSnapshot` publicado num triple buffer (`render`).
+ * - Nada no update faz chamadas GL; nada no render toca em `m_state`.
  */
 class Game {
 public:
@@ -31,13 +46,35 @@ public:
     /// Inicialização do jogo (estado, assets dependentes, áudio, etc.).
     void init();
 
-    /// Update por frame (lê input, actualiza estado, dispara eventos de áudio).
-    void update(const engine::Input& input);
+    ~Game();
+
+    /// Lança o thread da simulação (threaded=false: o main loop chama `tickSimulation()`).
+    void startSimulation(bool threaded);
+
+    /// Pára e junta o thread da simulação (antes de destruir assets/renderer).
+    void stopSimulation();
 
-    /// Render do frame actual (mundo 3D + UI).
+    /// (thread principal) Envia o input do frame para a simulação (lock-free; nunca bloqueia).
+    void submitInput(const engine::Input& input);
+
+    /// Uma iteração da simulação: drena input, update, publica snapshot.
+    void tickSimulation();
+
+    /// (thread principal) Render do último snapshot publicado (mundo 3D + UI).
     void render();
 
+    /// true quando o último snapshot não tem simulação a correr (menu, pausa, game over/win
+    /// sem finisher): o main loop pode baixar para o FPS de idle.
+    bool isIdle() const;
+
 private:
+    /// Update por frame da simulação (lê input, actualiza estado, dispara eventos de áudio).
+    void update(const engine::Input& input);
+
+    void publishSnapshot();
+    void simThreadMain();
+    static bool isIdleState(const GameState& state);
+
     // Helpers internos (separados para manter o update legível e modular).
     void setMusic(const std::string& group, float fadeSeconds);
 
@@ -48,31 +85,43 @@ private:
     bool updatePausedOverlay(const engine::Input& input);
     bool updateEndOverlay(const engine::Input& input);
 
-    // Timers e cooldowns gerais (pausa, powerups, overlays, etc.).
-    void updateTimers(const engine::Input& input, float dt);
+    // Um passo fixo da simulação (SimulationSystem::step + reacções de áudio/música).
+    // Retorna false quando o resto dos passos do frame deve ser descartado (saiu de PLAYING / finisher).
+    bool simulateStep(float dt);
+
+    // SFX/stingers/persistência dos eventos emitidos por um passo.
+    void playSimEvents(const SimEvents& events);
 
-    // “Frame de jogo” quando está em PLAYING (separado para não entupir o update principal).
-    void updatePlayingFrame(
-        const engine::Input& input,
-        float dt,
+    // Reacções (música, loops, stingers) às transições de estado de um passo de gameplay completo.
+    void updatePlayingAudio(
         GameMode modeBefore,
         GameType typeBefore,
         int livesBefore,
         int waveBefore,
         int endlessRowsBefore,
         bool dangerBefore,
-        int streakBefore,
-        bool hadPowerupBefore
+        int streakBefore
     );
 
-    // Helpers de persistência/bookkeeping (Endless).
+    // Persistência do best do Endless (o SimulationSystem só emite SimEventType::EndlessBest).
     static std::string endlessBestScorePath();
     static void saveEndlessBestScore(int best);
-    static void commitEndlessStreak(GameState& state);
-    static void maybeUpdateEndlessBest(GameState& state);
+
+    // Replays: a run em curso é gravada e escrita em replayPath() quando acaba (ou ao sair).
+    static std::string replayPath();
+    void finishReplay();
+
+    // Rewind (Levels) e seek no playback: snapshots periódicos em m_rewind (GameUpdateRewind.cpp).
+    void updateRewind(const engine::Input& input);
+    bool rewindEnabled() const;
+    std::uint64_t rewindTick() const;
+    void resetRewind();
+    void captureRewind();
+    bool restoreRewind(int index);
+    void seekReplay(std::uint64_t tick);
 
     engine::Window& m_window;
-    engine::Time& m_time;
+    engine::Time& m_time;     // relógio do render (animações UI); a simulação usa m_simTime
     engine::Renderer& m_renderer;
     GameAssets& m_assets;
 
@@ -81,6 +130,47 @@ private:
 
     AudioSystem m_audio;
 
+    // ---- Thread da simulação ----
+    engine::Time m_simTime;
+    engine::Input m_simInput;
+    engine::SpscQueue<engine::InputSample, 64> m_inputQueue;
+    engine::InputSample m_pendingInput;  // thread principal: fila cheia -> funde com a próxima
+    bool m_hasPendingInput = false;
+    engine::TripleBuffer<RenderSnapshot> m_snapshots;
+    std::uint64_t m_simFrame = 0;
+    std::thread m_simThread;
+    std::atomic<bool> m_simStop{false};
+
+    // Simulação em passo fixo (240 Hz, no máx. 12 passos = 50ms, o clamp do Time); o render interpola com simAlpha.
+    engine::FixedStep m_sim{240.0f, 12};
+
+    // Eventos do passo actual (reutiliza a capacidade entre passos).
+    SimEvents m_simEvents;
+
+    // Replay: gravação da run actual e, com B3D_REPLAY=<ficheiro>, playback no lugar do input.
+    ReplayRecorder m_replayRec;
+    ReplayPlayer m_replayPlayer;
+    bool m_replayPlayback = false;
+
+    // Snapshots do estado de simulação a cada 0.5 s (+ marca do recorder / cursor do player).
+    SnapshotRing m_rewind;
+
+    // Estado "antes" para os triggers de transição do updatePlayingAudio (actualizado a cada passo).
+    // Se um frame não correr passos, o snapshot é mantido para o próximo (não se perdem transições).
+    struct SimSnapshot {
+        GameMode mode = GameMode::MENU;
+        GameType type = GameType::NORMAL;
+        int lives = 0;
+        int wave = 0;
+        int endlessRows = 0;
+        bool danger = false;
+        int streak = 0;
+    };
+    SimSnapshot captureSimSnapshot() const;
+    void afterStateJump(const SimSnapshot& before); // depois de rewind/seek
+    SimSnapshot m_simBefore;
+    bool m_simBeforeHeld = false;
+
     // Tracking do frame anterior para tocar one-shots só quando há transições (hover/click/mudança de ecrã).
     GameMode m_prevMode = GameMode::MENU;
     GameType m_prevGameType = GameType::NORMAL;
@@ -3,12 +3,10 @@
 #include "engine/Mesh.hpp"
 #include "engine/Texture.hpp"
 #include "engine/Shader.hpp"
-#include "engine/AnimatedTexture.hpp"
-#include <array>
+#include "engine/GifStream.hpp"
 #include <atomic>
-#include <mutex>
-#include <thread>
-#include <vector>
+#include <cstddef>
+#include <string>
 
 namespace game {
 
@@ -20,12 +18,12 @@ namespace game {
  * - meshes de entidades (paddle/ball/bricks/powerups)
  * - backgrounds
  * - shader/mesh do fundo “scrolling”
- * - GIFs opcionais para previews no UI (carregamento lazy + decode em threads)
+ * - GIFs opcionais para previews no UI (streaming frame-a-frame num worker)
  *
  * @note
  * A parte dos GIFs está desenhada para não bloquear o arranque nem congelar o menu:
- * - threads descodificam para RGBA
- * - o upload para GPU é feito aos poucos (pump) com um budget por tick
+ * - cada preview tem um worker que descodifica à frente da reprodução (ring limitado)
+ * - o thread GL só envia 1 frame quando este fica "due" (memória limitada por `powerupVideoBudgetBytes`)
  */
 struct GameAssets {
     engine::Mesh paddle;
@@ -33,19 +31,13 @@ struct GameAssets {
     engine::Mesh heart;
     engine::Mesh wall;
 
+    // Todos os bricks partilham a mesma geometria; o tipo/dano é só a textura (layer do array).
+    // Layers: 0 B01 | 1 B02, 2 B02 1hit | 3 B03, 4-5 B03 1-2hit | 6 B04, 7-9 B04 1-3hit
     engine::Mesh brick01;
+    engine::TextureArray2D brickTexArray;
 
-    engine::Mesh brick02;
-    engine::Mesh brick02_1hit;
-
-    engine::Mesh brick03;
-    engine::Mesh brick03_1hit;
-    engine::Mesh brick03_2hit;
-
-    engine::Mesh brick04;
-    engine::Mesh brick04_1hit;
-    engine::Mesh brick04_2hit;
-    engine::Mesh brick04_3hit;
+    /// @return layer de `brickTexArray` para um brick com `maxHp`/`hp`.
+    static int brickLayer(int maxHp, int hp);
 
     engine::Mesh expand;
     engine::Mesh extraBall;
@@ -60,39 +52,27 @@ struct GameAssets {
 
     engine::Texture2D backgroundTexs[4];
 
-    // GIFs opcionais para “vídeo” no UI (lazy-loaded).
+    // GIFs opcionais para “vídeo” no UI (streaming: só um ring pequeno de frames em memória).
     // Ficheiros em `assets/video/*.gif`.
     // Ordem deve bater certo com o inspector (MenuRender):
     // 0 EXPAND, 1 EXTRA_BALL, 2 EXTRA_LIFE, 3 FIREBALL, 4 SLOW, 5 SHIELD, 6 REVERSE, 7 TINY
     std::string powerupVideoPaths[8];
-    mutable engine::AnimatedTexture2D powerupVideos[8];
-    mutable bool powerupVideoLoaded[8]{};
-
-    // Estado de decode/upload assíncrono (decode em thread; upload é “pumped” no thread do GL).
-    struct DecodedGif {
-        int w = 0;
-        int h = 0;
-        std::vector<std::vector<unsigned char>> framesRGBA;
-        std::vector<int> delaysMs;
-    };
-
-    mutable std::array<std::thread, 8> powerupVideoThreads{};
-    mutable std::array<std::atomic<bool>, 8> powerupVideoDecoding{};
-    mutable std::array<std::atomic<bool>, 8> powerupVideoDecoded{};
-    mutable std::array<std::atomic<bool>, 8> powerupVideoTried{};
-    mutable std::array<std::mutex, 8> powerupVideoMutex{};
-    mutable std::array<DecodedGif, 8> powerupVideoDecodedData{};
-    mutable std::array<int, 8> powerupVideoUploadCursor{};
+    mutable engine::StreamingGif powerupVideos[8];
+
+    /// RAM+VRAM máximos por preview (decoder + ring de frames + textura).
+    std::size_t powerupVideoBudgetBytes = 16u << 20;
+
     mutable std::atomic<bool> powerupVideoPreloadStarted{false};
 
-    /// @return GIF animado do power-up idx (pode estar vazio se ainda não carregou).
-    const engine::AnimatedTexture2D& powerupVideo(int idx) const;
+    /// Preview `idx` (arranca o streaming se ainda não arrancou); nullptr se idx inválido.
+    /// Desenhar com `frameAtTime(t)` (layer) + `texture()` (texture array).
+    engine::StreamingGif* powerupVideo(int idx) const;
 
-    /// Lança threads de decode para todos os GIFs (chamar quando for oportuno).
+    /// Lança os workers de streaming de todos os GIFs (chamar quando for oportuno).
     void startPowerupVideoPreload() const;
 
-    /// Faz upload de alguns frames por tick (para evitar spikes). `uploadBudgetFrames` controla o “orçamento”.
-    void pumpPowerupVideoPreload(int uploadBudgetFrames = 6) const;
+    /// Põe na GPU o primeiro frame dos previews que já o têm descodificado (no máx. `uploadBudgetBytes` por tick).
+    void pumpPowerupVideoPreload(std::size_t uploadBudgetBytes = 4u << 20) const;
 
     // Fundo “scrolling”
     engine::Shader scrollingBgShader;
@@ -25,6 +25,11 @@ struct GameConfig {
     float arenaMinZ = -12.0f; // topo (bricks)
     float arenaMaxZ =  12.0f; // fundo (perde bola)
 
+    // Grelha de colisão dos bricks (BrickGrid): célula = pitch dos bricks procedurais
+    // (2.95 + gap 0.04, 1.30 + gap 0.03), para o push das rows Endless/Rogue rodar o ring.
+    float brickGridCellX = 2.99f;
+    float brickGridCellZ = 1.33f;
+
     // Paddle
     glm::vec3 paddleSize = {3.6f, 0.55f, 0.90f};
     float paddleSpeed = 14.0f;
@@ -5,10 +5,14 @@
 #include <cstdint>
 
 #include "game/entities/Brick.hpp"
+#include "game/BrickField.hpp"
+#include "game/BallSet.hpp"
 #include "game/entities/Ball.hpp"
 #include "game/entities/PowerUp.hpp" // inclui PowerUpType
 #include "game/ui/OverlayLayout.hpp"
 #include "game/rogue/RogueCardId.hpp"
+#include "game/Rng.hpp"
+#include "engine/Pool.hpp"
 
 namespace game {
 
@@ -24,6 +28,9 @@ namespace game {
  * - estado de UI (hover/drag/click edge, layouts calculados)
  * - dados específicos de modos (Endless, Rogue, Levels)
  *
+ * Entidades transitórias (powerups, explosões, shards, popups) vivem em `engine::Pool` de
+ * capacidade fixa: durante o jogo não há alocações, e uma pool cheia recusa o spawn.
+ *
  * @note
  * Muitos “eventos” (ex.: power-ups apanhados) são registados aqui para o `Game::update`
  * conseguir tocar áudio e aplicar UI sem depender dos sistemas onde o evento aconteceu.
@@ -64,6 +71,10 @@ struct GameState {
     int lives = 3;
     int score = 0;
 
+    // Aleatoriedade da run (streams PCG32 por subsistema). Reseeded no InitSystem::initGame;
+    // rng.seed identifica a run (mesmo seed + mesmo input = mesma run, em qualquer thread).
+    RunRng rng;
+
     // ------------------------- LEVELS MODE -------------------------
     int currentLevel = 1;        // nível actual (1-20)
     int levelsBestLevel = 1;     // melhor nível atingido (persistente)
@@ -89,14 +100,21 @@ struct GameState {
 
     // ------------------------- ENTIDADES -------------------------
     glm::vec3 paddlePos = {0.0f, 0.0f, 0.0f};
+    glm::vec3 paddlePrevPos = {0.0f, 0.0f, 0.0f}; // passo fixo anterior (interpolação no render)
+    float paddleInputDir = 0.0f;                   // -1..+1, lido do input 1x por frame e aplicado em cada passo
+    glm::vec3 launchInputDir = {0.0f, 0.0f, -1.0f}; // direcção do último launch pedido pelo input (vai para o replay)
 
-    std::vector<Ball> balls;
-    std::vector<PowerUp> powerups;
-    std::vector<Brick> bricks;
+    // Fracção do próximo passo fixo já decorrida (0..1) no fim do update; o render estende-a
+    // pelo tempo desde a publicação do snapshot e desenha mix(prev, actual, alpha).
+    float simAlpha = 1.0f;
 
-    // --- Buffers de eventos para áudio (limpos/consumidos no Game::update) ---
-    std::vector<PowerUpType> audioSpawnedPowerups;
-    std::vector<PowerUpType> audioPickedPowerups;
+    BallSet balls;                 // SoA + swap-remove: a ordem das bolas não é estável
+    engine::Pool<PowerUp, 64> powerups; // swap-remove: ordem não estável
+    BrickField bricks;             // SoA + BrickGrid; slots mortos são reciclados (guardar BrickHandle, não índices)
+
+    // --- Buffers de eventos para áudio (consumidos e limpos no fim de cada passo) ---
+    engine::Pool<PowerUpType, 64> audioSpawnedPowerups;
+    engine::Pool<PowerUpType, 64> audioPickedPowerups;
 
     // ------------------------- TIMERS DE POWER-UPS -------------------------
     float expandTimer = 0.0f;
@@ -111,7 +129,7 @@ struct GameState {
         glm::vec3 pos = glm::vec3(0.0f);
         float t = 0.0f; // segundos desde spawn
     };
-    std::vector<FireballExplosionFx> fireballExplosions;
+    engine::Pool<FireballExplosionFx, 8> fireballExplosions; // 0.45 s cada: uma por fireball
 
     float fireballShakeTimer = 0.0f;
     glm::vec3 fireballShakeAnchorPos = glm::vec3(0.0f);
@@ -121,21 +139,18 @@ struct GameState {
         glm::vec3 vel = glm::vec3(0.0f);
         float t = 0.0f;
     };
-    std::vector<FireballShard> fireballShards;
+    engine::Pool<FireballShard, 128> fireballShards; // 18 por explosão (GameConfig), 0.55 s de vida
 
     // Popups de score (positivos e negativos).
     struct ScorePopup {
         int pts = 0;     // pode ser negativo
         float t = 0.0f;  // segundos desde spawn
     };
-    std::vector<ScorePopup> scorePopups;
+    engine::Pool<ScorePopup, 16> scorePopups; // ordem estável (o HUD empilha pela ordem de spawn)
 
     // Quando um fireball one-shot é consumido, respawn de bola normal sem gastar vida.
     bool pendingRespawnAfterFireball = false;
 
-    // Evita múltiplos hits por overlap no mesmo instante.
-    float brickHitCooldown = 0.0f;
-
     // Debug/Endless timers auxiliares.
     float spawnPingTimer = 0.0f;
     float endlessSpawnCooldown = 0.0f;
@@ -161,8 +176,9 @@ struct GameState {
     int hoveredRogueCardPickButton = -1; // hover do botão PICK por carta
 
     // Picks (sem repetição) e deck de drops (powerups que podem cair dos bricks).
-    std::vector<game::rogue::RogueCardId> rogueChosen;
-    std::vector<PowerUpType> rogueDropDeck;
+    // Pools de capacidade fixa: crescem a cada carta e a cópia para o render não aloca.
+    engine::Pool<game::rogue::RogueCardId, 64> rogueChosen; // >= nº de cartas do catálogo
+    engine::Pool<PowerUpType, 16> rogueDropDeck;            // sem duplicados: <= nº de PowerUpType
 
     // Pools restantes para garantir “sem repetição”.
     std::vector<game::rogue::RogueCardId> rogueRemainingNormal;
@@ -265,6 +281,7 @@ struct GameState {
     bool winFinisherAnchorValid = false;
     glm::vec3 winFinisherAnchorPos = glm::vec3(0.0f);
 
+    // Cópia por valor do último brick (não um índice): a reciclagem de slots não a invalida.
     bool winFinisherHoldBrickValid = false;
     glm::vec3 winFinisherHoldBrickPos = glm::vec3(0.0f);
     glm::vec3 winFinisherHoldBrickSize = glm::vec3(1.0f);
@@ -0,0 +1,28 @@
+// RenderSnapshot.hpp
+#pragma once
+#include "game/GameState.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace game {
+
+/**
+ * @file RenderSnapshot.hpp
+ * @brief Cópia imutável do estado publicada pela simulação para o render.
+ *
+ * Notas:
+ * - A simulação escreve no slot de trás do `engine::TripleBuffer` e publica; o render lê o da frente.
+ * - `state` é uma cópia completa do GameState (bricks, bolas, powerups, FX, valores do HUD, menu):
+ *   as funções de render já recebem `const GameState&`, por isso não precisam de saber de threads.
+ * - `publishedAt` + `simStep` deixam o render estender a interpolação (simAlpha) pelo tempo
+ *   que passou desde a publicação.
+ */
+struct RenderSnapshot {
+    GameState state;
+    std::uint64_t simFrame = 0; ///< 0 = ainda não houve publish
+    std::chrono::steady_clock::time_point publishedAt{};
+    float simStep = 1.0f / 240.0f;
+};
+
+} // namespace game
@@ -0,0 +1,205 @@
+// Replay.hpp
+#pragma once
+#include "game/GameConfig.hpp"
+#include "game/GameState.hpp"
+#include "game/SimEvents.hpp"
+#include "game/Snapshot.hpp"
+#include "game/rogue/RogueCardId.hpp"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game {
+
+/**
+ * @file Replay.hpp
+ * @brief Replays compactos de uma run: seed + hash do GameConfig + stream de input por tick fixo.
+ *
+ * Formato (.b3dr, little-endian):
+ * - Header: "B3DR", versão (u16), GameType (u8), nível (u8), seed (u64), hash do GameConfig (u64),
+ *   intervalo de checksums em ticks (u32).
+ * - Registos: 1 byte (op no nibble alto, delta de ticks desde o registo anterior no baixo; 15 =
+ *   o resto do delta segue num varint) + payload do op.
+ *   Só se grava o que muda: direcção do paddle quando muda, launch (direcção em f32 x/z), pause,
+ *   resume, pick de carta (slot + id), checksum do GameState a cada N ticks e END.
+ *
+ * Notas:
+ * - Um tick = um passo fixo do SimulationSystem. Os inputs de um tick são aplicados antes desse
+ *   passo; o checksum do tick t é o estado depois de t passos.
+ * - O replay só reproduz a run se a simulação for determinística para o mesmo seed + input
+ *   (RunRng no GameState, sem rand() nem relógio). As teclas de debug não são gravadas.
+ * - Pause/resume não mexem na simulação (em pausa não correm ticks): ficam no ficheiro para
+ *   se saber onde o jogador parou, e o playback ignora-os.
+ */
+enum class ReplayOp : std::uint8_t {
+    End,        // payload: GameMode final (u8)
+    DirLeft,    // paddleInputDir = -1
+    DirNone,    // paddleInputDir = 0
+    DirRight,   // paddleInputDir = +1
+    DirValue,   // paddleInputDir = f32 (input analógico)
+    Launch,     // f32 x, f32 z
+    Pause,
+    Resume,
+    Pick,       // slot (u8), RogueCardId (u8)
+    Check       // checksum do GameState (u64)
+};
+
+struct ReplayHeader {
+    GameType type = GameType::NORMAL;
+    int level = 1;
+    std::uint64_t seed = 0;
+    std::uint64_t configHash = 0;
+    std::uint32_t checksumEvery = 240;
+};
+
+/// FNV-1a do estado que a simulação lê/escreve (score, bolas, bricks, paddle, timers, RNG).
+std::uint64_t replayStateChecksum(const GameState& state);
+
+/// FNV-1a dos bytes do GameConfig (um replay gravado com outro tuning não é reproduzível).
+std::uint64_t replayConfigHash(const GameConfig& cfg);
+
+/**
+ * @brief Grava uma run em memória; `finish` fecha o stream e devolve os bytes do ficheiro.
+ *
+ * Quem corre a simulação chama `beforeStep`/`afterStep` à volta de cada passo e os restantes
+ * métodos quando o input acontece (no tick actual).
+ */
+class ReplayRecorder {
+public:
+    /// Começa uma run nova (depois do InitSystem::initGame: lê tipo, nível e seed do estado).
+    void begin(const GameState& state, const GameConfig& cfg, std::uint32_t checksumEvery = 240);
+
+    bool active() const { return m_active; }
+    std::uint64_t tick() const { return m_tick; }
+
+    /// Antes do passo: grava a direcção do paddle se mudou.
+    void beforeStep(const GameState& state);
+
+    /// Depois do passo: avança o tick e grava o checksum a cada `checksumEvery`.
+    void afterStep(const GameState& state);
+
+    void launch(const glm::vec3& dir);
+    void pause();
+    void resume();
+    void pick(int slot, rogue::RogueCardId id);
+
+    /// Grava END e devolve o ficheiro completo; o recorder fica inactivo (até ao próximo `begin`/`rewind`).
+    std::vector<std::uint8_t> finish(GameMode endMode);
+
+    /// Posição no stream (guardada com os snapshots de rewind).
+    struct Mark {
+        std::uint64_t bytes = 0;
+        std::uint64_t tick = 0;
+        std::uint64_t lastTick = 0;
+        float dir = 0.0f;
+    };
+    Mark mark() const { return Mark{ m_buf.size(), m_tick, m_lastTick, m_dir }; }
+
+    /// Rewind: corta o que foi gravado depois da marca e continua a gravar a partir dali
+    /// (também depois de `finish`, p.ex. rewind a partir do game over).
+    void rewind(const Mark& m);
+
+private:
+    void op(ReplayOp o);
+    void u8(std::uint8_t v) { m_buf.push_back(v); }
+    void u64(std::uint64_t v);
+    void f32(float v);
+    void varint(std::uint64_t v);
+
+    std::vector<std::uint8_t> m_buf;
+    bool m_active = false;
+    std::uint64_t m_tick = 0;
+    std::uint64_t m_lastTick = 0;
+    std::uint32_t m_checksumEvery = 240;
+    float m_dir = 0.0f;
+};
+
+/**
+ * @brief Lê um .b3dr e volta a injectar o input no GameState, tick a tick.
+ *
+ * Ciclo (headless ou no Game):
+ *  - `begin` (initGame com o seed/tipo/nível do header)
+ *  - por tick: `applyInputs` -> SimulationSystem::step -> `afterStep`
+ *  - em ROGUE_CARDS não há passos: `applyInputs` aplica o pick gravado nesse tick.
+ */
+class ReplayPlayer {
+public:
+    bool load(std::vector<std::uint8_t> bytes, std::string* error = nullptr);
+    bool loadFile(const std::string& path, std::string* error = nullptr);
+
+    bool loaded() const { return !m_buf.empty(); }
+    const ReplayHeader& header() const { return m_header; }
+    std::size_t sizeBytes() const { return m_buf.size(); }
+
+    /// Reinicia o cursor e prepara o estado para o início da run gravada.
+    void begin(GameState& state, const GameConfig& cfg);
+
+    /// Aplica os registos do tick actual (direcção, launch, pick). Pode ser chamado várias vezes.
+    void applyInputs(GameState& state, const GameConfig& cfg);
+
+    /// Depois de um passo: avança o tick e confere o checksum gravado para esse tick.
+    /// @return false se o estado divergiu (agora ou antes).
+    bool afterStep(const GameState& state);
+
+    /// Chegou ao END e ao tick final gravado.
+    bool finished() const { return m_c.ended && m_c.tick >= m_c.nextTick; }
+
+    std::uint64_t tick() const { return m_c.tick; }
+    std::uint64_t endTick() const { return m_c.ended ? m_c.nextTick : 0; }
+    GameMode endMode() const { return m_c.endMode; }
+
+    /// Primeiro tick em que o estado não bateu com o gravado (-1 = nunca).
+    long long desyncTick() const { return m_c.desyncTick; }
+
+    int checksVerified() const { return m_c.checks; }
+    int launches() const { return m_c.launches; }
+    int picks() const { return m_c.picks; }
+    int pauses() const { return m_c.pauses; }
+
+    /// Posição do playback (POD): guardada com os snapshots do seek e reposta com `setCursor`.
+    struct Cursor {
+        std::size_t pos = 0;
+        std::uint64_t tick = 0;
+        bool ended = false;
+        bool bad = false;
+        GameMode endMode = GameMode::PLAYING;
+
+        // Próximo registo (já descodificado).
+        bool hasNext = false;
+        ReplayOp nextOp = ReplayOp::End;
+        std::uint64_t nextTick = 0;
+        float nextF[2] = {0.0f, 0.0f};
+        std::uint64_t nextU = 0;
+        int nextSlot = 0;
+
+        long long desyncTick = -1;
+        int checks = 0, launches = 0, picks = 0, pauses = 0;
+    };
+    const Cursor& cursor() const { return m_c; }
+    void setCursor(const Cursor& c) { m_c = c; }
+
+private:
+    bool readNext();      // descodifica o próximo registo para m_c.next*
+    void desync();
+
+    std::vector<std::uint8_t> m_buf;
+    ReplayHeader m_header;
+    std::size_t m_bodyStart = 0;
+    Cursor m_c;
+};
+
+/// Keyframe de seek: snapshot do estado + cursor do player no ring (se `ring.due` neste tick).
+void replayKeyframe(const ReplayPlayer& player, SnapshotRing& ring, const GameState& state);
+
+/**
+ * @brief Salta o playback para `tick`: para trás repõe o keyframe mais próximo (ou recomeça o
+ * replay), depois avança passo a passo sem render nem áudio, a deixar keyframes pelo caminho.
+ * Pára antes se o replay acabar, divergir ou o jogo sair de PLAYING sem pick gravado.
+ * @return tick onde ficou.
+ */
+std::uint64_t replaySeek(ReplayPlayer& player, SnapshotRing& ring, GameState& state, const GameConfig& cfg,
+                         std::uint64_t tick, float stepDt, SimEvents& scratch);
+
+} // namespace game
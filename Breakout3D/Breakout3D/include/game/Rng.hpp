@@ -0,0 +1,88 @@
+// Rng.hpp
+#pragma once
+#include <cstdint>
+
+namespace game {
+
+/**
+ * @file Rng.hpp
+ * @brief PCG32 (XSH-RR, 64 bits de estado) e as streams de aleatoriedade de uma run (`RunRng`).
+ *
+ * Notas:
+ * - Substitui o `rand()` global: o estado vive no `GameState`, por isso duas simulações em threads
+ *   diferentes nunca partilham nada e o mesmo seed dá sempre os mesmos números.
+ * - Cada subsistema tem a sua stream (mesmo seed, `inc` diferente): gastar números nos FX ou no
+ *   vento não mexe nos drops nem nos bricks.
+ * - `below(n)` não tem o bias do `% n`: rejeita os r < (2^32 - n) % n e só depois faz `r % n`
+ *   (o `bounded_rand` do OpenBSD/PCG; custa um `%` extra por chamada).
+ */
+class Pcg32 {
+public:
+    Pcg32() { seed(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL); }
+
+    void seed(std::uint64_t initState, std::uint64_t stream) {
+        m_state = 0u;
+        m_inc = (stream << 1u) | 1u;
+        next();
+        m_state += initState;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + m_inc;
+        std::uint32_t xorshifted = (std::uint32_t)(((old >> 18u) ^ old) >> 27u);
+        std::uint32_t rot = (std::uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    /// Uniforme em [0, n). n == 0 devolve 0.
+    std::uint32_t below(std::uint32_t n) {
+        if (n == 0u) return 0u;
+        const std::uint32_t threshold = (0u - n) % n;
+        for (;;) {
+            std::uint32_t r = next();
+            if (r >= threshold) return r % n;
+        }
+    }
+
+    /// Inteiro em [0, n) (atalho para índices/percentagens).
+    int range(int n) { return n > 0 ? (int)below((std::uint32_t)n) : 0; }
+
+    /// Uniforme em [0, 1) com 24 bits.
+    float uniform() { return (float)(next() >> 8) * (1.0f / 16777216.0f); }
+
+    bool operator==(const Pcg32& o) const { return m_state == o.m_state && m_inc == o.m_inc; }
+    bool operator!=(const Pcg32& o) const { return !(*this == o); }
+
+private:
+    std::uint64_t m_state = 0;
+    std::uint64_t m_inc = 1;
+};
+
+/// Streams de uma run. `reseed` no início de cada run (InitSystem::initGame).
+struct RunRng {
+    std::uint64_t seed = 0;
+
+    Pcg32 bricks;  // geração de bricks (HP, layout procedural)
+    Pcg32 drops;   // powerups: chance + tipo
+    Pcg32 wind;    // Rogue: rajadas de vento
+    Pcg32 cards;   // Rogue: ofertas de cartas
+    Pcg32 fx;      // só visual (shards da fireball, debug)
+
+    RunRng() { reseed(0); }
+
+    void reseed(std::uint64_t s) {
+        seed = s;
+        bricks.seed(s, 1u);
+        drops.seed(s, 2u);
+        wind.seed(s, 3u);
+        cards.seed(s, 4u);
+        fx.seed(s, 5u);
+    }
+
+    /// Seed "novo" para runs normais (relógio + random_device). Nunca devolve 0.
+    static std::uint64_t freshSeed();
+};
+
+} // namespace game
@@ -0,0 +1,44 @@
+// SimEvents.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+/**
+ * @file SimEvents.hpp
+ * @brief Eventos emitidos por um passo da simulação (em vez de chamadas directas ao AudioSystem).
+ *
+ * Notas:
+ * - O `SimulationSystem` não conhece áudio/ficheiros: acrescenta eventos a um `SimEvents` e quem
+ *   corre a simulação decide o que fazer (o `Game` toca SFX/stingers e grava os bests; o
+ *   `breakout_sim` só os conta).
+ * - Hits de paredes/paddle/bricks saem no máximo 1x por tipo por passo (como os SFX já faziam).
+ * - Transições que o `Game` deteta por diferença de estado (danger, tiers de música, vidas ganhas,
+ *   wave change) não são eventos: o estado chega para as reconstruir.
+ */
+enum class SimEventType : std::uint8_t {
+    WallHit,
+    PaddleHit,
+    BrickHit,        // hit sem crack nem break
+    BrickCrack,
+    BrickBreak,
+    FireballBreak,   // break por fireball (SFX mais forte)
+    PowerupDropped,  // passou de "sem powerups a cair" para "há"
+    PowerupPicked,   // value = (int)PowerUpType
+    LifeLost,        // value = vidas restantes
+    RunComplete,     // Rogue: última wave limpa (mode -> WIN)
+    FieldCleared,    // Normal/Levels: último brick morreu, o finisher começou
+    EndlessBest,     // value = novo best do Endless (por gravar)
+    RogueBest,       // value = novo best do Rogue (por gravar)
+    Count
+};
+
+struct SimEvent {
+    SimEventType type = SimEventType::WallHit;
+    int value = 0;
+};
+
+using SimEvents = std::vector<SimEvent>;
+
+} // namespace game
@@ -0,0 +1,185 @@
+// Snapshot.hpp
+#pragma once
+#include "engine/Pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace game {
+
+struct GameState;
+
+/**
+ * @file Snapshot.hpp
+ * @brief Snapshot binário do estado de simulação do `GameState` (save/restore) + ring de rewind.
+ *
+ * Formato (versionado, mesma máquina/build: não é um formato de ficheiro portável):
+ * - `SnapshotHeader` POD ("B3DS", versão, bytes totais, bytes do bloco de escalares).
+ * - Bloco de escalares: os campos de gameplay do `GameState` copiados um a um (memcpy), sem texto.
+ * - Arrays com prefixo de tamanho (u32): powerups, VFX, cartas do Rogue, SoA do `BallSet` e do
+ *   `BrickField` (incluindo grelha e `FieldStats`, copiados tal como estão, sem rebuild).
+ *
+ * Notas:
+ * - Só entra o que a simulação lê/escreve (e os VFX que o render desenha). Menu, hover, sliders
+ *   de áudio, câmara, fundo e recordes persistentes ficam como estão no `load`.
+ * - Save e load reutilizam a capacidade dos buffers: um ring aquecido não aloca.
+ * - O load repõe o estado exacto (RNG incluído): correr os mesmos passos a seguir dá o mesmo
+ *   resultado que teria dado antes do save.
+ */
+struct SnapshotHeader {
+    char magic[4] = {'B', '3', 'D', 'S'};
+    std::uint16_t version = 1;
+    std::uint16_t reserved = 0;
+    std::uint32_t bytes = 0;        // snapshot inteiro (header incluído)
+    std::uint32_t scalarBytes = 0;  // muda se a lista de campos mudar sem subir a versão
+};
+
+/// Escreve um snapshot num buffer reutilizável (o conteúdo anterior é descartado).
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<std::uint8_t>& out) : m_out(out) { m_out.clear(); }
+
+    void bytes(const void* p, std::size_t n) {
+        const std::size_t at = m_out.size();
+        m_out.resize(at + n);
+        if (n) std::memcpy(&m_out[at], p, n);
+    }
+
+    template <class T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: só tipos POD");
+        bytes(&v, sizeof(T));
+    }
+
+    /// u32 com o nº de elementos + os elementos em bloco.
+    template <class T>
+    void array(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: só arrays de POD");
+        pod((std::uint32_t)v.size());
+        bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    /// Pool: mesmo formato que um array (u32 + os vivos).
+    template <class T, std::size_t N>
+    void array(const engine::Pool<T, N>& p) {
+        pod((std::uint32_t)p.size());
+        bytes(p.data(), p.size() * sizeof(T));
+    }
+
+    std::size_t size() const { return m_out.size(); }
+    std::uint8_t* data() { return m_out.data(); }
+
+private:
+    std::vector<std::uint8_t>& m_out;
+};
+
+/// Lê um snapshot; qualquer leitura fora do buffer põe `ok()` a false (e as seguintes falham).
+class SnapshotReader {
+public:
+    SnapshotReader(const std::uint8_t* p, std::size_t n) : m_p(p), m_end(p + n) {}
+    explicit SnapshotReader(const std::vector<std::uint8_t>& v) : SnapshotReader(v.data(), v.size()) {}
+
+    bool ok() const { return m_ok; }
+    std::size_t remaining() const { return (std::size_t)(m_end - m_p); }
+
+    bool bytes(void* dst, std::size_t n) {
+        if (!m_ok || n > remaining()) return m_ok = false;
+        if (n) std::memcpy(dst, m_p, n);
+        m_p += n;
+        return true;
+    }
+
+    template <class T>
+    bool pod(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: só tipos POD");
+        return bytes(&v, sizeof(T));
+    }
+
+    template <class T>
+    bool array(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: só arrays de POD");
+        std::uint32_t n = 0;
+        if (!pod(n) || (std::size_t)n * sizeof(T) > remaining()) return m_ok = false;
+        v.resize(n);
+        return bytes(v.data(), (std::size_t)n * sizeof(T));
+    }
+
+    /// Pool: falha se o snapshot tiver mais elementos do que a capacidade.
+    template <class T, std::size_t N>
+    bool array(engine::Pool<T, N>& p) {
+        std::uint32_t n = 0;
+        if (!pod(n) || (std::size_t)n * sizeof(T) > remaining() || !p.resize(n)) return m_ok = false;
+        return bytes(p.data(), (std::size_t)n * sizeof(T));
+    }
+
+private:
+    const std::uint8_t* m_p;
+    const std::uint8_t* m_end;
+    bool m_ok = true;
+};
+
+/// Snapshot do estado de simulação. Quem chama pode continuar a escrever dados seus a seguir.
+void saveSnapshot(const GameState& state, SnapshotWriter& w);
+
+/**
+ * @brief Repõe um snapshot gravado por `saveSnapshot` (mesma versão e lista de campos).
+ * @return false se o header não bate certo ou o buffer está truncado (o estado fica por definir:
+ *         quem chama deve fazer `InitSystem::initGame` ou repor outro snapshot).
+ */
+bool loadSnapshot(GameState& state, SnapshotReader& r);
+
+/**
+ * @brief Ring de snapshots periódicos (rewind no Levels, seek nos replays).
+ *
+ * Notas:
+ * - Um snapshot a cada `every` ticks, até `capacity`; o mais antigo é reciclado (o buffer dele
+ *   é reutilizado, sem alocações depois de o ring encher).
+ * - `push` devolve o writer já com o `GameState` escrito: quem chama acrescenta o seu contexto
+ *   (cursor do replay, marca do recorder) e lê-o a seguir ao `loadSnapshot`.
+ * - Ticks sempre crescentes: depois de um rewind, `dropAfter` descarta o "futuro" abandonado.
+ */
+class SnapshotRing {
+public:
+    SnapshotRing() { reset(16, 120); }
+
+    void reset(int capacity, std::uint32_t every);
+    void clear() { m_first = 0; m_size = 0; }
+
+    int size() const { return m_size; }
+    std::uint32_t every() const { return m_every; }
+
+    /// Há snapshot a tirar neste tick (múltiplo de `every` e mais recente que o último).
+    bool due(std::uint64_t tick) const;
+
+    /// Grava o estado no slot seguinte (reciclando o mais antigo se estiver cheio).
+    SnapshotWriter push(std::uint64_t tick, const GameState& state);
+
+    /// Índice (0 = mais antigo) do snapshot mais recente com tick <= `tick`, ou -1.
+    int find(std::uint64_t tick) const;
+
+    std::uint64_t tickAt(int i) const { return m_ticks[slot(i)]; }
+
+    /// Reader posicionado no início do snapshot `i` (passar ao `loadSnapshot`).
+    SnapshotReader reader(int i) const { return SnapshotReader(m_bufs[slot(i)]); }
+
+    /// Descarta os snapshots mais recentes que `i`.
+    void dropAfter(int i) { if (i + 1 < m_size) m_size = i < 0 ? 0 : i + 1; }
+
+    /// Bytes do snapshot `i` e reservados por todo o ring (diagnóstico).
+    std::size_t bytesAt(int i) const { return m_bufs[slot(i)].size(); }
+    std::size_t memoryBytes() const;
+
+private:
+    std::size_t slot(int i) const { return (std::size_t)((m_first + i) % (int)m_bufs.size()); }
+
+    std::vector<std::vector<std::uint8_t>> m_bufs;
+    std::vector<std::uint64_t> m_ticks;
+    std::uint32_t m_every = 120;
+    int m_first = 0;
+    int m_size = 0;
+};
+
+} // namespace game
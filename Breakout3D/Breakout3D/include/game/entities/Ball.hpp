@@ -12,12 +12,17 @@ namespace game {
  * - `pos` e `vel` estão em world space (unidades do teu mundo).
  * - `attached` indica se a bola está “presa” ao paddle (antes do lançamento).
  * - `alive` permite remover/desactivar a bola sem a apagar logo da lista.
+ * - `prevPos`/`hasPrev` são escritos no início de cada passo fixo (ver `PhysicsSystem::storePreviousTransforms`).
  * - `isFireball` activa o comportamento especial do power-up FIREBALL (one-shot + AoE).
  */
 struct Ball {
     glm::vec3 pos = {0.0f, 0.0f, 0.0f};
     glm::vec3 vel = {0.0f, 0.0f, 0.0f};
 
+    /// Posição no passo de simulação anterior (interpolação no render; válida se `hasPrev`).
+    glm::vec3 prevPos = {0.0f, 0.0f, 0.0f};
+    bool hasPrev = false;
+
     /// Se true, segue o paddle e não é simulada como bola “livre”.
     bool attached = false;
 
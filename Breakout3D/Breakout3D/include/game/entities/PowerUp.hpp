@@ -33,6 +33,8 @@ enum class PowerUpType {
 struct PowerUp {
     PowerUpType type;
     glm::vec3 pos = {0.0f, 0.0f, 0.0f};
+    glm::vec3 prevPos = {0.0f, 0.0f, 0.0f}; // passo fixo anterior (interpolação no render)
+    bool hasPrev = false;
     bool alive = true;
 };
 
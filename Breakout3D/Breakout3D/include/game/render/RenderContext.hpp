@@ -31,6 +31,9 @@ struct RenderContext {
 
     // UI pixels (origem em baixo). -1 = inválido/desconhecido.
     float dangerLineScreenY = -1.0f;
+
+    // Fracção entre o passo fixo anterior e o actual (interpolação de paddle/bolas/powerups).
+    float simAlpha = 1.0f;
 };
 
 } // namespace game::render
@@ -10,31 +10,26 @@ namespace game {
  * @file CollisionSystem.hpp
  * @brief Colisões do jogo (paredes/mundo, paddle e bricks).
  *
- * Este sistema trata das respostas a colisões:
- * - limites do mundo (paredes/tecto/chão/zonas de perda)
+ * Este sistema integra as bolas com detecção contínua (time of impact) e trata das respostas:
+ * - limites do mundo (paredes/tecto) e shield
  * - paddle (inclui ajuste de direcção para dar controlo ao jogador)
  * - bricks (dano, destruição e casos especiais como fireball)
  */
 class CollisionSystem {
 public:
     /**
-     * @brief Colisões com o “mundo” (paredes/limites).
-     * @return true se houve colisão (útil para SFX/feedback).
-     */
-    static bool handleWorldCollisions(Ball& ball, const GameConfig& cfg);
-
-    /**
-     * @brief Colisão bola <-> paddle.
+     * @brief Time of impact de uma esfera (raio `r`) que se move de `p` até `p + d` contra um AABB, em XZ.
      *
-     * Normalmente:
-     * - reflecte a velocidade no eixo adequado,
-     * - ajusta o ângulo conforme a zona do paddle onde a bola bateu (mais controlo).
+     * - `tHit` em [0, 1] (fracção de `d`); `normal` aponta da superfície para o centro da bola.
+     * - Faces pelo teste de slabs no AABB expandido por `r`; cantos por raio vs círculo no vértice.
+     * - Se já houver sobreposição no início devolve `tHit = 0` (quem chama decide se conta,
+     *   tipicamente só se a bola se estiver a mover contra a normal).
      *
-     * @param paddlePos / paddleSize usados para AABB do paddle no mundo.
-     * @return true se houve colisão.
+     * @return true se houve contacto dentro do segmento.
      */
-    static bool handlePaddleCollision(Ball& ball, const GameState& state, const glm::vec3& paddlePos,
-                                      const glm::vec3& paddleSize, const GameConfig& cfg);
+    static bool sweepSphereAabbXZ(const glm::vec3& p, const glm::vec3& d, float r,
+                                  float minX, float maxX, float minZ, float maxZ,
+                                  float& tHit, glm::vec2& normal);
 
     /**
      * @brief Informação de resultado de colisão com bricks (para VFX/SFX/score).
@@ -54,11 +49,34 @@ public:
         int maxHp = 0;          ///< resistência total (para VFX/cores)
     };
 
+    /// Resumo dos contactos de uma bola num passo (para SFX/feedback).
+    struct BallMoveInfo {
+        bool wall = false;          ///< bateu numa parede (o shield não conta)
+        bool paddle = false;        ///< bateu no paddle
+        BrickCollisionInfo brick;   ///< flags acumuladas de todos os bricks tocados; hp/maxHp do último
+        int contacts = 0;           ///< nº de contactos resolvidos no passo
+    };
+
     /**
-     * @brief Colisão bola <-> bricks (dano, destruição, fireball/AoE).
-     * @return Info detalhada do impacto (hit/dano/destruição/quantos morreram).
+     * @brief Integra a bola `dt` segundos com CCD (swept sphere) contra paredes, shield, paddle e bricks.
+     *
+     * Resolve vários bounces no mesmo passo (até 8 contactos): avança até ao primeiro contacto,
+     * responde (bounce/dano/fireball/sticky), e continua com o tempo restante. Não há túneis a
+     * nenhuma velocidade/dt. O paddle é tratado como parado na posição deste passo.
+     */
+    static BallMoveInfo moveBall(Ball& ball, GameState& state, const glm::vec3& paddleSize,
+                                 const GameConfig& cfg, float dt);
+
+    /**
+     * @brief Move todas as bolas livres de `state.balls` um passo.
+     *
+     * Bolas em voo livre (longe dos bricks e do paddle) vão pelo kernel SoA `BallSet::advanceFree`;
+     * as outras, por índice, pelo `moveBall`. O resultado junta as flags de todas as bolas
+     * (`contacts` soma os contactos, incluindo os bounces do kernel).
+     * `level` escolhe o caminho do kernel (benchmarks); o jogo usa `Auto`.
      */
-    static BrickCollisionInfo handleBrickCollisions(Ball& ball, GameState& state, const GameConfig& cfg);
+    static BallMoveInfo moveBalls(GameState& state, const glm::vec3& paddleSize,
+                                  const GameConfig& cfg, float dt, SimdLevel level = SimdLevel::Auto);
 };
 
 } // namespace game
@@ -16,8 +16,11 @@ namespace game {
  */
 class InitSystem {
 public:
-    /// Inicializa o estado do jogo (valores default, vidas, score, seeds, etc.).
-    static void initGame(GameState& state, const GameConfig& cfg);
+    /**
+     * @brief Inicializa o estado do jogo (valores default, vidas, score, RNG da run, etc.).
+     * @param seed Seed das streams `state.rng`; 0 = um seed novo (`RunRng::freshSeed`).
+     */
+    static void initGame(GameState& state, const GameConfig& cfg, std::uint64_t seed = 0);
 
     /// Gera bricks para uma wave/nível “genérico” (waveNumber pode influenciar dificuldade/padrão).
     static void generateBricks(GameState& state, const GameConfig& cfg, int waveNumber = 0);
@@ -31,7 +34,7 @@ public:
     /// Reposiciona bola e paddle para o estado inicial (tipicamente bola attached ao paddle).
     static void resetBallAndPaddle(GameState& state, const GameConfig& cfg);
 
-    /// @return true se ainda existirem bricks vivos (para detectar wave clear).
+    /// @return true se ainda existirem bricks vivos (para detectar wave clear). O(1).
     static bool anyBricksAlive(const GameState& state);
 };
 
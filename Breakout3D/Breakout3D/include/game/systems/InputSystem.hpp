@@ -28,13 +28,13 @@ public:
      * @brief Processa input durante o gameplay.
      *
      * Normalmente:
-     * - mover paddle (dir = -1/0/+1 a partir de teclas)
+     * - direcção do paddle (dir = -1/0/+1 a partir de teclas) -> `state.paddleInputDir`
      * - lançar bola quando attached
      * - alternar pause / overlays
      *
-     * @param dt usado para movimentos smooth / repeat rate (se aplicável).
+     * Corre 1x por frame (edges de teclas); o movimento é aplicado nos passos fixos.
      */
-    static void handleGameInput(GameState& state, const engine::Input& input, const GameConfig& cfg, engine::Window& window, float dt);
+    static void handleGameInput(GameState& state, const engine::Input& input, const GameConfig& cfg, engine::Window& window);
 
 private:
     /// Helper simples para hit-test de UI em pixels (ex.: cliques nos botões).
@@ -20,9 +20,13 @@ public:
      */
     static void updatePaddle(GameState& state, const GameConfig& cfg, float dir, float dt);
 
-    /// Actualiza bolas (pos += vel * dt, estados attached, etc.).
+    /// Actualiza bolas (attached, vento Rogue, remoção por swap-remove). A posição das bolas livres
+    /// é integrada em `CollisionSystem::moveBalls`.
     static void updateBalls(GameState& state, const GameConfig& cfg, float dt);
 
+    /// Copia pos -> prevPos (paddle, bolas, powerups). Chamar no início de cada passo fixo.
+    static void storePreviousTransforms(GameState& state);
+
     /// Reposiciona uma bola para “colada” ao paddle (ex.: antes do launch / após reset).
     static void resetBallToPaddle(Ball& ball, const glm::vec3& paddlePos, const GameConfig& cfg);
 };
@@ -40,9 +40,10 @@ public:
 
     /**
      * @brief Decide o HP de um brick para uma wave.
+     * @param rng Stream de bricks da run (`state.rng.bricks`).
      * @param isFrontHalf Pode ser usado para diferenciar “metade da frente” vs “metade de trás” da grelha.
      */
-    static int pickBrickHpForWave(int wave, bool isFrontHalf);
+    static int pickBrickHpForWave(Pcg32& rng, int wave, bool isFrontHalf);
 
     // ---- Regras de progressão por wave ----
 
@@ -69,8 +70,8 @@ public:
     /// Carrega o melhor score do Rogue (separado do Endless).
     static int loadRogueBestScore();
 
-    /// Se o score actual bater recorde, actualiza/persiste o best do Rogue.
-    static void maybeUpdateRogueBest(GameState& state);
+    /// Grava o best do Rogue (o SimulationSystem só emite SimEventType::RogueBest).
+    static void saveRogueBestScore(int best);
 };
 
 } // namespace game
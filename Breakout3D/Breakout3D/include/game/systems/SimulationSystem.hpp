@@ -0,0 +1,55 @@
+// SimulationSystem.hpp
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "game/GameState.hpp"
+#include "game/GameConfig.hpp"
+#include "game/SimEvents.hpp"
+
+namespace game {
+
+/**
+ * @file SimulationSystem.hpp
+ * @brief Passo fixo determinístico do gameplay (paddle, timers, bolas, colisões, waves, vidas).
+ *
+ * Notas:
+ * - Só depende de `GameState`/`GameConfig` e dos outros systems: sem GL, janela, input ou áudio.
+ *   É o núcleo da `libbreakout_sim.a` (ver Makefile) e do `breakout_sim` (tools/breakout_sim.cpp).
+ * - Efeitos "para fora" (SFX, stingers, bests a gravar) saem como `SimEvent`s.
+ * - O input entra pelo estado: `state.paddleInputDir` (escrito pelo InputSystem ou por um bot)
+ *   e `launchAttached` para lançar bolas.
+ */
+class SimulationSystem {
+public:
+    /// Como acabou um passo.
+    enum class StepResult : std::uint8_t {
+        Played,        // frame de gameplay completo
+        WaveBreak,     // Rogue: parou numa transição de wave (próxima wave / cartas / vitória)
+        FieldCleared,  // Normal/Levels: campo limpo, finisher activo (não houve frame de gameplay)
+    };
+
+    /// Um passo fixo (`dt` = passo da simulação). Acrescenta eventos a `events` (não limpa).
+    static StepResult step(GameState& state, const GameConfig& cfg, float dt, SimEvents& events);
+
+    /// Timers e cooldowns (powerups, FX, popups, timers de modo). Faz parte do `step`.
+    static void updateTimers(GameState& state, const GameConfig& cfg, float dt);
+
+    /// Lança as bolas attached na direcção `dir` (XZ, normalizada aqui). @return nº lançadas.
+    static int launchAttached(GameState& state, const GameConfig& cfg, const glm::vec3& dir);
+
+    /// Tamanho "real" do paddle (cartas Rogue + expand/tiny).
+    static glm::vec3 paddleSize(const GameState& state, const GameConfig& cfg);
+
+    /// Bank/streak -> score (clamp >= 0) e limpa o estado do bank.
+    static void commitStreak(GameState& state);
+
+    /// Actualiza o best do modo (Endless/Rogue) se o score o bateu; emite EndlessBest/RogueBest.
+    static void updateBest(GameState& state, SimEvents& events);
+
+private:
+    static StepResult playingFrame(GameState& state, const GameConfig& cfg, float dt,
+                                   bool hadPowerupBefore, SimEvents& events);
+};
+
+} // namespace game
@@ -0,0 +1,260 @@
+// AssetFS.cpp
+// -----------------------------------------------------------------------------
+// AssetFS.cpp
+//
+// Responsabilidade:
+//  - Mapear o ficheiro .b3dpak em memória (mmap) e validar header/índice uma vez.
+//  - Resolver paths lógicos -> entry (binary search no índice ordenado por hash).
+//  - Fazer fallback para ficheiros soltos quando o asset não está no pack.
+//
+// Notas:
+//  - Em plataformas sem mmap (Windows) o pack é lido inteiro para memória.
+//  - Payloads comprimidos (kFlagZlib) são descomprimidos com o inflate do stb_image.
+// -----------------------------------------------------------------------------
+
+#include "engine/AssetFS.hpp"
+#include "engine/PakFormat.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A implementação do stb_image está em GifStream.cpp (aqui só o inflate).
+#include "external/stb_image.h"
+
+namespace fs = std::filesystem;
+
+namespace engine {
+
+namespace {
+
+struct MountedPack {
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+    const pak::Entry* entries = nullptr;
+    std::uint32_t entryCount = 0;
+    const char* names = nullptr;
+    std::size_t namesSize = 0;
+
+#if defined(_WIN32)
+    std::vector<unsigned char> buffer;
+#endif
+};
+
+MountedPack g_pack;
+bool g_mounted = false;
+
+// Path lógico (chave do pack): relativo à pasta actual, separadores '/', sem "./".
+std::string logicalPath(const std::string& path) {
+    fs::path p(path);
+    if (p.is_absolute()) {
+        std::error_code ec;
+        fs::path rel = p.lexically_relative(fs::current_path(ec));
+        if (!ec && !rel.empty() && *rel.begin() != "..") p = rel;
+    }
+    return pak::normalizePath(p.generic_string());
+}
+
+const char* entryName(const pak::Entry& e) {
+    return g_pack.names + e.nameOffset;
+}
+
+const pak::Entry* findEntry(const std::string& path) {
+    if (!g_mounted) return nullptr;
+
+    const std::string key = logicalPath(path);
+    const std::uint64_t h = pak::hashPath(key);
+
+    const pak::Entry* first = g_pack.entries;
+    const pak::Entry* last = g_pack.entries + g_pack.entryCount;
+    const pak::Entry* it = std::lower_bound(first, last, h,
+        [](const pak::Entry& e, std::uint64_t v) { return e.hash < v; });
+
+    // Pode haver colisões: confirma pelo nome.
+    for (; it != last && it->hash == h; ++it) {
+        if (key == entryName(*it)) return it;
+    }
+    return nullptr;
+}
+
+bool readLoose(const std::string& path, std::vector<unsigned char>& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+
+    f.seekg(0, std::ios::end);
+    std::streamoff len = f.tellg();
+    f.seekg(0, std::ios::beg);
+    if (len < 0) return false;
+
+    out.resize((std::size_t)len);
+    if (len > 0) f.read(reinterpret_cast<char*>(out.data()), len);
+    return (bool)f;
+}
+
+bool validatePack(const std::string& pakPath) {
+    auto fail = [&](const char* why) {
+        std::cerr << "[AssetFS] invalid pack " << pakPath << ": " << why << "\n";
+        return false;
+    };
+
+    if (g_pack.size < sizeof(pak::Header)) return fail("truncated header");
+
+    pak::Header hdr;
+    std::memcpy(&hdr, g_pack.base, sizeof(hdr));
+    if (std::memcmp(hdr.magic, pak::kMagic, sizeof(hdr.magic)) != 0) return fail("bad magic");
+    if (hdr.version != pak::kVersion) return fail("unsupported version");
+
+    const std::uint64_t indexBytes = (std::uint64_t)hdr.entryCount * sizeof(pak::Entry);
+    if (hdr.indexOffset % alignof(pak::Entry) != 0) return fail("misaligned index");
+    if (hdr.indexOffset + indexBytes > g_pack.size) return fail("index out of range");
+    if (hdr.namesOffset + hdr.namesSize > g_pack.size) return fail("names out of range");
+
+    g_pack.entries = reinterpret_cast<const pak::Entry*>(g_pack.base + hdr.indexOffset);
+    g_pack.entryCount = hdr.entryCount;
+    g_pack.names = reinterpret_cast<const char*>(g_pack.base + hdr.namesOffset);
+    g_pack.namesSize = (std::size_t)hdr.namesSize;
+
+    if (g_pack.namesSize > 0 && g_pack.names[g_pack.namesSize - 1] != '\0') return fail("names not terminated");
+
+    for (std::uint32_t i = 0; i < g_pack.entryCount; ++i) {
+        const pak::Entry& e = g_pack.entries[i];
+        if (e.offset + e.size > g_pack.size) return fail("payload out of range");
+        if (e.nameOffset >= g_pack.namesSize) return fail("name out of range");
+        if (i > 0 && g_pack.entries[i - 1].hash > e.hash) return fail("index not sorted");
+    }
+    return true;
+}
+
+} // namespace
+
+bool AssetFS::mountPack(const std::string& pakPath) {
+    unmountPack();
+
+#if defined(_WIN32)
+    if (!readLoose(pakPath, g_pack.buffer)) return false;
+    g_pack.base = g_pack.buffer.data();
+    g_pack.size = g_pack.buffer.size();
+#else
+    int fd = ::open(pakPath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* p = ::mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // o mapping mantém-se válido depois de fechar o fd
+    if (p == MAP_FAILED) {
+        std::cerr << "[AssetFS] mmap failed: " << pakPath << "\n";
+        return false;
+    }
+
+    g_pack.base = static_cast<const unsigned char*>(p);
+    g_pack.size = (std::size_t)st.st_size;
+#endif
+
+    if (!validatePack(pakPath)) {
+        unmountPack();
+        return false;
+    }
+
+    g_mounted = true;
+    return true;
+}
+
+void AssetFS::unmountPack() {
+#if defined(_WIN32)
+    g_pack.buffer.clear();
+    g_pack.buffer.shrink_to_fit();
+#else
+    if (g_pack.base) ::munmap(const_cast<unsigned char*>(g_pack.base), g_pack.size);
+#endif
+    g_pack = MountedPack{};
+    g_mounted = false;
+}
+
+bool AssetFS::packMounted() {
+    return g_mounted;
+}
+
+bool AssetFS::inPack(const std::string& path) {
+    return findEntry(path) != nullptr;
+}
+
+bool AssetFS::exists(const std::string& path) {
+    if (findEntry(path)) return true;
+    std::error_code ec;
+    return fs::is_regular_file(path, ec);
+}
+
+bool AssetFS::read(const std::string& path, AssetData& out) {
+    out = AssetData{};
+
+    if (const pak::Entry* e = findEntry(path)) {
+        const unsigned char* payload = g_pack.base + e->offset;
+
+        if ((e->flags & pak::kFlagZlib) == 0) {
+            out.data = payload;
+            out.size = (std::size_t)e->size;
+            return true;
+        }
+
+        int outLen = 0;
+        char* raw = stbi_zlib_decode_malloc_guesssize_headerflag(
+            reinterpret_cast<const char*>(payload), (int)e->size, (int)e->rawSize, &outLen, 1);
+        if (!raw || (std::uint64_t)outLen != e->rawSize) {
+            std::free(raw);
+            std::cerr << "[AssetFS] inflate failed: " << entryName(*e) << "\n";
+            return false;
+        }
+        out.owned.assign(reinterpret_cast<unsigned char*>(raw), reinterpret_cast<unsigned char*>(raw) + outLen);
+        std::free(raw);
+
+        out.data = out.owned.data();
+        out.size = out.owned.size();
+        return true;
+    }
+
+    // Fallback: ficheiro solto no disco.
+    if (!readLoose(path, out.owned)) return false;
+    out.data = out.owned.data();
+    out.size = out.owned.size();
+    return true;
+}
+
+bool AssetFS::readText(const std::string& path, std::string& out) {
+    AssetData d;
+    if (!read(path, d)) return false;
+    out.assign(reinterpret_cast<const char*>(d.data), d.size);
+    return true;
+}
+
+std::vector<std::string> AssetFS::listPacked(const std::string& dirPrefix) {
+    std::vector<std::string> out;
+    if (!g_mounted) return out;
+
+    std::string prefix = logicalPath(dirPrefix);
+    if (!prefix.empty()) prefix += '/';
+
+    for (std::uint32_t i = 0; i < g_pack.entryCount; ++i) {
+        const char* name = entryName(g_pack.entries[i]);
+        if (std::strncmp(name, prefix.c_str(), prefix.size()) == 0) out.emplace_back(name);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace engine
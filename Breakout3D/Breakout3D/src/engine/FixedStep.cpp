@@ -0,0 +1,42 @@
+// FixedStep.cpp
+// -----------------------------------------------------------------------------
+// FixedStep.cpp
+//
+// Responsabilidade:
+//  - Acumular o dt real do frame e "pagar" a simulação em passos de tamanho fixo.
+//
+// Notas:
+//  - Com vsync desligado (glfwSwapInterval(0)) o render pode ir a milhares de FPS;
+//    a simulação corre sempre à mesma frequência (por defeito 240 Hz).
+//  - O resto (< 1 passo) fica no acumulador e é exposto como alpha para interpolação.
+// -----------------------------------------------------------------------------
+
+#include "engine/FixedStep.hpp"
+#include <algorithm>
+
+namespace engine {
+
+FixedStep::FixedStep(float hz, int maxSteps)
+    : m_step(1.0f / std::max(1.0f, hz)), m_maxSteps(std::max(1, maxSteps)) {}
+
+int FixedStep::advance(float frameDt) {
+    if (frameDt > 0.0f) m_acc += frameDt;
+
+    int steps = (int)(m_acc / (double)m_step);
+    if (steps > m_maxSteps) {
+        // Frame demasiado longo: corre só maxSteps e descarta o excesso (mantém a fracção).
+        m_dropped += steps - m_maxSteps;
+        m_acc -= (double)(steps - m_maxSteps) * (double)m_step;
+        steps = m_maxSteps;
+    }
+
+    m_acc -= (double)steps * (double)m_step;
+    if (m_acc < 0.0) m_acc = 0.0;
+    return steps;
+}
+
+void FixedStep::reset() {
+    m_acc = 0.0;
+}
+
+} // namespace engine
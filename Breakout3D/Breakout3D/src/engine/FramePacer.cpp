@@ -0,0 +1,181 @@
+// FramePacer.cpp
+// -----------------------------------------------------------------------------
+// FramePacer.cpp
+//
+// Responsabilidade:
+//  - Limitar o FPS (V-Sync está desligado) sem queimar um core inteiro.
+//  - Baixar para um FPS de idle quando o jogo está parado (menu/pausa/fim de jogo),
+//    mas acordar logo com input (glfwWaitEventsTimeout).
+//  - Medir CPU% e jitter de frame time por modo, para comparar ACTIVE vs IDLE.
+//
+// Notas:
+//  - Espera híbrida: sleep_for até (deadline - margem), depois spin com yield. A margem
+//    segue o erro de sleep observado (EMA), entre 0.25ms e 4ms.
+//  - O deadline é acumulado (deadline += período) para o FPS médio não derivar; se um
+//    frame atrasa mais de um período, re-sincroniza em vez de tentar "recuperar".
+//  - CPU% é tempo de CPU do processo inteiro (inclui áudio e workers de GIF) / tempo real,
+//    em % de um core.
+// -----------------------------------------------------------------------------
+
+#include "engine/FramePacer.hpp"
+#include "engine/Window.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace engine {
+
+static double processCpuSeconds() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        return (double)ru.ru_utime.tv_sec + (double)ru.ru_utime.tv_usec * 1e-6 +
+               (double)ru.ru_stime.tv_sec + (double)ru.ru_stime.tv_usec * 1e-6;
+    }
+#endif
+    return (double)std::clock() / (double)CLOCKS_PER_SEC;
+}
+
+static const char* modeName(int m) {
+    switch (m) {
+        case 0: return "active";
+        case 1: return "idle";
+        default: return "background";
+    }
+}
+
+FramePacer::FramePacer() {}
+
+void FramePacer::sleepUntil(clock::time_point deadline) {
+    for (;;) {
+        auto now = clock::now();
+        double remaining = std::chrono::duration<double>(deadline - now).count();
+        if (remaining <= 0.0) return;
+
+        if (remaining > m_spinMarginSec) {
+            // Sleep "grosso" e mede quanto o SO acordou atrasado para ajustar a margem.
+            double req = remaining - m_spinMarginSec;
+            std::this_thread::sleep_for(std::chrono::duration<double>(req));
+            double actual = std::chrono::duration<double>(clock::now() - now).count();
+            double over = std::max(0.0, actual - req);
+            m_spinMarginSec = std::clamp(m_spinMarginSec * 0.9 + over * 2.0 * 0.1, 0.00025, 0.004);
+            continue;
+        }
+
+        // Últimos < margem: spin (yield para não bloquear os outros threads).
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::endFrame(Window& window, Mode mode) {
+    auto now = clock::now();
+    if (!m_hasStart) {
+        m_hasStart = true;
+        m_frameStart = now;
+        m_deadline = now;
+        m_statsStart = now;
+        m_lastCpuSec = processCpuSeconds();
+        return;
+    }
+
+    double fps = m_targetFps;
+    if (mode == Mode::Idle) fps = m_idleFps;
+    else if (mode == Mode::Background) fps = m_backgroundFps;
+
+    if (fps > 0.0) {
+        auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / fps));
+        m_deadline += period;
+        if (now > m_deadline + period) m_deadline = now; // muito atrasado: re-sincroniza
+
+        if (mode == Mode::Active) {
+            sleepUntil(m_deadline);
+        } else {
+            // Idle: dorme no GLFW até ao deadline ou até chegar input.
+            double remaining = std::chrono::duration<double>(m_deadline - now).count();
+            if (remaining > 0.0) window.waitEvents(remaining);
+
+            auto woke = clock::now();
+            if (woke < m_deadline) {
+                // Acordou por um evento: responde já, mas nunca acima do FPS activo.
+                if (m_targetFps > 0.0) {
+                    auto minPeriod = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / m_targetFps));
+                    sleepUntil(m_frameStart + minPeriod);
+                }
+                m_deadline = clock::now();
+            }
+        }
+    } else {
+        m_deadline = now;
+    }
+
+    auto end = clock::now();
+    double cpu = processCpuSeconds();
+    record(mode, std::chrono::duration<double, std::milli>(end - m_frameStart).count(), cpu - m_lastCpuSec);
+    m_lastCpuSec = cpu;
+    m_frameStart = end;
+
+    if (m_statsInterval > 0.0 &&
+        std::chrono::duration<double>(end - m_statsStart).count() >= m_statsInterval) {
+        logStats(true);
+    }
+}
+
+void FramePacer::record(Mode mode, double frameMs, double cpuSec) {
+    ModeStats& s = m_stats[(int)mode];
+    s.frames++;
+    s.sumMs += frameMs;
+    s.sumSqMs += frameMs * frameMs;
+    s.maxMs = std::max(s.maxMs, frameMs);
+    s.wallSec += frameMs * 0.001;
+    s.cpuSec += std::max(0.0, cpuSec);
+
+    int b = (int)(frameMs * 10.0);
+    s.hist[std::clamp(b, 0, ModeStats::kBuckets - 1)]++;
+}
+
+void FramePacer::logStats(bool reset) {
+    for (int m = 0; m < 3; ++m) {
+        ModeStats& s = m_stats[m];
+        if (s.frames == 0) continue;
+
+        // Percentis a partir do histograma (resolução 0.1ms).
+        auto percentile = [&](double q) {
+            std::uint64_t target = (std::uint64_t)std::ceil(q * (double)s.frames);
+            std::uint64_t acc = 0;
+            for (int i = 0; i < ModeStats::kBuckets; ++i) {
+                acc += s.hist[i];
+                if (acc >= target) return (i + 0.5) * 0.1;
+            }
+            return ModeStats::kBuckets * 0.1;
+        };
+
+        double mean = s.sumMs / (double)s.frames;
+        double var = std::max(0.0, s.sumSqMs / (double)s.frames - mean * mean);
+        double fps = s.wallSec > 0.0 ? (double)s.frames / s.wallSec : 0.0;
+        double cpuPct = s.wallSec > 0.0 ? 100.0 * s.cpuSec / s.wallSec : 0.0;
+
+        auto oldFlags = std::cerr.flags();
+        auto oldPrec = std::cerr.precision(2);
+        std::cerr.setf(std::ios::fixed);
+        std::cerr << "[FramePacer] " << modeName(m) << ": " << s.frames << " frames, "
+                  << fps << " fps, frame " << mean << "ms (p50 " << percentile(0.50)
+                  << ", p99 " << percentile(0.99) << ", max " << s.maxMs << "), jitter sd "
+                  << std::sqrt(var) << "ms, cpu " << cpuPct << "%\n";
+        std::cerr.flags(oldFlags);
+        std::cerr.precision(oldPrec);
+    }
+
+    if (reset) {
+        for (auto& s : m_stats) s = ModeStats{};
+        m_statsStart = clock::now();
+    }
+}
+
+} // namespace engine
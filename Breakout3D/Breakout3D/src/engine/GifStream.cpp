@@ -0,0 +1,506 @@
+// GifStream.cpp
+#include "engine/GifStream.hpp"
+#include "engine/AssetFS.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// A implementação do stb_image vive aqui (e não em Texture.cpp) porque o decoder
+// incremental precisa dos internos do GIF (stbi__gif_load_next), que são static.
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
+
+namespace engine {
+
+/**
+ * @file GifStream.cpp
+ * @brief Decoder GIF frame-a-frame e reprodução em streaming com memória limitada.
+ *
+ * Ideia base:
+ * - `stbi_load_gif_from_memory` descodifica TODOS os frames para um buffer único
+ *   (centenas de MB para os previews 960x540); aqui usamos o mesmo decoder do stb,
+ *   mas um frame de cada vez sobre um canvas reutilizado.
+ * - Um worker mantém um ring de N frames à frente da reprodução; N sai do budget.
+ * - O thread GL só faz upload do frame que ficou "due", alternando entre 2 layers de um texture array.
+ */
+
+// ------------------------------------------------------------
+// GifDecoder
+// ------------------------------------------------------------
+
+struct GifDecoder::Impl {
+    AssetData bytes;
+    stbi__context ctx{};
+    stbi__gif g{};
+    int w = 0;
+    int h = 0;
+
+    // Disposal 3 ("restore previous") precisa do output de 2 frames atrás.
+    // Só guardamos cópias se o GIF o usar (evita 2 canvases extra no caso normal).
+    bool keepHistory = false;
+    std::vector<unsigned char> prev[2];
+    int produced = 0;
+    int frameCount = 0;
+    std::vector<int> delaysMs;
+
+    void freeGif() {
+        STBI_FREE(g.out);
+        STBI_FREE(g.history);
+        STBI_FREE(g.background);
+        std::memset(&g, 0, sizeof(g));
+        produced = 0;
+    }
+};
+
+// Procura Graphic Control Extensions com disposal 3. Falsos positivos (bytes de imagem)
+// só custam memória; falsos negativos não existem porque cada GCE tem este padrão.
+static bool usesRestorePrevious(const unsigned char* p, std::size_t n) {
+    for (std::size_t i = 0; i + 3 < n; ++i) {
+        if (p[i] == 0x21 && p[i + 1] == 0xF9 && p[i + 2] == 0x04 && ((p[i + 3] >> 2) & 7) == 3)
+            return true;
+    }
+    return false;
+}
+
+// Conta image descriptors saltando os sub-blocks (tamanho + dados), sem LZW. O delay de cada
+// frame vem da Graphic Control Extension que o precede (centésimos -> ms, como o stb).
+static int countGifFrames(const unsigned char* p, std::size_t n, std::vector<int>& delaysMs) {
+    delaysMs.clear();
+    std::size_t i = 13;
+    if (p[10] & 0x80) i += 3u * (1u << ((p[10] & 7) + 1)); // global color table
+
+    auto skipSubBlocks = [&]() {
+        while (i < n) {
+            const unsigned char len = p[i++];
+            if (len == 0) return;
+            i += len;
+        }
+    };
+
+    int frames = 0;
+    int pendingDelay = 0;
+    while (i < n) {
+        const unsigned char tag = p[i++];
+        if (tag == 0x3B) break; // trailer
+        if (tag == 0x21) {      // extension: label + sub-blocks
+            if (i + 5 < n && p[i] == 0xF9 && p[i + 1] == 0x04) pendingDelay = (p[i + 3] | (p[i + 4] << 8)) * 10;
+            i++;
+            skipSubBlocks();
+        } else if (tag == 0x2C) { // image descriptor (9) + LCT + LZW min size + sub-blocks
+            if (i + 9 > n) break;
+            const unsigned char flags = p[i + 8];
+            i += 9;
+            if (flags & 0x80) i += 3u * (1u << ((flags & 7) + 1));
+            i++;
+            skipSubBlocks();
+            delaysMs.push_back(pendingDelay); // sem GCE novo o stb repete o último delay
+            frames++;
+        } else {
+            break; // lixo: o decoder do stb também pára aqui
+        }
+    }
+    return frames;
+}
+
+GifDecoder::GifDecoder() : m(std::make_unique<Impl>()) {}
+
+GifDecoder::~GifDecoder() { close(); }
+
+bool GifDecoder::open(const std::string& path) {
+    close();
+
+    if (!AssetFS::read(path, m->bytes) || m->bytes.size < 13) return false;
+
+    const unsigned char* p = m->bytes.data;
+    stbi__start_mem(&m->ctx, p, (int)m->bytes.size);
+    if (!stbi__gif_test(&m->ctx)) {
+        close();
+        return false;
+    }
+
+    // Logical screen (o stb só lê o header no primeiro frame).
+    m->w = p[6] | (p[7] << 8);
+    m->h = p[8] | (p[9] << 8);
+    m->keepHistory = usesRestorePrevious(p, m->bytes.size);
+    m->frameCount = countGifFrames(p, m->bytes.size, m->delaysMs);
+    return m->w > 0 && m->h > 0;
+}
+
+void GifDecoder::close() {
+    m->freeGif();
+    m->bytes = AssetData();
+    m->prev[0].clear();
+    m->prev[0].shrink_to_fit();
+    m->prev[1].clear();
+    m->prev[1].shrink_to_fit();
+    m->w = m->h = 0;
+    m->keepHistory = false;
+    m->frameCount = 0;
+    m->delaysMs.clear();
+}
+
+bool GifDecoder::rewind() {
+    if (m->bytes.empty()) return false;
+    m->freeGif();
+    stbi__start_mem(&m->ctx, m->bytes.data, (int)m->bytes.size);
+    return true;
+}
+
+const unsigned char* GifDecoder::next(int& delayMs) {
+    delayMs = 0;
+    if (m->bytes.empty()) return nullptr;
+
+    const int k = m->produced;
+    unsigned char* twoBack = (m->keepHistory && k >= 2) ? m->prev[k & 1].data() : nullptr;
+
+    int comp = 0;
+    stbi_uc* u = stbi__gif_load_next(&m->ctx, &m->g, &comp, 4, twoBack);
+    if (!u || u == (stbi_uc*)&m->ctx) return nullptr; // erro / fim do GIF
+
+    m->w = m->g.w;
+    m->h = m->g.h;
+    delayMs = m->g.delay;
+
+    if (m->keepHistory) {
+        const std::size_t n = (std::size_t)m->w * (std::size_t)m->h * 4;
+        m->prev[k & 1].assign(u, u + n);
+    }
+    m->produced++;
+    return u;
+}
+
+int GifDecoder::width() const { return m->w; }
+int GifDecoder::height() const { return m->h; }
+int GifDecoder::frameCount() const { return m->frameCount; }
+const std::vector<int>& GifDecoder::frameDelaysMs() const { return m->delaysMs; }
+
+std::size_t GifDecoder::workingBytes() const {
+    const std::size_t px = (std::size_t)m->w * (std::size_t)m->h;
+    std::size_t bytes = px * 4 + px * 4 + px; // out + background + history (stb)
+    if (m->keepHistory) bytes += px * 8;
+    if (!m->bytes.owned.empty()) bytes += m->bytes.owned.size();
+    return bytes;
+}
+
+// ------------------------------------------------------------
+// StreamingGif
+// ------------------------------------------------------------
+
+void StreamingGif::start(const std::string& path, const GifStreamOptions& opt) {
+    stop();
+    m_stop = false;
+    m_failed = false;
+    m_worker = std::thread(&StreamingGif::run, this, path, opt);
+}
+
+void StreamingGif::stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+
+    // O PBO (se existir) só é libertado em destroy(): aqui não há garantia de contexto GL.
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_endMs.clear();
+    m_head = m_count = m_held = 0;
+    m_storageRequested = m_storageReady = false;
+    m_residentBytes = m_tex ? frameBytes() * kGpuLayers : 0;
+}
+
+void StreamingGif::destroy() {
+    stop();
+    if (m_fence) {
+        glDeleteSync(m_fence);
+        m_fence = nullptr;
+    }
+    if (m_pbo) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &m_pbo);
+        m_pbo = 0;
+        m_pboPtr = nullptr;
+        m_pboBytes = 0;
+    }
+    if (m_tex) {
+        glDeleteTextures(1, &m_tex);
+        m_tex = 0;
+    }
+    m_layer = -1;
+    m_frame = -1;
+    m_w = m_h = 0;
+    m_residentBytes = 0;
+}
+
+void StreamingGif::run(std::string path, GifStreamOptions opt) {
+    GifDecoder dec;
+    if (!dec.open(path) || dec.frameDelaysMs().empty()) {
+        std::cerr << "[GifStream] failed to open " << path << "\n";
+        m_failed = true;
+        return;
+    }
+
+    const int w = dec.width();
+    const int h = dec.height();
+    const std::size_t frameBytes = (std::size_t)w * (std::size_t)h * 4;
+    const int frameStep = std::max(1, opt.frameStep);
+
+    // Budget = decoder + layers na GPU + ring. O ring tem sempre pelo menos 2 slots
+    // (1 a ser lido pelo GL + 1 a ser escrito), mesmo que o budget seja mais apertado.
+    const std::size_t fixed = dec.workingBytes() + frameBytes * kGpuLayers;
+    int capacity = (opt.budgetBytes > fixed) ? (int)((opt.budgetBytes - fixed) / frameBytes) : 0;
+    capacity = std::max(2, capacity);
+
+    // Timeline dos frames mostrados (grupos de frameStep; o último pode vir incompleto, como no loop abaixo).
+    const std::vector<int>& delays = dec.frameDelaysMs();
+    std::vector<int> endMs;
+    endMs.reserve((delays.size() + (std::size_t)frameStep - 1) / (std::size_t)frameStep);
+    int acc = 0;
+    for (std::size_t i = 0; i < delays.size(); i += (std::size_t)frameStep) {
+        const std::size_t end = std::min(delays.size(), i + (std::size_t)frameStep);
+        for (std::size_t k = i; k < end; ++k) acc += (delays[k] > 0) ? delays[k] : 100;
+        endMs.push_back(acc);
+    }
+
+    // O ring é memória do PBO (criada no thread GL); o worker espera que esteja pronta.
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        if (m_stop) return;
+        m_w = w;
+        m_h = h;
+        m_slots.assign((std::size_t)capacity, Slot{});
+        m_endMs = std::move(endMs);
+        m_head = m_count = m_held = 0;
+        m_storageRequested = true;
+        m_cv.wait(lk, [&] { return m_stop || m_storageReady; });
+        if (m_stop) return;
+    }
+    m_residentBytes = fixed + (std::size_t)capacity * frameBytes;
+
+    // Diagnóstico de arranque (B3D_LOAD_STATS, como nos shaders); a falha de abrir imprime sempre.
+    if (const char* env = std::getenv("B3D_LOAD_STATS"); env && *env)
+        std::cerr << "[GifStream] " << path << ": " << w << "x" << h << ", ring " << capacity
+                  << " frames" << (m_pbo ? " (PBO)" : "") << ", ~" << (m_residentBytes.load() >> 20) << " MB\n";
+
+    const std::size_t stride = (std::size_t)w * 4;
+    bool anyFrame = false;
+    int frame = 0; // índice na timeline
+
+    for (;;) {
+        // Próximo frame visível: salta (frameStep-1) frames (os delays já estão na timeline).
+        const unsigned char* px = nullptr;
+        for (int k = 0; k < frameStep; ++k) {
+            int d = 0;
+            const unsigned char* p = dec.next(d);
+            if (!p) break;
+            px = p;
+        }
+
+        if (!px) {
+            // Fim do GIF: loop. Se nem um frame saiu, o ficheiro está estragado.
+            if (!anyFrame || !dec.rewind()) {
+                m_failed = !anyFrame;
+                return;
+            }
+            frame = 0;
+            continue;
+        }
+        anyFrame = true;
+
+        int slot = 0;
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [&] { return m_stop || m_count < (int)m_slots.size(); });
+            if (m_stop) return;
+            slot = (m_head + m_count) % (int)m_slots.size();
+        }
+
+        // O slot livre só é visto pelo GL depois de m_count++ (escrita sem lock).
+        // Com PBO persistente isto já é o memcpy final: o GL só agenda a cópia para a textura.
+        Slot& s = m_slots[(std::size_t)slot];
+        if (opt.flipY) {
+            for (int y = 0; y < h; ++y)
+                std::memcpy(s.data + (std::size_t)y * stride, px + (std::size_t)(h - 1 - y) * stride, stride);
+        } else {
+            std::memcpy(s.data, px, frameBytes);
+        }
+        s.frame = frame++;
+
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_count++;
+        }
+    }
+}
+
+void StreamingGif::ensureStorage() {
+    std::size_t bytes = 0;
+    int capacity = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (!m_storageRequested || m_storageReady) return;
+        capacity = (int)m_slots.size();
+        bytes = frameBytes() * (std::size_t)capacity;
+    }
+
+    // Ring num único PBO mapeado de forma persistente (GL 4.4 / ARB_buffer_storage):
+    // o worker escreve directamente na memória que o driver lê para o upload.
+    if (GLEW_ARB_buffer_storage && (!m_pbo || m_pboBytes != bytes)) {
+        if (m_pbo) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glDeleteBuffers(1, &m_pbo);
+        }
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &m_pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)bytes, nullptr, flags);
+        m_pboPtr = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)bytes, flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        m_pboBytes = bytes;
+
+        if (!m_pboPtr) {
+            glDeleteBuffers(1, &m_pbo);
+            m_pbo = 0;
+            m_pboBytes = 0;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (int i = 0; i < capacity; ++i) {
+            Slot& s = m_slots[(std::size_t)i];
+            if (m_pbo) {
+                s.data = m_pboPtr + (std::size_t)i * frameBytes();
+            } else {
+                // Sem buffer storage: ring em RAM e upload síncrono a partir dela.
+                s.cpu.resize(frameBytes());
+                s.data = s.cpu.data();
+            }
+        }
+        m_storageReady = true;
+    }
+    m_cv.notify_all();
+}
+
+void StreamingGif::retireUpload() {
+    if (!m_fence) return;
+
+    // Só devolve o slot ao worker quando a GPU acabou de ler do PBO (sem bloquear).
+    const GLenum r = glClientWaitSync(m_fence, 0, 0);
+    if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED) return;
+
+    glDeleteSync(m_fence);
+    m_fence = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_slots.empty()) return; // ring já foi libertado (stop)
+        m_head = (m_head + m_held) % (int)m_slots.size();
+        m_count -= m_held;
+        m_held = 0;
+    }
+    m_cv.notify_one();
+}
+
+void StreamingGif::upload(int slot) {
+    const Slot& s = m_slots[(std::size_t)slot];
+
+    if (!m_tex) {
+        glGenTextures(1, &m_tex);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_tex);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_w, m_h, kGpuLayers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_tex);
+    }
+
+    // Escreve na layer que não está no ecrã (o draw anterior ainda pode estar a ler a outra).
+    const int layer = (m_layer + 1) % kGpuLayers;
+    if (m_pbo) {
+        // Cópia PBO -> textura é assíncrona; a fence diz quando o slot pode ser reescrito.
+        const std::size_t offset = (std::size_t)slot * frameBytes();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_w, m_h, 1, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)offset);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    } else {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_w, m_h, 1, GL_RGBA, GL_UNSIGNED_BYTE, s.data);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    m_layer = layer;
+}
+
+int StreamingGif::timelineFrame(float tSec) const {
+    const float loopMs = std::fmod(std::max(0.0f, tSec - m_t0) * 1000.0f, (float)m_endMs.back());
+    return (int)(std::upper_bound(m_endMs.begin(), m_endMs.end(), (int)loopMs) - m_endMs.begin());
+}
+
+float StreamingGif::frameStartSec(int frame) const {
+    return (frame > 0 && frame <= (int)m_endMs.size()) ? (float)m_endMs[(std::size_t)frame - 1] * 0.001f : 0.0f;
+}
+
+int StreamingGif::frameAtTime(float tSec) {
+    ensureStorage();
+    retireUpload();
+
+    // Primeiro frame, ou estivemos muito tempo sem desenhar: re-sincroniza sem "rajada".
+    const bool resync = m_layer < 0 || tSec - m_lastT > 1.0f || tSec < m_lastT;
+    m_lastT = tSec;
+
+    int pops = 0;
+    int lastSlot = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        // Ainda há um upload em voo (fence pendente): mantém o frame actual.
+        if (m_held > 0) return m_layer;
+        if (m_count == 0 || m_slots.empty()) return m_layer;
+
+        const int cap = (int)m_slots.size();
+        const int n = (int)m_endMs.size();
+        if (resync) {
+            pops = 1;
+            m_frame = m_slots[(std::size_t)m_head].frame;
+            m_t0 = tSec - frameStartSec(m_frame);
+        } else {
+            // Consome os frames do ring até ao da timeline (só o último é enviado para a GPU).
+            // Frames fora da timeline (contagem do open errada) passam logo.
+            const int target = timelineFrame(tSec);
+            while (pops < m_count) {
+                const int f = m_slots[(std::size_t)((m_head + pops) % cap)].frame;
+                const int ahead = (target - m_frame + n) % n;
+                const int dist = (f - m_frame + n) % n;
+                if (f < n && (dist == 0 || dist > ahead)) break;
+                m_frame = f;
+                pops++;
+            }
+        }
+        if (pops == 0) return m_layer;
+        lastSlot = (m_head + pops - 1) % cap;
+    }
+
+    // Upload fora do lock: o worker não reescreve slots ainda contados em m_count.
+    upload(lastSlot);
+
+    {
+        // Os frames saltados voltam já para o worker; o enviado fica "held" até a fence sinalizar.
+        std::lock_guard<std::mutex> lk(m_mutex);
+        const int release = m_fence ? pops - 1 : pops;
+        m_head = (m_head + release) % (int)m_slots.size();
+        m_count -= release;
+        m_held = pops - release;
+    }
+    m_cv.notify_one();
+    return m_layer;
+}
+
+} // namespace engine
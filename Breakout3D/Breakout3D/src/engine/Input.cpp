@@ -12,7 +12,7 @@ namespace engine {
  * @brief Adaptação de input (teclado/rato) para uma enum própria do jogo.
  *
  * O Input faz “polling” do estado no fim/início de cada frame:
- * - guarda estado actual (down) e o anterior (prev) para detectar edges (pressed)
+ * - compara o estado actual (down) com o anterior para detectar edges (pressed)
  * - converte coordenadas do cursor para pixels do framebuffer (para UI / hit-testing)
  * - lê o scroll acumulado do Window (o callback mete lá os deltas)
  */
@@ -39,6 +39,7 @@ static int keyToGlfw(Key k) {
         case Key::Minus:  return GLFW_KEY_MINUS;
         case Key::L:      return GLFW_KEY_L;
         case Key::R:      return GLFW_KEY_R;
+        case Key::Backspace: return GLFW_KEY_BACKSPACE;
     }
     return GLFW_KEY_UNKNOWN;
 }
@@ -54,8 +55,10 @@ static int mouseToGlfw(MouseButton b) {
 
 void Input::update(Window& window) {
     // Guarda o estado anterior para poderes fazer "pressed" (edge).
-    std::copy(std::begin(m_keyDown),   std::end(m_keyDown),   std::begin(m_keyPrev));
-    std::copy(std::begin(m_mouseDown), std::end(m_mouseDown), std::begin(m_mousePrev));
+    bool keyPrev[KEY_COUNT];
+    bool mousePrev[1];
+    std::copy(std::begin(m_keyDown),   std::end(m_keyDown),   std::begin(keyPrev));
+    std::copy(std::begin(m_mouseDown), std::end(m_mouseDown), std::begin(mousePrev));
 
     // O scroll é acumulado no Window (via callbacks); aqui consumimos e fazemos reset.
     m_scrollY = window.consumeScrollY();
@@ -72,6 +75,9 @@ void Input::update(Window& window) {
         m_mouseDown[i] = (glfwGetMouseButton(w, mouseToGlfw((MouseButton)i)) == GLFW_PRESS);
     }
 
+    for (int i = 0; i < KEY_COUNT; ++i) m_keyPressed[i] = m_keyDown[i] && !keyPrev[i];
+    for (int i = 0; i < 1; ++i) m_mousePressed[i] = m_mouseDown[i] && !mousePrev[i];
+
     // Posição do cursor em coordenadas de janela (pixels “window space”).
     double mx, my;
     glfwGetCursorPos(w, &mx, &my);
@@ -90,11 +96,55 @@ void Input::update(Window& window) {
 }
 
 bool Input::keyDown(Key k) const { return m_keyDown[(int)k]; }
-bool Input::keyPressed(Key k) const { return m_keyDown[(int)k] && !m_keyPrev[(int)k]; }
+bool Input::keyPressed(Key k) const { return m_keyPressed[(int)k]; }
 
 bool Input::mouseDown(MouseButton b) const { return m_mouseDown[(int)b]; }
-bool Input::mousePressed(MouseButton b) const { return m_mouseDown[(int)b] && !m_mousePrev[(int)b]; }
+bool Input::mousePressed(MouseButton b) const { return m_mousePressed[(int)b]; }
 
 std::pair<float,float> Input::mousePosFbPx() const { return {m_mouseX, m_mouseY}; }
 
+void InputSample::mergeNewer(const InputSample& next) {
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        keyDown[i] = next.keyDown[i];
+        keyPressed[i] = keyPressed[i] || next.keyPressed[i];
+    }
+    for (int i = 0; i < 1; ++i) {
+        mouseDown[i] = next.mouseDown[i];
+        mousePressed[i] = mousePressed[i] || next.mousePressed[i];
+    }
+    mouseX = next.mouseX;
+    mouseY = next.mouseY;
+    scrollY += next.scrollY;
+}
+
+InputSample Input::sample() const {
+    InputSample s;
+    std::copy(std::begin(m_keyDown), std::end(m_keyDown), std::begin(s.keyDown));
+    std::copy(std::begin(m_keyPressed), std::end(m_keyPressed), std::begin(s.keyPressed));
+    std::copy(std::begin(m_mouseDown), std::end(m_mouseDown), std::begin(s.mouseDown));
+    std::copy(std::begin(m_mousePressed), std::end(m_mousePressed), std::begin(s.mousePressed));
+    s.mouseX = m_mouseX;
+    s.mouseY = m_mouseY;
+    s.scrollY = m_scrollY;
+    return s;
+}
+
+void Input::applySamples(const InputSample* samples, int count) {
+    // Sem amostras: mantém down/rato, limpa edges e scroll (não houve eventos novos).
+    InputSample merged = sample();
+    std::fill(std::begin(merged.keyPressed), std::end(merged.keyPressed), false);
+    std::fill(std::begin(merged.mousePressed), std::end(merged.mousePressed), false);
+    merged.scrollY = 0.0f;
+
+    for (int i = 0; i < count; ++i) merged.mergeNewer(samples[i]);
+
+    std::copy(std::begin(merged.keyDown), std::end(merged.keyDown), std::begin(m_keyDown));
+    std::copy(std::begin(merged.keyPressed), std::end(merged.keyPressed), std::begin(m_keyPressed));
+    std::copy(std::begin(merged.mouseDown), std::end(merged.mouseDown), std::begin(m_mouseDown));
+    std::copy(std::begin(merged.mousePressed), std::end(merged.mousePressed), std::begin(m_mousePressed));
+    m_mouseX = merged.mouseX;
+    m_mouseY = merged.mouseY;
+    m_scrollY = merged.scrollY;
+}
+
 } // namespace engine
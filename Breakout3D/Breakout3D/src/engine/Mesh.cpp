@@ -1,10 +1,10 @@
 // Mesh.cpp
 #include "engine/Mesh.hpp"
-#include "engine/Texture.hpp"
+#include "engine/TextureCache.hpp"
+#include "engine/AssetFS.hpp"
 
 #include <vector>
 #include <string>
-#include <fstream>
 #include <sstream>
 #include <unordered_map>
 #include <stdexcept>
@@ -50,8 +50,9 @@ static std::string lastToken(const std::string& line) {
 
 // Leitura simples de .mtl: suporta newmtl, Kd, map_Kd (ignorando flags no map_Kd).
 static std::unordered_map<std::string, MTLMat> loadMTL(const fs::path& mtlPath) {
-    std::ifstream f(mtlPath);
-    if (!f) throw std::runtime_error("Can't open MTL: " + mtlPath.string());
+    std::string text;
+    if (!AssetFS::readText(mtlPath.string(), text)) throw std::runtime_error("Can't open MTL: " + mtlPath.string());
+    std::istringstream f(text);
 
     std::unordered_map<std::string, MTLMat> mats;
     std::string line;
@@ -190,9 +191,22 @@ void Mesh::setBaseDirPath(const std::string& baseDirPath) {
     g_baseDirPath = baseDirPath;
 }
 
+void Mesh::bindVertexLayout() {
+    // Layout de atributos: 0 pos, 1 normal, 2 uv.
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, px));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, nx));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+}
+
 void Mesh::destroy() {
     // Destrói recursos OpenGL associados ao mesh.
-    if (textureId) glDeleteTextures(1, &textureId);
+    // A textura é partilhada (TextureCache): só larga a referência deste mesh.
+    TextureCache::release(textureId);
     textureId = 0;
 
     if (ebo) glDeleteBuffers(1, &ebo);
@@ -212,8 +226,10 @@ Mesh Mesh::loadOBJ(const std::string& objRelativeOrFullPath) {
     }
     objPath = fs::absolute(objPath);
 
-    std::ifstream f(objPath);
-    if (!f) throw std::runtime_error("Can't open OBJ: " + objPath.string());
+    // Via AssetFS: pack montado (mmap) ou ficheiro solto.
+    std::string text;
+    if (!AssetFS::readText(objPath.string(), text)) throw std::runtime_error("Can't open OBJ: " + objPath.string());
+    std::istringstream f(text);
 
     fs::path objDir = objPath.parent_path();
 
@@ -274,13 +290,12 @@ Mesh Mesh::loadOBJ(const std::string& objRelativeOrFullPath) {
 
             try {
                 // flipY=true para alinhar texturas com o teu pipeline (UV vs imagem).
-                Texture2D t = Texture2D::loadFromFile(texPath.string(), true);
+                // Via cache: meshes com o mesmo map_Kd partilham decode + upload.
+                GLuint tex = TextureCache::acquire(texPath.string(), true);
 
-                // Se já havia textura, remove para evitar leaks (caso o material mude).
-                if (mesh.textureId) glDeleteTextures(1, &mesh.textureId);
-
-                mesh.textureId = t.id;
-                t.id = 0; // passa ownership para o Mesh
+                // Se já havia textura, larga a referência (caso o material mude).
+                TextureCache::release(mesh.textureId);
+                mesh.textureId = tex;
             } catch (const std::exception& e) {
                 std::cerr << "[Mesh] texture load failed for " << texPath.string()
                           << " : " << e.what() << "\n";
@@ -384,15 +399,7 @@ Mesh Mesh::loadOBJ(const std::string& objRelativeOrFullPath) {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(indices.size() * sizeof(unsigned int)), indices.data(), GL_STATIC_DRAW);
 
-    // Layout de atributos: 0 pos, 1 normal, 2 uv.
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, px));
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, nx));
-
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+    bindVertexLayout();
 
     glBindVertexArray(0);
 
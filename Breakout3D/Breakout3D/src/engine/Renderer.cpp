@@ -1,8 +1,10 @@
 // Renderer.cpp
 #include "engine/Renderer.hpp"
+#include "engine/AssetFS.hpp"
 #include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
-#include <fstream>
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 #include <stdexcept>
 
@@ -40,21 +42,13 @@ static void setTexMode(GLuint p, int mode) {
 }
 
 bool Renderer::loadUIFont(const std::string& ttfPath) {
-    // Lê o TTF inteiro para memória (stb_truetype usa ponteiros para o buffer).
-    std::ifstream f(ttfPath, std::ios::binary);
-    if (!f) return false;
-    f.seekg(0, std::ios::end);
-    std::streamoff len = f.tellg();
-    f.seekg(0, std::ios::beg);
-    if (len <= 0) return false;
-
-    std::vector<unsigned char> ttf((size_t)len);
-    f.read(reinterpret_cast<char*>(ttf.data()), len);
-    if (!f) return false;
+    // TTF inteiro em memória (stb_truetype usa ponteiros para o buffer; do pack é zero-copy).
+    AssetData ttf;
+    if (!AssetFS::read(ttfPath, ttf) || ttf.empty()) return false;
 
     // Inicializa para métricas (ascent/descent/lineGap), usado para alinhamento e alturas.
     stbtt_fontinfo info{};
-    if (!stbtt_InitFont(&info, ttf.data(), stbtt_GetFontOffsetForIndex(ttf.data(), 0))) {
+    if (!stbtt_InitFont(&info, ttf.data, stbtt_GetFontOffsetForIndex(ttf.data, 0))) {
         return false;
     }
 
@@ -80,7 +74,7 @@ bool Renderer::loadUIFont(const std::string& ttfPath) {
         m_uiFontTexH = s;
         bitmap.assign((size_t)m_uiFontTexW * (size_t)m_uiFontTexH, 0);
         ok = stbtt_BakeFontBitmap(
-            ttf.data(), 0,
+            ttf.data, 0,
             m_uiFontPixelHeight,
             bitmap.data(), m_uiFontTexW, m_uiFontTexH,
             32, 96,
@@ -119,6 +113,14 @@ bool Renderer::init() {
 
     if (!m_shader.load("assets/shaders/basic_phong.vert", "assets/shaders/basic_phong.frag"))
         return false;
+    // Samplers de tipos diferentes têm de estar em units diferentes (uTex=0, uTexArray=1).
+    m_shader.use();
+    setInt(m_shader.id(), "uTex", 0);
+    setInt(m_shader.id(), "uTexArray", 1);
+    if (!m_instShader.load("assets/shaders/mesh_instanced.vert", "assets/shaders/mesh_instanced.frag"))
+        return false;
+
+    if (!m_instVbo) glGenBuffers(1, &m_instVbo);
 
     // Fonte default para UI (tenta vários ficheiros por ordem, com fallback).
     if (!loadUIFont("assets/fonts/Orbitron-Bold.ttf")) {
@@ -162,6 +164,14 @@ bool Renderer::init() {
 void Renderer::shutdown() {
     // Liberta shader e recursos de UI/fonte.
     m_shader.destroy();
+    m_instShader.destroy();
+
+    for (auto& kv : m_instVaos) glDeleteVertexArrays(1, &kv.second);
+    m_instVaos.clear();
+    if (m_instVbo) {
+        glDeleteBuffers(1, &m_instVbo);
+        m_instVbo = 0;
+    }
 
     if (m_uiFontTex) {
         glDeleteTextures(1, &m_uiFontTex);
@@ -312,6 +322,77 @@ void Renderer::drawMesh(const Mesh& mesh, const glm::mat4& M, const glm::vec3& t
     if (useTex) glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+static_assert(sizeof(MeshInstance) == 32, "MeshInstance tem de bater com o layout do VBO de instâncias");
+
+GLuint Renderer::instancedVaoFor(const Mesh& mesh) {
+    auto it = m_instVaos.find(mesh.vao);
+    if (it != m_instVaos.end()) return it->second;
+
+    // VAO próprio que reutiliza o VBO/EBO do mesh e acrescenta os atributos por instância.
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    Mesh::bindVertexLayout();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_instVbo);
+    // iPosLayer: location 3 (pos.xyz + layer)
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), (void*)offsetof(MeshInstance, pos));
+    glVertexAttribDivisor(3, 1);
+    // iSize: location 4
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), (void*)offsetof(MeshInstance, size));
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_instVaos[mesh.vao] = vao;
+    return vao;
+}
+
+void Renderer::drawMeshInstanced(const Mesh& mesh, const TextureArray2D& texArray,
+                                 const std::vector<MeshInstance>& instances, const glm::vec3& tint) {
+    if (instances.empty() || !mesh.vao || !texArray.id) return;
+
+    m_instShader.use();
+    GLuint p = m_instShader.id();
+
+    setMat4(p, "uV", m_V);
+    setMat4(p, "uP", m_P);
+
+    setVec3(p, "uViewPos", m_camPos);
+    setVec3(p, "uLightPos", m_lightPos);
+    setVec3(p, "uLightColor", m_lightColor);
+
+    setFloat(p, "uAmbientK",  m_ambientK);
+    setFloat(p, "uDiffuseK",  m_diffuseK);
+    setFloat(p, "uSpecK",     m_specK);
+    setFloat(p, "uShininess", m_shininess);
+
+    glm::vec3 kd(mesh.kd[0], mesh.kd[1], mesh.kd[2]);
+    setVec3(p, "uAlbedo", kd * tint);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texArray.id);
+    setInt(p, "uTexArray", 0);
+
+    // Orphan + upload: o driver não tem de esperar pelo draw do frame anterior.
+    glBindBuffer(GL_ARRAY_BUFFER, m_instVbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(instances.size() * sizeof(MeshInstance)),
+                 instances.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindVertexArray(instancedVaoFor(mesh));
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, (void*)0, (GLsizei)instances.size());
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
 void Renderer::drawMesh(const Mesh& mesh, const glm::vec3& pos, const glm::vec3& size, const glm::vec3& tint) {
     glm::mat4 M(1.0f);
     M = glm::translate(M, pos);
@@ -392,6 +473,16 @@ void Renderer::drawUIQuad(float x, float y, float w, float h, const glm::vec4& c
 
 // Overload: quad com textura (usa UVs 0..1).
 void Renderer::drawUIQuad(float x, float y, float w, float h, const glm::vec4& color, unsigned int textureId) {
+    drawUITexturedQuad(x, y, w, h, color, textureId, -1);
+}
+
+void Renderer::drawUIQuadLayer(float x, float y, float w, float h, const glm::vec4& color,
+                               unsigned int textureArrayId, int layer) {
+    drawUITexturedQuad(x, y, w, h, color, textureArrayId, std::max(0, layer));
+}
+
+void Renderer::drawUITexturedQuad(float x, float y, float w, float h, const glm::vec4& color,
+                                  unsigned int textureId, int layer) {
     m_shader.use();
     GLuint p = m_shader.id();
 
@@ -403,10 +494,20 @@ void Renderer::drawUIQuad(float x, float y, float w, float h, const glm::vec4& c
     setMat4(p, "uM", M);
 
     setInt(p, "uUseTex", 1);
-    setTexMode(p, 0);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    setInt(p, "uTex", 0);
+    if (layer < 0) {
+        setTexMode(p, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        setInt(p, "uTex", 0);
+    } else {
+        // Texture array na unit 1 (sampler2DArray não pode partilhar a unit do uTex).
+        setTexMode(p, 2);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureId);
+        glActiveTexture(GL_TEXTURE0);
+        setInt(p, "uTexArray", 1);
+        setFloat(p, "uTexLayer", (float)layer);
+    }
 
     setVec3(p, "uAlbedo", glm::vec3(color));
     setFloat(p, "uAlpha", color.a);
@@ -3,33 +3,45 @@
 // Shader.cpp
 //
 // Responsabilidade:
-//  - Carregar ficheiros GLSL (vertex/fragment) a partir do disco.
+//  - Carregar ficheiros GLSL (vertex/fragment) via AssetFS (pack ou disco).
 //  - Compilar shaders, fazer link do programa e reportar erros para stderr.
 //  - Expor um wrapper simples para usar o programa e definir uniforms comuns.
+//  - Cache de program binaries (glGetProgramBinary/glProgramBinary) por utilizador.
 //
 // Notas:
 //  - A função load() faz destroy() antes de criar um novo programa para evitar leaks.
 //  - checkShader/checkProgram imprimem logs completos quando há falhas.
+//  - Chave da cache = hash das fontes + GL_VENDOR/GL_RENDERER/GL_VERSION: mudar de driver ou
+//    de GPU invalida sozinho. Binário rejeitado pelo driver => compila da fonte e regrava.
+//  - B3D_LOAD_STATS=1 imprime o custo de cada load (cache hit / compilado da fonte).
 // -----------------------------------------------------------------------------
 
 #include "engine/Shader.hpp"
+#include "engine/AssetFS.hpp"
 #include <GL/glew.h>
 
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 namespace engine {
 
+namespace fs = std::filesystem;
+
 static std::string loadFile(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) {
+    std::string src;
+    if (!AssetFS::readText(path, src)) {
         std::cerr << "Failed to open shader file: " << path << "\n";
         return {};
     }
-    std::stringstream ss;
-    ss << f.rdbuf();
-    return ss.str();
+    return src;
 }
 
 static bool checkShader(GLuint s, const char* label) {
@@ -60,6 +72,119 @@ static bool checkProgram(GLuint p) {
     return true;
 }
 
+// ---------------- Program binary cache ----------------
+
+static const char kBinaryMagic[8] = {'B', '3', 'D', 'S', 'H', 'B', 'I', 'N'};
+
+static std::uint64_t fnv1a(std::uint64_t h, const std::string& s) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static std::string glString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? std::string((const char*)s) : std::string();
+}
+
+// Directoria por utilizador (XDG cache / LOCALAPPDATA / ~/.cache), com fallback local.
+static fs::path shaderCacheDir() {
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return fs::path(xdg) / "breakout3d" / "shaders";
+    if (const char* lad = std::getenv("LOCALAPPDATA"); lad && *lad) return fs::path(lad) / "Breakout3D" / "shaders";
+    if (const char* home = std::getenv("HOME"); home && *home) return fs::path(home) / ".cache" / "breakout3d" / "shaders";
+    return fs::path("shader_cache");
+}
+
+// Diagnóstico de arranque (como o B3D_FRAME_STATS do FramePacer): só com a env var definida.
+static bool loadStatsEnabled() {
+    const char* env = std::getenv("B3D_LOAD_STATS");
+    return env && *env;
+}
+
+static bool programBinarySupported() {
+    if (!GLEW_ARB_get_program_binary) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+static fs::path cacheFileFor(const std::string& vs, const std::string& fsrc) {
+    std::uint64_t h = 1469598103934665603ull;
+    h = fnv1a(h, vs);
+    h = fnv1a(h, std::string(1, '\0'));
+    h = fnv1a(h, fsrc);
+    h = fnv1a(h, glString(GL_VENDOR));
+    h = fnv1a(h, glString(GL_RENDERER));
+    h = fnv1a(h, glString(GL_VERSION));
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << h << ".bin";
+    return shaderCacheDir() / name.str();
+}
+
+// Tenta criar o programa a partir do binário em cache. 0 se não existir ou o driver o rejeitar.
+static GLuint loadCachedProgram(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) return 0;
+
+    char magic[8] = {};
+    std::uint32_t format = 0;
+    std::uint32_t size = 0;
+    in.read(magic, sizeof(magic));
+    in.read((char*)&format, sizeof(format));
+    in.read((char*)&size, sizeof(size));
+    if (!in || std::memcmp(magic, kBinaryMagic, sizeof(magic)) != 0 || size == 0) return 0;
+
+    std::vector<char> blob(size);
+    in.read(blob.data(), (std::streamsize)size);
+    if (!in) return 0;
+
+    GLuint p = glCreateProgram();
+    glProgramBinary(p, (GLenum)format, blob.data(), (GLsizei)size);
+
+    GLint ok = 0;
+    glGetProgramiv(p, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        glDeleteProgram(p);
+        return 0;
+    }
+    return p;
+}
+
+static void storeProgramBinary(GLuint p, const fs::path& file) {
+    GLint len = 0;
+    glGetProgramiv(p, GL_PROGRAM_BINARY_LENGTH, &len);
+    if (len <= 0) return;
+
+    std::vector<char> blob((std::size_t)len);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(p, len, &written, &format, blob.data());
+    if (written <= 0) return;
+
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+
+    // Escreve para .tmp e renomeia (nunca deixa um binário a meio se o jogo morrer aqui).
+    fs::path tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        const std::uint32_t fmt = (std::uint32_t)format;
+        const std::uint32_t size = (std::uint32_t)written;
+        out.write(kBinaryMagic, sizeof(kBinaryMagic));
+        out.write((const char*)&fmt, sizeof(fmt));
+        out.write((const char*)&size, sizeof(size));
+        out.write(blob.data(), written);
+        if (!out) return;
+    }
+    fs::rename(tmp, file, ec);
+    if (ec) fs::remove(tmp, ec);
+}
+
 Shader::Shader() {}
 
 Shader::~Shader() {
@@ -69,11 +194,31 @@ Shader::~Shader() {
 bool Shader::load(const std::string& vertPath, const std::string& fragPath) {
     destroy();
 
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    auto elapsedMs = [&]() { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); };
+    const std::string label = std::filesystem::path(vertPath).stem().string();
+
     std::string vs = loadFile(vertPath);
     std::string fs = loadFile(fragPath);
     if (vs.empty() || fs.empty())
         return false;
 
+    // 1) Cache de binários (se o driver suportar).
+    const bool useCache = programBinarySupported();
+    std::filesystem::path cacheFile;
+    if (useCache) {
+        cacheFile = cacheFileFor(vs, fs);
+        m_id = loadCachedProgram(cacheFile);
+        if (m_id) {
+            if (loadStatsEnabled())
+                std::cerr << "[Shader] " << label << ": program binary cache hit ("
+                          << std::fixed << std::setprecision(2) << elapsedMs() << " ms)\n" << std::defaultfloat;
+            return true;
+        }
+    }
+
+    // 2) Compilação a partir da fonte.
     const char* vsrc = vs.c_str();
     const char* fsrc = fs.c_str();
 
@@ -95,6 +240,7 @@ bool Shader::load(const std::string& vertPath, const std::string& fragPath) {
     }
 
     m_id = glCreateProgram();
+    if (useCache) glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glAttachShader(m_id, v);
     glAttachShader(m_id, f);
     glLinkProgram(m_id);
@@ -107,6 +253,11 @@ bool Shader::load(const std::string& vertPath, const std::string& fragPath) {
         return false;
     }
 
+    if (loadStatsEnabled())
+        std::cerr << "[Shader] " << label << ": compiled from source ("
+                  << std::fixed << std::setprecision(2) << elapsedMs() << " ms)\n" << std::defaultfloat;
+
+    if (useCache) storeProgramBinary(m_id, cacheFile);
     return true;
 }
 
@@ -3,37 +3,246 @@
 // Texture.cpp
 //
 // Responsabilidade:
-//  - Carregar imagens do disco via stb_image e criar Textures 2D em OpenGL.
+//  - Carregar imagens (pack ou disco, via AssetFS) com stb_image e criar Textures 2D em OpenGL.
 //  - Suportar flip vertical no load (útil para alinhar UVs com a convenção do motor).
+//  - Carregar contentores KTX2 (tools/ktx2conv) com mips já calculados, sem decode.
 //  - Criar texturas a partir de buffers RGBA já existentes (ex.: GIF frames, UI).
+//  - Criar GL_TEXTURE_2D_ARRAY a partir de várias imagens do mesmo tamanho (uma layer cada).
 //
 // Notas:
+//  - loadFromFile() prefere "<nome>.ktx2" se existir; se o formato não for suportado
+//    pelo driver (s3tc/bptc), faz fallback para o decode normal da imagem original.
 //  - loadFromFile() escolhe o formato (RED/RGB/RGBA) com base nos channels.
 //  - Por default cria mipmaps e usa GL_LINEAR_MIPMAP_LINEAR para minificação.
 //  - destroy() liberta a textura OpenGL para evitar leaks.
 // -----------------------------------------------------------------------------
 
 #include "engine/Texture.hpp"
+#include "engine/AssetFS.hpp"
+#include "engine/Ktx2Format.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
 
-#define STB_IMAGE_IMPLEMENTATION
+// A implementação do stb_image está em GifStream.cpp (STB_IMAGE_IMPLEMENTATION).
 #include "external/stb_image.h"
 
 namespace engine {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+TextureLoadStats g_loadStats;
+
+double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// VkFormat -> formato GL (devolve false se o driver não suportar).
+bool glFormatForVk(std::uint32_t vkFormat, GLenum& internalFormat) {
+    switch (vkFormat) {
+        case ktx2::kVkR8G8B8A8Unorm: internalFormat = GL_RGBA8; return true;
+        case ktx2::kVkBc1RgbUnorm:   internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;  return GLEW_EXT_texture_compression_s3tc;
+        case ktx2::kVkBc1RgbaUnorm:  internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; return GLEW_EXT_texture_compression_s3tc;
+        case ktx2::kVkBc3Unorm:      internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; return GLEW_EXT_texture_compression_s3tc;
+        case ktx2::kVkBc7Unorm:      internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;    return GLEW_ARB_texture_compression_bptc;
+        default: return false;
+    }
+}
+
+// Valor de "KTXorientation" no bloco key/value ("rd" por omissão = primeira linha em cima).
+std::string ktx2Orientation(const unsigned char* data, std::size_t size, const ktx2::Index& idx) {
+    std::size_t pos = idx.kvdByteOffset;
+    const std::size_t end = (std::size_t)idx.kvdByteOffset + idx.kvdByteLength;
+    if (end > size) return "rd";
+
+    while (pos + 4 <= end) {
+        std::uint32_t len = 0;
+        std::memcpy(&len, data + pos, 4);
+        pos += 4;
+        if (len == 0 || pos + len > end) break;
+
+        const char* kv = reinterpret_cast<const char*>(data + pos);
+        const std::size_t keyLen = strnlen(kv, len);
+        if (keyLen < len && std::strcmp(kv, "KTXorientation") == 0) {
+            return std::string(kv + keyLen + 1, strnlen(kv + keyLen + 1, len - keyLen - 1));
+        }
+        pos += (len + 3u) & ~3u;
+    }
+    return "rd";
+}
+
+// KTX2 já validado: header + níveis dentro do ficheiro e formato suportado pelo driver.
+struct Ktx2Image {
+    ktx2::Header hdr{};
+    std::vector<ktx2::LevelIndex> levels;
+    GLenum internalFormat = 0;
+    bool compressed = false;
+};
+
+// Lê e valida um KTX2 (lança std::runtime_error com o motivo; o caller decide o fallback).
+void parseKtx2(const std::string& path, bool flipY, AssetData& file, Ktx2Image& img) {
+    if (!AssetFS::read(path, file)) throw std::runtime_error("can't read KTX2: " + path);
+
+    const std::size_t headerEnd = ktx2::kLevelIndexOffset;
+    if (file.size < headerEnd || std::memcmp(file.data, ktx2::kIdentifier, sizeof(ktx2::kIdentifier)) != 0) {
+        throw std::runtime_error("not a KTX2 file: " + path);
+    }
+
+    ktx2::Index idx;
+    std::memcpy(&img.hdr, file.data + 12, sizeof(img.hdr));
+    std::memcpy(&idx, file.data + 12 + sizeof(img.hdr), sizeof(idx));
+    const ktx2::Header& hdr = img.hdr;
+
+    if (hdr.pixelDepth > 1 || hdr.layerCount > 1 || hdr.faceCount != 1 || hdr.supercompressionScheme != 0) {
+        throw std::runtime_error("unsupported KTX2 layout (only plain 2D): " + path);
+    }
+    const std::uint32_t levels = std::max<std::uint32_t>(1, hdr.levelCount);
+    if (hdr.pixelWidth == 0 || hdr.pixelHeight == 0 || headerEnd + levels * sizeof(ktx2::LevelIndex) > file.size) {
+        throw std::runtime_error("truncated KTX2: " + path);
+    }
+
+    // Orientação tem de bater com o pedido (os blocos BC não se podem inverter no load).
+    const bool fileFlipped = ktx2Orientation(file.data, file.size, idx).compare(0, 2, "ru") == 0;
+    if (fileFlipped != flipY) throw std::runtime_error("KTX2 orientation mismatch: " + path);
+
+    if (!glFormatForVk(hdr.vkFormat, img.internalFormat)) {
+        throw std::runtime_error("KTX2 format not supported by driver: " + path);
+    }
+    img.compressed = ktx2::blockBytes(hdr.vkFormat) != 0;
+
+    img.levels.resize(levels);
+    for (std::uint32_t i = 0; i < levels; ++i) {
+        ktx2::LevelIndex& lvl = img.levels[i];
+        std::memcpy(&lvl, file.data + headerEnd + i * sizeof(lvl), sizeof(lvl));
+
+        const std::uint32_t lw = std::max<std::uint32_t>(1, hdr.pixelWidth >> i);
+        const std::uint32_t lh = std::max<std::uint32_t>(1, hdr.pixelHeight >> i);
+        if (lvl.byteOffset + lvl.byteLength > file.size || lvl.byteLength != ktx2::levelBytes(hdr.vkFormat, lw, lh)) {
+            throw std::runtime_error("bad KTX2 level data: " + path);
+        }
+    }
+}
+
+// Arrays: todas as layers em KTX2 compatível (mesmo formato/tamanho/mips)? Senão, decode PNG.
+bool loadArrayLayersKtx2(const std::vector<std::string>& paths, bool flipY,
+                         std::vector<AssetData>& files, std::vector<Ktx2Image>& imgs) {
+    namespace fs = std::filesystem;
+    files.clear();
+    imgs.clear();
+    files.resize(paths.size());
+    imgs.resize(paths.size());
+
+    try {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            const std::string ktxPath = fs::path(paths[i]).replace_extension(".ktx2").string();
+            if (!AssetFS::exists(ktxPath)) return false;
+            parseKtx2(ktxPath, flipY, files[i], imgs[i]);
+
+            const ktx2::Header& a = imgs[0].hdr;
+            const ktx2::Header& b = imgs[i].hdr;
+            if (a.vkFormat != b.vkFormat || a.pixelWidth != b.pixelWidth || a.pixelHeight != b.pixelHeight ||
+                imgs[0].levels.size() != imgs[i].levels.size()) {
+                throw std::runtime_error("KTX2 layers differ: " + ktxPath);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Texture] " << e.what() << " (fallback: decode images)\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+const TextureLoadStats& textureLoadStats() {
+    return g_loadStats;
+}
+
 void Texture2D::destroy() {
     if (id) glDeleteTextures(1, &id);
     id = 0;
     w = h = channels = 0;
+    bytes = 0;
+}
+
+Texture2D Texture2D::loadKTX2(const std::string& path, bool flipY) {
+    const auto t0 = Clock::now();
+
+    AssetData file;
+    Ktx2Image img;
+    parseKtx2(path, flipY, file, img);
+
+    Texture2D t;
+    t.w = (int)img.hdr.pixelWidth;
+    t.h = (int)img.hdr.pixelHeight;
+    t.channels = 4;
+
+    glGenTextures(1, &t.id);
+    glBindTexture(GL_TEXTURE_2D, t.id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    for (std::uint32_t i = 0; i < (std::uint32_t)img.levels.size(); ++i) {
+        const ktx2::LevelIndex& lvl = img.levels[i];
+        const GLsizei lw = (GLsizei)std::max<std::uint32_t>(1, img.hdr.pixelWidth >> i);
+        const GLsizei lh = (GLsizei)std::max<std::uint32_t>(1, img.hdr.pixelHeight >> i);
+        const unsigned char* px = file.data + lvl.byteOffset;
+
+        if (img.compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, img.internalFormat, lw, lh, 0, (GLsizei)lvl.byteLength, px);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i, img.internalFormat, lw, lh, 0, GL_RGBA, GL_UNSIGNED_BYTE, px);
+        }
+        t.bytes += (std::size_t)lvl.byteLength;
+    }
+
+    // Cadeia de mips vem do ficheiro (sem glGenerateMipmap); MAX_LEVEL cobre cadeias incompletas.
+    const GLint levels = (GLint)img.levels.size();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    g_loadStats.ktx2Images++;
+    g_loadStats.loadMs += msSince(t0);
+    g_loadStats.vramBytes += t.bytes;
+    return t;
 }
 
 Texture2D Texture2D::loadFromFile(const std::string& path, bool flipY) {
+    namespace fs = std::filesystem;
+
+    // Versão pré-comprimida ao lado do original? Evita decode + glGenerateMipmap.
+    if (fs::path(path).extension() == ".ktx2") return loadKTX2(path, flipY);
+
+    const std::string ktxPath = fs::path(path).replace_extension(".ktx2").string();
+    if (AssetFS::exists(ktxPath)) {
+        try {
+            return loadKTX2(ktxPath, flipY);
+        } catch (const std::exception& e) {
+            std::cerr << "[Texture] " << e.what() << " (fallback: " << path << ")\n";
+        }
+    }
+
+    const auto t0 = Clock::now();
     Texture2D t;
 
+    AssetData bytes;
+    if (!AssetFS::read(path, bytes)) {
+        throw std::runtime_error("can't read image: " + path);
+    }
+
     stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
 
-    unsigned char* data = stbi_load(path.c_str(), &t.w, &t.h, &t.channels, 0);
+    unsigned char* data = stbi_load_from_memory(bytes.data, (int)bytes.size, &t.w, &t.h, &t.channels, 0);
     if (!data) {
         throw std::runtime_error("stbi_load failed: " + path);
     }
@@ -58,6 +267,13 @@ Texture2D Texture2D::loadFromFile(const std::string& path, bool flipY) {
     glBindTexture(GL_TEXTURE_2D, 0);
     stbi_image_free(data);
 
+    // RGB fica tipicamente RGBA8 na GPU; a cadeia de mips soma ~1/3.
+    const std::size_t base = (std::size_t)t.w * (std::size_t)t.h * (std::size_t)(t.channels == 3 ? 4 : t.channels);
+    t.bytes = base + base / 3;
+
+    g_loadStats.decodedImages++;
+    g_loadStats.loadMs += msSince(t0);
+    g_loadStats.vramBytes += t.bytes;
     return t;
 }
 
@@ -74,6 +290,9 @@ Texture2D Texture2D::loadFromRGBA(const unsigned char* rgba, int w, int h, bool
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
     if (generateMips) glGenerateMipmap(GL_TEXTURE_2D);
 
+    t.bytes = (std::size_t)w * (std::size_t)h * 4;
+    if (generateMips) t.bytes += t.bytes / 3;
+
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, generateMips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -83,4 +302,110 @@ Texture2D Texture2D::loadFromRGBA(const unsigned char* rgba, int w, int h, bool
     return t;
 }
 
+void TextureArray2D::destroy() {
+    if (id) glDeleteTextures(1, &id);
+    id = 0;
+    w = h = layers = 0;
+    bytes = 0;
+}
+
+TextureArray2D TextureArray2D::loadFromFiles(const std::vector<std::string>& paths, bool flipY) {
+    if (paths.empty()) throw std::runtime_error("texture array without layers");
+
+    const auto t0 = Clock::now();
+    TextureArray2D t;
+    t.layers = (int)paths.size();
+
+    // 1) KTX2 (mips pré-calculados, BC quando suportado): upload directo layer a layer.
+    std::vector<AssetData> files;
+    std::vector<Ktx2Image> imgs;
+    if (loadArrayLayersKtx2(paths, flipY, files, imgs)) {
+        const Ktx2Image& first = imgs[0];
+        const GLint levels = (GLint)first.levels.size();
+        t.w = (int)first.hdr.pixelWidth;
+        t.h = (int)first.hdr.pixelHeight;
+
+        glGenTextures(1, &t.id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, t.id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        for (GLint lv = 0; lv < levels; ++lv) {
+            const GLsizei lw = (GLsizei)std::max(1, t.w >> lv);
+            const GLsizei lh = (GLsizei)std::max(1, t.h >> lv);
+            const GLsizei levelBytes = (GLsizei)first.levels[(size_t)lv].byteLength;
+
+            if (first.compressed) {
+                glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, lv, first.internalFormat, lw, lh, t.layers, 0,
+                                       levelBytes * t.layers, nullptr);
+            } else {
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, lv, first.internalFormat, lw, lh, t.layers, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+
+            for (int layer = 0; layer < t.layers; ++layer) {
+                const unsigned char* px = files[(size_t)layer].data + imgs[(size_t)layer].levels[(size_t)lv].byteOffset;
+                if (first.compressed) {
+                    glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, lv, 0, 0, layer, lw, lh, 1,
+                                              first.internalFormat, levelBytes, px);
+                } else {
+                    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, lv, 0, 0, layer, lw, lh, 1, GL_RGBA, GL_UNSIGNED_BYTE, px);
+                }
+            }
+            t.bytes += (std::size_t)levelBytes * (std::size_t)t.layers;
+        }
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        g_loadStats.ktx2Images += t.layers;
+    } else {
+        // 2) Decode das imagens (RGBA8) + glGenerateMipmap no array inteiro.
+        stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
+
+        for (int layer = 0; layer < t.layers; ++layer) {
+            const std::string& path = paths[(size_t)layer];
+            AssetData bytes;
+            if (!AssetFS::read(path, bytes)) {
+                t.destroy();
+                throw std::runtime_error("can't read image: " + path);
+            }
+
+            int w = 0, h = 0, comp = 0;
+            unsigned char* data = stbi_load_from_memory(bytes.data, (int)bytes.size, &w, &h, &comp, 4);
+            if (!data || (layer > 0 && (w != t.w || h != t.h))) {
+                if (data) stbi_image_free(data);
+                t.destroy();
+                throw std::runtime_error("texture array layer invalid or size mismatch: " + path);
+            }
+
+            if (layer == 0) {
+                t.w = w;
+                t.h = h;
+                glGenTextures(1, &t.id);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, t.id);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, w, h, t.layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+            stbi_image_free(data);
+        }
+
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+        const std::size_t base = (std::size_t)t.w * (std::size_t)t.h * 4 * (std::size_t)t.layers;
+        t.bytes = base + base / 3;
+        g_loadStats.decodedImages += t.layers;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    g_loadStats.loadMs += msSince(t0);
+    g_loadStats.vramBytes += t.bytes;
+    return t;
+}
+
 } // namespace engine
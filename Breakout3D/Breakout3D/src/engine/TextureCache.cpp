@@ -0,0 +1,104 @@
+// TextureCache.cpp
+// -----------------------------------------------------------------------------
+// TextureCache.cpp
+//
+// Responsabilidade:
+//  - Garantir que cada imagem do disco é decodificada e enviada para a GPU uma única vez.
+//  - Partilhar o mesmo id OpenGL entre vários donos (meshes) com contagem de referências.
+//  - Manter a contabilidade da memória de texturas residente.
+//
+// Notas:
+//  - A chave é o path canónico (weakly_canonical), por isso "a/../b.png" e "b.png" coincidem.
+//  - A chave inclui o flipY: a mesma imagem com orientações diferentes são texturas distintas.
+//  - Não é thread-safe: só é usada na thread que tem o contexto GL.
+// -----------------------------------------------------------------------------
+
+#include "engine/TextureCache.hpp"
+#include "engine/Texture.hpp"
+
+#include <filesystem>
+#include <system_error>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace engine {
+
+namespace {
+
+struct CacheEntry {
+    GLuint id = 0;
+    int refs = 0;
+    std::size_t bytes = 0;
+};
+
+std::unordered_map<std::string, CacheEntry> g_entries; // key -> entry
+std::unordered_map<GLuint, std::string> g_keyById;     // id -> key (para release)
+std::size_t g_residentBytes = 0;
+
+std::string canonicalKey(const std::string& path, bool flipY) {
+    std::error_code ec;
+    fs::path p = fs::weakly_canonical(fs::absolute(fs::path(path), ec), ec);
+    if (ec) p = fs::path(path).lexically_normal();
+    return p.generic_string() + (flipY ? "|flip" : "|noflip");
+}
+
+} // namespace
+
+GLuint TextureCache::acquire(const std::string& path, bool flipY) {
+    const std::string key = canonicalKey(path, flipY);
+
+    auto it = g_entries.find(key);
+    if (it != g_entries.end()) {
+        it->second.refs++;
+        return it->second.id;
+    }
+
+    // Primeiro pedido: decode + upload (pode lançar; nesse caso nada fica registado).
+    Texture2D t = Texture2D::loadFromFile(path, flipY);
+
+    CacheEntry e;
+    e.id = t.id;
+    e.refs = 1;
+    e.bytes = t.bytes;
+
+    g_entries.emplace(key, e);
+    g_keyById[e.id] = key;
+    g_residentBytes += e.bytes;
+    return e.id;
+}
+
+void TextureCache::retain(GLuint id) {
+    if (!id) return;
+    auto k = g_keyById.find(id);
+    if (k == g_keyById.end()) return;
+    g_entries[k->second].refs++;
+}
+
+void TextureCache::release(GLuint id) {
+    if (!id) return;
+    auto k = g_keyById.find(id);
+    if (k == g_keyById.end()) return;
+
+    auto it = g_entries.find(k->second);
+    if (it == g_entries.end()) return;
+
+    if (--it->second.refs > 0) return;
+
+    // Último dono: liberta a textura e a contabilidade.
+    GLuint tex = it->second.id;
+    glDeleteTextures(1, &tex);
+    g_residentBytes -= it->second.bytes;
+    g_entries.erase(it);
+    g_keyById.erase(k);
+}
+
+std::size_t TextureCache::entryCount() {
+    return g_entries.size();
+}
+
+std::size_t TextureCache::residentBytes() {
+    return g_residentBytes;
+}
+
+} // namespace engine
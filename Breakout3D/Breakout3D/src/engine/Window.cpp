@@ -4,11 +4,11 @@
  *
  * @details
  *  - Cria a janela (windowed ou fullscreen) e inicializa GLFW/GLEW.
- *  - Configura callbacks (scroll) e expõe helpers para polling, swap e sizes.
+ *  - Configura callbacks (scroll, resize do framebuffer) e expõe helpers para polling, swap e sizes.
  *  - Acumula scrollY para consumo pelo Input (via consumeScrollY()).
  *
  * @note
- *  - V-Sync está desligado por default (glfwSwapInterval(0)).
+ *  - V-Sync está desligado por default (glfwSwapInterval(0)); o cap de FPS/idle é do FramePacer.
  *  - destroy() também chama glfwTerminate().
  */
 
@@ -26,6 +26,12 @@
      self->addScrollY((float)yoff);
  }
  
+ static void glfwFramebufferSizeCb(GLFWwindow* w, int width, int height) {
+     auto* self = (Window*)glfwGetWindowUserPointer(w);
+     if (!self) return;
+     self->setFramebufferSize(width, height);
+ }
+ 
  Window::Window() {}
  Window::~Window() { destroy(); }
  
@@ -55,6 +61,11 @@
      // Callbacks (scroll, etc.)
      glfwSetWindowUserPointer(w, this);
      glfwSetScrollCallback(w, glfwScrollCb);
+     glfwSetFramebufferSizeCallback(w, glfwFramebufferSizeCb);
+ 
+     int fw = 1, fh = 1;
+     glfwGetFramebufferSize(w, &fw, &fh);
+     setFramebufferSize(fw, fh);
  
      glewExperimental = GL_TRUE;
      GLenum err = glewInit();
@@ -69,6 +80,22 @@
  
  void Window::pollEvents() { glfwPollEvents(); }
  
+ void Window::waitEvents(double timeoutSec) {
+     if (timeoutSec > 0.0) glfwWaitEventsTimeout(timeoutSec);
+     else glfwPollEvents();
+ }
+ 
+ bool Window::isIconified() const {
+     GLFWwindow* w = (GLFWwindow*)m_window;
+     return w && glfwGetWindowAttrib(w, GLFW_ICONIFIED) != 0;
+ }
+ 
+ int Window::refreshRate() const {
+     GLFWmonitor* mon = glfwGetPrimaryMonitor();
+     const GLFWvidmode* mode = mon ? glfwGetVideoMode(mon) : nullptr;
+     return mode ? mode->refreshRate : 0;
+ }
+ 
  bool Window::shouldClose() const {
      GLFWwindow* w = (GLFWwindow*)m_window;
      return glfwWindowShouldClose(w);
@@ -94,10 +121,13 @@
  }
  
  std::pair<int,int> Window::getFramebufferSize() const {
-     GLFWwindow* w = (GLFWwindow*)m_window;
-     int fw = 1, fh = 1;
-     glfwGetFramebufferSize(w, &fw, &fh);
-     return {fw, fh};
+     // Cache (callback): o GLFW só permite glfwGetFramebufferSize no thread principal.
+     return {m_fbW.load(std::memory_order_relaxed), m_fbH.load(std::memory_order_relaxed)};
+ }
+ 
+ void Window::setFramebufferSize(int w, int h) {
+     m_fbW.store(w, std::memory_order_relaxed);
+     m_fbH.store(h, std::memory_order_relaxed);
  }
  
  std::pair<int,int> Window::getWindowSize() const {
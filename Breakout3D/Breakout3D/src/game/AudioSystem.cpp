@@ -7,7 +7,7 @@
  * -----------
  * Este módulo faz 4 coisas principais:
  *  1) Inicializa o backend de áudio (com foco em WSL/WSLg + PulseAudio).
- *  2) Descobre ficheiros .wav em assets/audio e cria “grupos” por ID (random variants).
+ *  2) Descobre ficheiros .wav em assets/audio (pack .b3dpak ou disco) e cria “grupos” por ID (random variants).
  *  3) Reproduz:
  *      - SFX one-shot (pool de voices)
  *      - SFX loops persistentes com fade in/out (map)
@@ -33,6 +33,9 @@
  *      Ex: assets/audio/stingers_music/stinger_game_over.wav -> id "stinger_game_over"
  *
  * Notas importantes:
+ *  - Com o pack montado (engine::AssetFS), os .wav são registados no resource manager do miniaudio
+ *    a apontar para o mmap (sem cópia); o resto do código continua a usar os mesmos paths.
+ *    Dados registados não suportam MA_SOUND_FLAG_STREAM, por isso música/loops tocam do buffer em memória.
  *  - Os stingers são one-shot (não são “SFX”, mas são reproduzidos com o mesmo mecanismo de voice pool).
  *  - Os loops de SFX são “persistentes” e geridos por ID (para ligar/desligar sem spam).
  *
@@ -43,6 +46,7 @@
  * Em Linux normal: PulseAudio -> ALSA -> Null.
  */
  #include "game/AudioSystem.hpp"
+ #include "engine/AssetFS.hpp"
 
  #include <algorithm>
  #include <cmath>
@@ -121,6 +125,13 @@
      float lastMusicGain = 1.0f;
      float lastSfxGain = 1.0f;
      float lastStingerGain = 1.0f;
+
+     // Modo pack: paths registados no resource manager (apontam para o mmap do AssetFS)
+     bool packed = false;
+     std::vector<std::string> registered;
+
+     // Streaming só faz sentido para ficheiros soltos (ver notas no topo).
+     ma_uint32 streamFlag() const { return packed ? 0u : (ma_uint32)MA_SOUND_FLAG_STREAM; }
  };
  
  static fs::path executableDir() {
@@ -243,8 +254,14 @@
      candidates.push_back(executableDir() / rootCandidate);
      candidates.push_back(executableDir() / "assets/audio");
  
+     // Pack montado com áudio? Nesse caso não há scan de disco.
+     const std::string packRoot = normalizeSlashes(audioRoot);
+     std::vector<std::string> packedFiles = engine::AssetFS::listPacked(packRoot);
+
      fs::path chosen;
+     if (!packedFiles.empty()) chosen = fs::path(packRoot);
      for (const auto& c : candidates) {
+         if (!chosen.empty()) break;
          std::error_code ec;
          if (fs::exists(c, ec) && fs::is_directory(c, ec)) {
              chosen = c;
@@ -307,6 +324,23 @@
  
      // Pool de one-shots: muitos porque brick breaks e UI podem ser densos.
      m_impl->voices.resize(96);
+
+     // Modo pack: regista os .wav (encoded) com o mesmo path lógico usado nos grupos.
+     if (!packedFiles.empty()) {
+         m_impl->packed = true;
+         ma_resource_manager* rm = ma_engine_get_resource_manager(&m_impl->engine);
+         for (const auto& path : packedFiles) {
+             std::string ext = fs::path(path).extension().string();
+             std::transform(ext.begin(), ext.end(), ext.begin(),
+                            [](unsigned char c){ return (char)std::tolower(c); });
+             if (ext != ".wav") continue;
+             engine::AssetData d;
+             if (!engine::AssetFS::read(path, d) || !d.owned.empty()) continue; // só zero-copy
+             if (ma_resource_manager_register_encoded_data(rm, path.c_str(), d.data, d.size) == MA_SUCCESS) {
+                 m_impl->registered.push_back(path);
+             }
+         }
+     }
  
      // Helpers de scan
      auto addFileToGroups = [&](std::unordered_map<std::string, FileList>& groups,
@@ -316,6 +350,13 @@
      };
  
      auto scanDir = [&](const fs::path& dir, auto&& onFile) {
+         if (m_impl->packed) {
+             const std::string prefix = normalizeSlashes(dir.string()) + "/";
+             for (const auto& path : m_impl->registered) {
+                 if (path.compare(0, prefix.size(), prefix) == 0) onFile(fs::path(path));
+             }
+             return;
+         }
          if (!fs::exists(dir)) return;
          for (auto const& entry : fs::recursive_directory_iterator(dir)) {
              if (!entry.is_regular_file()) continue;
@@ -332,7 +373,7 @@
      {
          fs::path sfxRoot = fs::path(m_root) / "sfx";
          scanDir(sfxRoot, [&](const fs::path& p) {
-             fs::path rel = fs::relative(p, sfxRoot);
+             fs::path rel = p.lexically_relative(sfxRoot);
              std::string relNoExt = normalizeSlashes(rel.replace_extension("").string());
  
              fs::path relPath(relNoExt);
@@ -417,6 +458,12 @@
      if (m_impl->musicBValid) { ma_sound_stop(&m_impl->musicB); ma_sound_uninit(&m_impl->musicB); }
      m_impl->musicAValid = m_impl->musicBValid = false;
  
+     // Dados registados (pack) têm de sair do resource manager antes do engine.
+     for (const auto& path : m_impl->registered) {
+         ma_resource_manager_unregister_data(ma_engine_get_resource_manager(&m_impl->engine), path.c_str());
+     }
+     m_impl->registered.clear();
+
      ma_engine_uninit(&m_impl->engine);
      if (m_impl->contextValid) ma_context_uninit(&m_impl->context);
      delete m_impl;
@@ -516,7 +563,7 @@
  
     // Carrega o novo loop (streaming para música reduz memória e latência)
     ma_result r = ma_sound_init_from_file(&m_impl->engine, filePath.c_str(), 
-                                          MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC, 
+                                          m_impl->streamFlag() | MA_SOUND_FLAG_ASYNC, 
                                           nullptr, nullptr, newS);
      if (r != MA_SUCCESS) return;
  
@@ -617,7 +664,7 @@
      if (!L.valid) {
          if (!enabled) return; // não criar loop só para desligar
          ma_result r = ma_sound_init_from_file(&m_impl->engine, filePath.c_str(), 
-                                              MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC, 
+                                              m_impl->streamFlag() | MA_SOUND_FLAG_ASYNC, 
                                               nullptr, nullptr, &L.sound);
          if (r != MA_SUCCESS) return;
          L.valid = true;
@@ -0,0 +1,261 @@
+// BallSet.cpp
+/**
+ * @file BallSet.cpp
+ * @brief Armazenamento SoA das bolas + kernel de voo livre (escalar/SSE2).
+ *
+ * Notas:
+ *  - Kernel sem branches por bola: nova posição = pos + vel*dt; as paredes são espelhos
+ *    (x' = 2*plano - x, inverte a componente da velocidade), o mesmo que o CCD faz num contacto
+ *    com uma parede. Só é válido com um bounce por eixo, daí o `maxStep`.
+ *  - Uma bola livre vai para a lista lenta se o segmento (mais o raio) entra na faixa dos bricks
+ *    (Z <= maxZ do brick mais fundo, O(1) via FieldStats) ou do paddle/shield, ou se anda mais
+ *    que `maxStep`. Essas bolas não são tocadas aqui.
+ *  - SSE2: 4 bolas por iteração; as máscaras de lane vêm das flags (livre = Alive sem Attached)
+ *    e os índices lentos saem do movemask. AVX2 não compensa aqui (o kernel é limitado pela
+ *    memória: 10 floats lidos/escritos por bola), por isso `AVX2` usa o caminho SSE2.
+ */
+#include "game/BallSet.hpp"
+#include "game/Snapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#define B3D_BALL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace game {
+
+static int roundUp4(int n) { return (n + 3) & ~3; }
+
+void BallSet::reserveSlots(int n) {
+    const std::size_t cap = (std::size_t)roundUp4(n);
+    if (cap <= m_flags.size()) return;
+    const std::size_t grow = std::max(cap, m_flags.size() * 2);
+    for (auto* v : { &m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_qx, &m_qy, &m_qz }) v->resize(grow, 0.0f);
+    m_flags.resize(grow, 0);
+}
+
+void BallSet::clear() {
+    std::fill(m_flags.begin(), m_flags.begin() + m_count, (std::uint8_t)0);
+    m_count = 0;
+}
+
+int BallSet::add(const Ball& b) {
+    reserveSlots(m_count + 1);
+    const int i = m_count++;
+    set(i, b);
+    return i;
+}
+
+Ball BallSet::get(int i) const {
+    Ball b;
+    b.pos = pos(i);
+    b.vel = vel(i);
+    b.prevPos = prevPos(i);
+    const std::uint8_t f = m_flags[(std::size_t)i];
+    b.alive = (f & Alive) != 0;
+    b.attached = (f & Attached) != 0;
+    b.isFireball = (f & Fireball) != 0;
+    b.hasPrev = (f & HasPrev) != 0;
+    return b;
+}
+
+void BallSet::set(int i, const Ball& b) {
+    const std::size_t k = (std::size_t)i;
+    m_px[k] = b.pos.x;     m_py[k] = b.pos.y;     m_pz[k] = b.pos.z;
+    m_vx[k] = b.vel.x;     m_vy[k] = b.vel.y;     m_vz[k] = b.vel.z;
+    m_qx[k] = b.prevPos.x; m_qy[k] = b.prevPos.y; m_qz[k] = b.prevPos.z;
+    m_flags[k] = (std::uint8_t)((b.alive ? Alive : 0) | (b.attached ? Attached : 0) |
+                                (b.isFireball ? Fireball : 0) | (b.hasPrev ? HasPrev : 0));
+}
+
+void BallSet::removeAt(int i) {
+    const std::size_t k = (std::size_t)i, last = (std::size_t)(m_count - 1);
+    if (k != last) {
+        for (auto* v : { &m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_qx, &m_qy, &m_qz }) (*v)[k] = (*v)[last];
+        m_flags[k] = m_flags[last];
+    }
+    m_flags[last] = 0; // padding continua com flags a 0
+    m_count--;
+}
+
+void BallSet::save(SnapshotWriter& w) const {
+    const std::size_t n = (std::size_t)roundUp4(m_count);
+    w.pod(m_count);
+    for (const auto* v : { &m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_qx, &m_qy, &m_qz }) w.bytes(v->data(), n * sizeof(float));
+    w.bytes(m_flags.data(), n);
+}
+
+bool BallSet::load(SnapshotReader& r) {
+    int count = 0;
+    if (!r.pod(count) || count < 0) return false;
+    clear(); // flags a 0 nos slots de agora que o snapshot não cobre
+    reserveSlots(count);
+    const std::size_t n = (std::size_t)roundUp4(count);
+    for (auto* v : { &m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_qx, &m_qy, &m_qz }) r.bytes(v->data(), n * sizeof(float));
+    r.bytes(m_flags.data(), n);
+    if (!r.ok()) {
+        std::fill(m_flags.begin(), m_flags.end(), (std::uint8_t)0);
+        return false;
+    }
+    m_count = count;
+    return true;
+}
+
+int BallSet::removeDead() {
+    int removed = 0;
+    for (int i = 0; i < m_count; ) {
+        if (!alive(i)) { removeAt(i); removed++; }
+        else i++;
+    }
+    return removed;
+}
+
+int BallSet::attachedCount() const {
+    int n = 0;
+    for (int i = 0; i < m_count; ++i) n += (m_flags[(std::size_t)i] & Attached) ? 1 : 0;
+    return n;
+}
+
+void BallSet::storePrevious() {
+    std::memcpy(m_qx.data(), m_px.data(), (std::size_t)m_count * sizeof(float));
+    std::memcpy(m_qy.data(), m_py.data(), (std::size_t)m_count * sizeof(float));
+    std::memcpy(m_qz.data(), m_pz.data(), (std::size_t)m_count * sizeof(float));
+    for (int i = 0; i < m_count; ++i) m_flags[(std::size_t)i] |= HasPrev;
+}
+
+void BallSet::applyWindX(float dvxAll, const float* dvx) {
+    for (int i = 0; i < m_count; ++i) {
+        const std::size_t k = (std::size_t)i;
+        const bool freeBall = (m_flags[k] & (Alive | Attached)) == Alive;
+        const float vx = m_vx[k], vz = m_vz[k];
+        const float sp = std::sqrt(vx * vx + vz * vz);
+        const float nx = vx + (freeBall ? (dvx ? dvx[k] : dvxAll) : 0.0f);
+        const float sp2 = std::sqrt(nx * nx + vz * vz);
+        // renormaliza para manter a magnitude (não acelerar/desacelerar por acidente)
+        const float s = (sp > 1e-4f && sp2 > 1e-4f) ? sp / sp2 : 1.0f;
+        m_vx[k] = nx * s;
+        m_vz[k] = vz * s;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Kernel de voo livre
+// ---------------------------------------------------------------------------
+namespace {
+
+struct Lanes {
+    float* px; float* pz; float* vx; float* vz;
+    const std::uint8_t* flags;
+    int count;
+};
+
+int advanceScalar(const Lanes& L, float dt, const BallSet::FreeBounds& fb, std::vector<int>& slow) {
+    const float r = fb.radius;
+    const float lo = fb.minX + r, hi = fb.maxX - r, top = fb.minZ + r;
+    int walls = 0;
+    for (int i = 0; i < L.count; ++i) {
+        if ((L.flags[i] & (BallSet::Alive | BallSet::Attached)) != BallSet::Alive) continue;
+        const float dx = L.vx[i] * dt, dz = L.vz[i] * dt;
+        const float nx = L.px[i] + dx, nz = L.pz[i] + dz;
+        const float zLo = std::min(L.pz[i], nz) - r, zHi = std::max(L.pz[i], nz) + r;
+        if (zLo <= fb.brickZoneMaxZ || zHi >= fb.paddleZoneMinZ ||
+            std::abs(dx) > fb.maxStep || std::abs(dz) > fb.maxStep) {
+            slow.push_back(i);
+            continue;
+        }
+        const float under = std::min(nx - lo, 0.0f), over = std::max(nx - hi, 0.0f), underZ = std::min(nz - top, 0.0f);
+        const bool hitX = (under < 0.0f) | (over > 0.0f), hitZ = underZ < 0.0f;
+        L.px[i] = nx - 2.0f * (under + over);
+        L.pz[i] = nz - 2.0f * underZ;
+        L.vx[i] = hitX ? -L.vx[i] : L.vx[i];
+        L.vz[i] = hitZ ? -L.vz[i] : L.vz[i];
+        walls += (int)hitX + (int)hitZ;
+    }
+    return walls;
+}
+
+#if B3D_BALL_SSE2
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+int advanceSse2(const Lanes& L, float dt, const BallSet::FreeBounds& fb, std::vector<int>& slow) {
+    const float r = fb.radius;
+    const __m128 vdt = _mm_set1_ps(dt), vr = _mm_set1_ps(r), two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+    const __m128 lo = _mm_set1_ps(fb.minX + r), hi = _mm_set1_ps(fb.maxX - r), top = _mm_set1_ps(fb.minZ + r);
+    const __m128 brickZ = _mm_set1_ps(fb.brickZoneMaxZ), paddleZ = _mm_set1_ps(fb.paddleZoneMinZ);
+    const __m128 maxStep = _mm_set1_ps(fb.maxStep);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    const __m128i flagMask = _mm_set1_epi32(BallSet::Alive | BallSet::Attached);
+    const __m128i freeVal = _mm_set1_epi32(BallSet::Alive);
+    const __m128i zi = _mm_setzero_si128();
+
+    int walls = 0;
+    for (int i = 0; i < L.count; i += 4) {
+        // flags (4 bytes) -> 4 lanes de 32 bits
+        std::int32_t f4;
+        std::memcpy(&f4, L.flags + i, 4);
+        __m128i f = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(f4), zi), zi);
+        __m128 freeM = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(f, flagMask), freeVal));
+        if (!_mm_movemask_ps(freeM)) continue;
+
+        __m128 px = _mm_loadu_ps(L.px + i), pz = _mm_loadu_ps(L.pz + i);
+        __m128 vx = _mm_loadu_ps(L.vx + i), vz = _mm_loadu_ps(L.vz + i);
+        __m128 dx = _mm_mul_ps(vx, vdt), dz = _mm_mul_ps(vz, vdt);
+        __m128 nx = _mm_add_ps(px, dx), nz = _mm_add_ps(pz, dz);
+
+        __m128 zLo = _mm_sub_ps(_mm_min_ps(pz, nz), vr), zHi = _mm_add_ps(_mm_max_ps(pz, nz), vr);
+        __m128 slowM = _mm_or_ps(_mm_cmple_ps(zLo, brickZ), _mm_cmpge_ps(zHi, paddleZ));
+        slowM = _mm_or_ps(slowM, _mm_cmpgt_ps(_mm_and_ps(dx, absMask), maxStep));
+        slowM = _mm_or_ps(slowM, _mm_cmpgt_ps(_mm_and_ps(dz, absMask), maxStep));
+        slowM = _mm_and_ps(slowM, freeM);
+        __m128 fastM = _mm_andnot_ps(slowM, freeM);
+
+        int sm = _mm_movemask_ps(slowM);
+        while (sm) {
+            slow.push_back(i + __builtin_ctz((unsigned)sm));
+            sm &= sm - 1;
+        }
+        if (!_mm_movemask_ps(fastM)) continue;
+
+        __m128 under = _mm_min_ps(_mm_sub_ps(nx, lo), zero);
+        __m128 over = _mm_max_ps(_mm_sub_ps(nx, hi), zero);
+        __m128 underZ = _mm_min_ps(_mm_sub_ps(nz, top), zero);
+        __m128 hitX = _mm_and_ps(_mm_or_ps(_mm_cmplt_ps(under, zero), _mm_cmpgt_ps(over, zero)), fastM);
+        __m128 hitZ = _mm_and_ps(_mm_cmplt_ps(underZ, zero), fastM);
+
+        nx = _mm_sub_ps(nx, _mm_mul_ps(two, _mm_add_ps(under, over)));
+        nz = _mm_sub_ps(nz, _mm_mul_ps(two, underZ));
+        _mm_storeu_ps(L.px + i, select4(fastM, nx, px));
+        _mm_storeu_ps(L.pz + i, select4(fastM, nz, pz));
+        _mm_storeu_ps(L.vx + i, _mm_xor_ps(vx, _mm_and_ps(hitX, signMask)));
+        _mm_storeu_ps(L.vz + i, _mm_xor_ps(vz, _mm_and_ps(hitZ, signMask)));
+
+        walls += __builtin_popcount((unsigned)_mm_movemask_ps(hitX)) + __builtin_popcount((unsigned)_mm_movemask_ps(hitZ));
+    }
+    return walls;
+}
+#endif
+
+} // namespace
+
+int BallSet::advanceFree(float dt, const FreeBounds& fb, std::vector<int>& slow, SimdLevel level) {
+    slow.clear();
+    Lanes L{ m_px.data(), m_pz.data(), m_vx.data(), m_vz.data(), m_flags.data(), m_count };
+
+    if (level == SimdLevel::Auto) level = BrickField::detectedSimd();
+#if B3D_BALL_SSE2
+    if (level != SimdLevel::Scalar) {
+        L.count = roundUp4(m_count); // padding com flags 0
+        return advanceSse2(L, dt, fb, slow);
+    }
+#endif
+    return advanceScalar(L, dt, fb, slow);
+}
+
+} // namespace game
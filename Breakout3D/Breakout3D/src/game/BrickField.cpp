@@ -0,0 +1,552 @@
+// BrickField.cpp
+/**
+ * @file BrickField.cpp
+ * @brief Armazenamento SoA dos bricks + filtros em lote (escalar/SSE2/AVX2) para o CCD e a AoE.
+ *
+ * Notas:
+ *  - AVX2 é compilado com `__attribute__((target("avx2")))` e escolhido em runtime por
+ *    `__builtin_cpu_supports`, por isso o Makefile não precisa de `-mavx2`.
+ *  - Os bits alive fazem de máscara de lanes: slots mortos e padding nunca contam.
+ *  - CCD (`sweptCandidates`): filtra no sítio os candidatos da grelha pelo AABB expandido
+ *    (slabs em [0, 1]); o teste exacto fica no CollisionSystem, só para os que sobram.
+ *  - AoE (`queryCircle`): o scan de centros tem os mesmos níveis e escreve os hits num buffer
+ *    com espaço para todos os vivos (sem `push_back` por hit).
+ *  - Reciclagem: `kill` incrementa a geração e empilha o slot; `add` reutiliza o do topo.
+ *    A grelha aceita o mesmo índice de novo porque `remove` limpou o span.
+ *  - Z local + scroll: os kernels recebem `cz - scroll` (a query vai para o espaço local, os
+ *    bricks não mexem). A grelha continua em coordenadas do mundo.
+ *  - Numa run muito longa o scroll cresce sem limite; acima de `kRebaseZ` é dobrado para os
+ *    Z locais (O(vivos), ~1x por hora de Endless) para não perder precisão em float.
+ */
+#include "game/BrickField.hpp"
+#include "game/Snapshot.hpp"
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#define B3D_BRICK_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define B3D_BRICK_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace game {
+
+static int roundUp8(int n) { return (n + 7) & ~7; }
+
+static constexpr int kMinSimdList = 4;
+static constexpr float kSweptSlack = 0.01f;
+static constexpr float kRebaseZ = 1024.0f;
+
+// ---------------------------------------------------------------------------
+// Caminhos em lote (funções livres para o atributo target do AVX2)
+// ---------------------------------------------------------------------------
+namespace {
+
+using Hot = BrickField::HotArrays;
+
+inline bool aliveBit(const Hot& h, int i) {
+    return (h.alive[(std::size_t)i >> 6] >> (i & 63)) & 1u;
+}
+
+// CCD: segmento o -> o + v contra o AABB expandido por `rr` (= raio + folga), teste de slabs
+// em [0, 1]. Eixos com |v| ~ 0 só testam se a origem está dentro da faixa (sem divisões por 0).
+struct SweptQuery {
+    float ox, oz;     // origem (Z local)
+    float invX, invZ; // 1/v (0 nos eixos parados)
+    bool staticX, staticZ;
+    float rr;
+};
+
+SweptQuery makeSweptQuery(float ox, float oz, float vx, float vz, float rr) {
+    SweptQuery q;
+    q.ox = ox;
+    q.oz = oz;
+    q.staticX = std::abs(vx) < 1e-12f;
+    q.staticZ = std::abs(vz) < 1e-12f;
+    q.invX = q.staticX ? 0.0f : 1.0f / vx;
+    q.invZ = q.staticZ ? 0.0f : 1.0f / vz;
+    q.rr = rr;
+    return q;
+}
+
+inline bool sweptBox(const SweptQuery& q, float minX, float maxX, float minZ, float maxZ) {
+    float tEnter = 0.0f, tExit = 1.0f;
+    float lo = minX - q.rr, hi = maxX + q.rr;
+    if (q.staticX) {
+        if (q.ox < lo || q.ox > hi) return false;
+    } else {
+        float t0 = (lo - q.ox) * q.invX, t1 = (hi - q.ox) * q.invX;
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+    }
+    lo = minZ - q.rr;
+    hi = maxZ + q.rr;
+    if (q.staticZ) {
+        if (q.oz < lo || q.oz > hi) return false;
+    } else {
+        float t0 = (lo - q.oz) * q.invZ, t1 = (hi - q.oz) * q.invZ;
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+    }
+    return tEnter <= tExit;
+}
+
+// Compactam `idx` no sítio (mesma ordem) e devolvem quantos ficaram.
+int sweptScalar(const Hot& h, const SweptQuery& q, int* idx, int n) {
+    int w = 0;
+    for (int k = 0; k < n; ++k) {
+        int i = idx[k];
+        if (aliveBit(h, i) && sweptBox(q, h.minX[i], h.maxX[i], h.minZ[i], h.maxZ[i])) idx[w++] = i;
+    }
+    return w;
+}
+
+// AoE: acrescenta os slots vivos com o centro dentro do círculo, por ordem de slot. O centro é
+// calculado como em `BrickField::center` (Z local + scroll), para dar o mesmo resultado em todos os níveis.
+// Escrevem em `out` (espaço para todos os vivos) e devolvem o fim.
+int* centersScalar(const Hot& h, float cx, float cz, float scroll, float r2, int* out) {
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        while (bits) {
+            int i = w * 64 + __builtin_ctzll(bits);
+            float dx = (h.minX[i] + h.maxX[i]) * 0.5f - cx;
+            float dz = ((h.minZ[i] + h.maxZ[i]) * 0.5f + scroll) - cz;
+            if (dx * dx + dz * dz <= r2) *out++ = i;
+            bits &= bits - 1;
+        }
+    }
+    return out;
+}
+
+inline int* pushLanes(int base, int m, int* out) {
+    while (m) {
+        *out++ = base + __builtin_ctz((unsigned)m);
+        m &= m - 1;
+    }
+    return out;
+}
+
+#if B3D_BRICK_SSE2
+// 4 lanes: máscara (bit k = o segmento atravessa o AABB expandido da lane k).
+inline int sweptMask4(const SweptQuery& q, __m128 mnx, __m128 mxx, __m128 mnz, __m128 mxz) {
+    const __m128 rr = _mm_set1_ps(q.rr);
+    __m128 tEnter = _mm_setzero_ps(), tExit = _mm_set1_ps(1.0f);
+    __m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    __m128 lo = _mm_sub_ps(mnx, rr), hi = _mm_add_ps(mxx, rr), o = _mm_set1_ps(q.ox);
+    if (q.staticX) {
+        in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(o, lo), _mm_cmple_ps(o, hi)));
+    } else {
+        const __m128 inv = _mm_set1_ps(q.invX);
+        __m128 t0 = _mm_mul_ps(_mm_sub_ps(lo, o), inv), t1 = _mm_mul_ps(_mm_sub_ps(hi, o), inv);
+        tEnter = _mm_max_ps(tEnter, _mm_min_ps(t0, t1));
+        tExit = _mm_min_ps(tExit, _mm_max_ps(t0, t1));
+    }
+    lo = _mm_sub_ps(mnz, rr);
+    hi = _mm_add_ps(mxz, rr);
+    o = _mm_set1_ps(q.oz);
+    if (q.staticZ) {
+        in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(o, lo), _mm_cmple_ps(o, hi)));
+    } else {
+        const __m128 inv = _mm_set1_ps(q.invZ);
+        __m128 t0 = _mm_mul_ps(_mm_sub_ps(lo, o), inv), t1 = _mm_mul_ps(_mm_sub_ps(hi, o), inv);
+        tEnter = _mm_max_ps(tEnter, _mm_min_ps(t0, t1));
+        tExit = _mm_min_ps(tExit, _mm_max_ps(t0, t1));
+    }
+    return _mm_movemask_ps(_mm_and_ps(in, _mm_cmple_ps(tEnter, tExit)));
+}
+
+int sweptSse2(const Hot& h, const SweptQuery& q, int* idx, int n) {
+    int w = 0;
+    for (int k = 0; k < n; k += 4) {
+        int lane[4];
+        int live = 0;
+        for (int j = 0; j < 4; ++j) {
+            lane[j] = (k + j < n) ? idx[k + j] : idx[k];
+            if (k + j < n && aliveBit(h, lane[j])) live |= 1 << j;
+        }
+        if (!live) continue;
+        int m = sweptMask4(q, _mm_setr_ps(h.minX[lane[0]], h.minX[lane[1]], h.minX[lane[2]], h.minX[lane[3]]),
+                           _mm_setr_ps(h.maxX[lane[0]], h.maxX[lane[1]], h.maxX[lane[2]], h.maxX[lane[3]]),
+                           _mm_setr_ps(h.minZ[lane[0]], h.minZ[lane[1]], h.minZ[lane[2]], h.minZ[lane[3]]),
+                           _mm_setr_ps(h.maxZ[lane[0]], h.maxZ[lane[1]], h.maxZ[lane[2]], h.maxZ[lane[3]])) & live;
+        for (; m; m &= m - 1) idx[w++] = lane[__builtin_ctz((unsigned)m)];
+    }
+    return w;
+}
+
+int* centersSse2(const Hot& h, float cx, float cz, float scroll, float r2, int* out) {
+    const __m128 half = _mm_set1_ps(0.5f), vcx = _mm_set1_ps(cx), vcz = _mm_set1_ps(cz);
+    const __m128 vscroll = _mm_set1_ps(scroll), vr2 = _mm_set1_ps(r2);
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        for (int k = 0; bits != 0; ++k, bits >>= 4) {
+            int live = (int)(bits & 0xFu);
+            if (!live) continue;
+            int i = w * 64 + k * 4;
+            __m128 dx = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(h.minX + i), _mm_loadu_ps(h.maxX + i)), half), vcx);
+            __m128 dz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(h.minZ + i), _mm_loadu_ps(h.maxZ + i)), half),
+                                              vscroll), vcz);
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+            out = pushLanes(i, _mm_movemask_ps(_mm_cmple_ps(d2, vr2)) & live, out);
+        }
+    }
+    return out;
+}
+#endif
+
+#if B3D_BRICK_AVX2
+__attribute__((target("avx2")))
+inline int sweptMask8(const SweptQuery& q, __m256 mnx, __m256 mxx, __m256 mnz, __m256 mxz) {
+    const __m256 rr = _mm256_set1_ps(q.rr);
+    __m256 tEnter = _mm256_setzero_ps(), tExit = _mm256_set1_ps(1.0f);
+    __m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    __m256 lo = _mm256_sub_ps(mnx, rr), hi = _mm256_add_ps(mxx, rr), o = _mm256_set1_ps(q.ox);
+    if (q.staticX) {
+        in = _mm256_and_ps(in, _mm256_and_ps(_mm256_cmp_ps(o, lo, _CMP_GE_OQ), _mm256_cmp_ps(o, hi, _CMP_LE_OQ)));
+    } else {
+        const __m256 inv = _mm256_set1_ps(q.invX);
+        __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(lo, o), inv), t1 = _mm256_mul_ps(_mm256_sub_ps(hi, o), inv);
+        tEnter = _mm256_max_ps(tEnter, _mm256_min_ps(t0, t1));
+        tExit = _mm256_min_ps(tExit, _mm256_max_ps(t0, t1));
+    }
+    lo = _mm256_sub_ps(mnz, rr);
+    hi = _mm256_add_ps(mxz, rr);
+    o = _mm256_set1_ps(q.oz);
+    if (q.staticZ) {
+        in = _mm256_and_ps(in, _mm256_and_ps(_mm256_cmp_ps(o, lo, _CMP_GE_OQ), _mm256_cmp_ps(o, hi, _CMP_LE_OQ)));
+    } else {
+        const __m256 inv = _mm256_set1_ps(q.invZ);
+        __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(lo, o), inv), t1 = _mm256_mul_ps(_mm256_sub_ps(hi, o), inv);
+        tEnter = _mm256_max_ps(tEnter, _mm256_min_ps(t0, t1));
+        tExit = _mm256_min_ps(tExit, _mm256_max_ps(t0, t1));
+    }
+    return _mm256_movemask_ps(_mm256_and_ps(in, _mm256_cmp_ps(tEnter, tExit, _CMP_LE_OQ)));
+}
+
+__attribute__((target("avx2")))
+int sweptAvx2(const Hot& h, const SweptQuery& q, int* idx, int n) {
+    int w = 0;
+    for (int k = 0; k < n; k += 8) {
+        alignas(32) int lane[8];
+        int live = 0;
+        for (int j = 0; j < 8; ++j) {
+            lane[j] = (k + j < n) ? idx[k + j] : idx[k];
+            if (k + j < n && aliveBit(h, lane[j])) live |= 1 << j;
+        }
+        if (!live) continue;
+        __m256i vi = _mm256_load_si256((const __m256i*)lane);
+        int m = sweptMask8(q, _mm256_i32gather_ps(h.minX, vi, 4), _mm256_i32gather_ps(h.maxX, vi, 4),
+                           _mm256_i32gather_ps(h.minZ, vi, 4), _mm256_i32gather_ps(h.maxZ, vi, 4)) & live;
+        for (; m; m &= m - 1) idx[w++] = lane[__builtin_ctz((unsigned)m)];
+    }
+    return w;
+}
+
+__attribute__((target("avx2")))
+int* centersAvx2(const Hot& h, float cx, float cz, float scroll, float r2, int* out) {
+    const __m256 half = _mm256_set1_ps(0.5f), vcx = _mm256_set1_ps(cx), vcz = _mm256_set1_ps(cz);
+    const __m256 vscroll = _mm256_set1_ps(scroll), vr2 = _mm256_set1_ps(r2);
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        for (int k = 0; bits != 0; ++k, bits >>= 8) {
+            int live = (int)(bits & 0xFFu);
+            if (!live) continue;
+            int i = w * 64 + k * 8;
+            __m256 dx = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(h.minX + i), _mm256_loadu_ps(h.maxX + i)),
+                                                    half), vcx);
+            __m256 dz = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(h.minZ + i),
+                                                                                _mm256_loadu_ps(h.maxZ + i)), half),
+                                                    vscroll), vcz);
+            __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz));
+            out = pushLanes(i, _mm256_movemask_ps(_mm256_cmp_ps(d2, vr2, _CMP_LE_OQ)) & live, out);
+        }
+    }
+    return out;
+}
+#endif
+
+SimdLevel resolveSimd(SimdLevel level) {
+    if (level == SimdLevel::Auto) level = BrickField::detectedSimd();
+#if !B3D_BRICK_AVX2
+    if (level == SimdLevel::AVX2) level = SimdLevel::SSE2;
+#endif
+#if !B3D_BRICK_SSE2
+    if (level == SimdLevel::SSE2) level = SimdLevel::Scalar;
+#endif
+    return level;
+}
+
+} // namespace
+
+SimdLevel BrickField::detectedSimd() {
+    static const SimdLevel level = []() {
+#if B3D_BRICK_AVX2
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+#if B3D_BRICK_SSE2
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+    return level;
+}
+
+// ---------------------------------------------------------------------------
+// Campo
+// ---------------------------------------------------------------------------
+void BrickField::configureGrid(float minX, float maxX, float minZ, float maxZ, float cellX, float cellZ) {
+    m_grid.configure(minX, maxX, minZ, maxZ, cellX, cellZ);
+    m_rowPitch = std::max(0.01f, cellZ);
+    clear();
+}
+
+void BrickField::clear() {
+    m_count = 0;
+    m_minX.clear(); m_maxX.clear(); m_minZ.clear(); m_maxZ.clear();
+    m_aliveBits.clear();
+    m_hp.clear(); m_maxHp.clear();
+    m_posY.clear(); m_sizeY.clear();
+    m_free.clear();
+    m_freeCount = 0;
+    for (auto& g : m_gen) ++g; // invalida handles de antes do clear
+    m_rowOf.clear();
+    m_stats.clear();
+    m_scrollZ = 0.0f;
+    m_grid.clear();
+}
+
+void BrickField::reserveSlots(int n) {
+    std::size_t padded = (std::size_t)roundUp8(n);
+    if (padded <= m_minX.size()) return;
+
+    m_minX.resize(padded, 0.0f);
+    m_maxX.resize(padded, 0.0f);
+    m_minZ.resize(padded, 0.0f);
+    m_maxZ.resize(padded, 0.0f);
+    m_hp.resize(padded, 0);
+    m_maxHp.resize(padded, 0);
+    m_posY.resize(padded, 0.0f);
+    m_sizeY.resize(padded, 0.0f);
+    m_rowOf.resize(padded, 0);
+    m_aliveBits.resize((padded + 63) / 64, 0);
+    if (m_gen.size() < padded) m_gen.resize(padded, 0);
+    m_free.resize(padded, 0); // a pilha de livres nunca passa do nº de slots: kill e cópias não alocam
+}
+
+int BrickField::add(const Brick& b) {
+    int i;
+    if (m_freeCount > 0) {
+        i = m_free[(std::size_t)--m_freeCount];
+    } else {
+        i = m_count++;
+        reserveSlots(m_count);
+    }
+
+    float hx = b.size.x * 0.5f;
+    float hz = b.size.z * 0.5f;
+    m_minX[(std::size_t)i] = b.pos.x - hx;
+    m_maxX[(std::size_t)i] = b.pos.x + hx;
+    m_minZ[(std::size_t)i] = b.pos.z - hz - m_scrollZ;
+    m_maxZ[(std::size_t)i] = b.pos.z + hz - m_scrollZ;
+    m_hp[(std::size_t)i] = b.hp;
+    m_maxHp[(std::size_t)i] = b.maxHp;
+    m_posY[(std::size_t)i] = b.pos.y;
+    m_sizeY[(std::size_t)i] = b.size.y;
+
+    if (b.alive) {
+        m_aliveBits[(std::size_t)i >> 6] |= (std::uint64_t)1 << (i & 63);
+        m_grid.insert(i, m_minX[(std::size_t)i], m_maxX[(std::size_t)i], b.pos.z - hz, b.pos.z + hz);
+        m_rowOf[(std::size_t)i] = rowKey(m_minZ[(std::size_t)i], m_maxZ[(std::size_t)i]);
+        m_stats.onSpawn(b.hp, m_rowOf[(std::size_t)i], m_maxZ[(std::size_t)i]);
+    } else {
+        m_free[(std::size_t)m_freeCount++] = i; // spawnado morto: o slot fica logo livre
+    }
+    return i;
+}
+
+void BrickField::kill(int i) {
+    if (i < 0 || i >= m_count || !alive(i)) return;
+    m_aliveBits[(std::size_t)i >> 6] &= ~((std::uint64_t)1 << (i & 63));
+    m_gen[(std::size_t)i]++;
+    m_free[(std::size_t)m_freeCount++] = i;
+    m_grid.remove(i);
+    m_stats.onKill(m_hp[(std::size_t)i], m_rowOf[(std::size_t)i]);
+}
+
+void BrickField::setHp(int i, int hp) {
+    if (alive(i)) m_stats.onDamage(m_hp[(std::size_t)i], hp);
+    m_hp[(std::size_t)i] = hp;
+}
+
+BrickHandle BrickField::handle(int i) const {
+    if (i < 0 || i >= m_count || !alive(i)) return BrickHandle{};
+    return BrickHandle{ i, m_gen[(std::size_t)i] };
+}
+
+int BrickField::resolve(BrickHandle h) const {
+    if (h.index < 0 || h.index >= m_count) return -1;
+    if (!alive(h.index) || m_gen[(std::size_t)h.index] != h.gen) return -1;
+    return h.index;
+}
+
+std::size_t BrickField::memoryBytes() const {
+    std::size_t floats = m_minX.capacity() + m_maxX.capacity() + m_minZ.capacity() + m_maxZ.capacity() +
+                         m_posY.capacity() + m_sizeY.capacity();
+    std::size_t ints = m_hp.capacity() + m_maxHp.capacity() + m_free.capacity() + m_rowOf.capacity();
+    return floats * sizeof(float) + ints * sizeof(int) + m_gen.capacity() * sizeof(std::uint32_t) +
+           m_aliveBits.capacity() * sizeof(std::uint64_t) + m_stats.memoryBytes() + m_grid.memoryBytes();
+}
+
+void BrickField::save(SnapshotWriter& w) const {
+    w.pod(m_count);
+    w.array(m_minX); w.array(m_maxX); w.array(m_minZ); w.array(m_maxZ);
+    w.array(m_aliveBits);
+    w.array(m_hp); w.array(m_maxHp);
+    w.array(m_posY); w.array(m_sizeY);
+    w.array(m_gen);
+    w.pod((std::uint32_t)m_freeCount); // mesmo formato que um array: só a pilha ocupada
+    w.bytes(m_free.data(), (std::size_t)m_freeCount * sizeof(int));
+    w.pod(m_scrollZ);
+    w.pod(m_rowPitch);
+    w.array(m_rowOf);
+    m_stats.save(w);
+    m_grid.save(w);
+}
+
+bool BrickField::load(SnapshotReader& r) {
+    r.pod(m_count);
+    r.array(m_minX); r.array(m_maxX); r.array(m_minZ); r.array(m_maxZ);
+    r.array(m_aliveBits);
+    r.array(m_hp); r.array(m_maxHp);
+    r.array(m_posY); r.array(m_sizeY);
+    r.array(m_gen);
+    r.array(m_free);
+    m_freeCount = (int)m_free.size();
+    if (m_free.size() < m_minX.size()) m_free.resize(m_minX.size(), 0);
+    r.pod(m_scrollZ);
+    r.pod(m_rowPitch);
+    r.array(m_rowOf);
+    if (!r.ok() || !m_stats.load(r) || !m_grid.load(r)) return false;
+
+    // Os kernels em lote lêem até ao padding: os arrays têm de cobrir os slots.
+    const std::size_t padded = (std::size_t)roundUp8(m_count);
+    return m_count >= 0 && m_minX.size() >= padded && m_maxX.size() == m_minX.size() &&
+           m_minZ.size() == m_minX.size() && m_maxZ.size() == m_minX.size() &&
+           m_hp.size() == m_minX.size() && m_maxHp.size() == m_minX.size() &&
+           m_posY.size() == m_minX.size() && m_sizeY.size() == m_minX.size() &&
+           m_rowOf.size() == m_minX.size() && m_gen.size() >= m_minX.size() &&
+           m_free.size() == m_minX.size() &&
+           m_aliveBits.size() == (m_minX.size() + 63) / 64;
+}
+
+glm::vec3 BrickField::size(int i) const {
+    return glm::vec3(m_maxX[(std::size_t)i] - m_minX[(std::size_t)i],
+                     m_sizeY[(std::size_t)i],
+                     m_maxZ[(std::size_t)i] - m_minZ[(std::size_t)i]);
+}
+
+Brick BrickField::brick(int i) const {
+    Brick b;
+    b.pos = center(i);
+    b.size = size(i);
+    b.alive = alive(i);
+    b.hp = m_hp[(std::size_t)i];
+    b.maxHp = m_maxHp[(std::size_t)i];
+    return b;
+}
+
+void BrickField::shiftZ(float dz) {
+    if (dz == 0.0f) return;
+    m_scrollZ += dz;
+    if (!m_grid.shiftZ(dz)) rebuildGrid();
+    if (std::abs(m_scrollZ) > kRebaseZ) rebaseScroll();
+}
+
+void BrickField::rebuildGrid() {
+    m_grid.clear();
+    forEachAlive([&](int i) {
+        m_grid.insert(i, m_minX[(std::size_t)i], m_maxX[(std::size_t)i], minZ(i), maxZ(i));
+    });
+}
+
+void BrickField::rebaseScroll() {
+    // Mundo não muda (a grelha fica igual); só os Z locais e as keys das rows.
+    forEachAlive([&](int i) {
+        m_minZ[(std::size_t)i] += m_scrollZ;
+        m_maxZ[(std::size_t)i] += m_scrollZ;
+    });
+    m_scrollZ = 0.0f;
+    m_stats.clear();
+    forEachAlive([&](int i) {
+        m_rowOf[(std::size_t)i] = rowKey(m_minZ[(std::size_t)i], m_maxZ[(std::size_t)i]);
+        m_stats.onSpawn(m_hp[(std::size_t)i], m_rowOf[(std::size_t)i], m_maxZ[(std::size_t)i]);
+    });
+}
+
+int BrickField::rowKey(float localMinZ, float localMaxZ) const {
+    return (int)std::floor((localMinZ + localMaxZ) * 0.5f / m_rowPitch);
+}
+
+void BrickField::queryCircle(float cx, float cz, float radius, std::vector<int>& out, SimdLevel level) const {
+    const float r2 = radius * radius;
+
+    // Scan em lote por ordem de slot: o campo tem no máximo ~230 slots (reciclados), o que
+    // custa menos do que ir célula a célula na grelha em qualquer raio de AoE.
+    // Espaço para todos os vivos (a capacidade fica: em regime não aloca); encolhe no fim.
+    out.resize((std::size_t)aliveCount());
+    const Hot h = hot();
+    int* end = out.data();
+    switch (resolveSimd(level)) {
+#if B3D_BRICK_AVX2
+        case SimdLevel::AVX2: end = centersAvx2(h, cx, cz, m_scrollZ, r2, end); break;
+#endif
+#if B3D_BRICK_SSE2
+        case SimdLevel::SSE2: end = centersSse2(h, cx, cz, m_scrollZ, r2, end); break;
+#endif
+        default: end = centersScalar(h, cx, cz, m_scrollZ, r2, end); break;
+    }
+    out.resize((std::size_t)(end - out.data()));
+}
+
+BrickField::HotArrays BrickField::hot() const {
+    return HotArrays{m_minX.data(), m_maxX.data(), m_minZ.data(), m_maxZ.data(), m_aliveBits.data(),
+                     (int)m_aliveBits.size()};
+}
+
+void BrickField::sweptCandidates(const glm::vec3& p, const glm::vec3& d, float r, std::vector<int>& candidates,
+                                 SimdLevel level) const {
+    int n = (int)candidates.size();
+    if (n == 0) return;
+    // Folga: o teste exacto é em Z do mundo, este em Z local (o scroll arredonda de outra maneira).
+    const SweptQuery q = makeSweptQuery(p.x, p.z - m_scrollZ, d.x, d.z, r + kSweptSlack);
+    const Hot h = hot();
+    int* idx = candidates.data();
+
+    // Listas da grelha têm 4-16 entradas: o gather AVX2 não compensa (fica o SSE2) e abaixo de
+    // 4 nem a montagem das lanes.
+    if (level == SimdLevel::Auto) {
+        level = resolveSimd(level);
+        if (level == SimdLevel::AVX2) level = SimdLevel::SSE2;
+        if (n < kMinSimdList) level = SimdLevel::Scalar;
+    }
+
+    switch (resolveSimd(level)) {
+#if B3D_BRICK_AVX2
+        case SimdLevel::AVX2: n = sweptAvx2(h, q, idx, n); break;
+#endif
+#if B3D_BRICK_SSE2
+        case SimdLevel::SSE2: n = sweptSse2(h, q, idx, n); break;
+#endif
+        default: n = sweptScalar(h, q, idx, n); break;
+    }
+    candidates.resize((std::size_t)n);
+}
+
+} // namespace game
@@ -0,0 +1,212 @@
+// BrickGrid.cpp
+/**
+ * @file BrickGrid.cpp
+ * @brief Grelha uniforme XZ dos bricks vivos (broadphase das colisões bola-brick).
+ *
+ * Notas:
+ *  - O AABB do brick é expandido por um epsilon ao registar: o push das rows soma `stepZ`
+ *    em float e a célula "verdadeira" pode mudar por arredondamento; assim o conjunto
+ *    registado é sempre um superconjunto das células realmente tocadas.
+ *  - O ring de rows só roda se as rows que "dão a volta" (fundo -> topo) estiverem vazias;
+ *    bricks no fundo da arena significam game over iminente, por isso o rebuild é raro.
+ */
+#include "game/BrickGrid.hpp"
+#include "game/Snapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace game {
+
+static constexpr float kSpanEpsilon = 1e-3f;
+
+void BrickGrid::configure(float minX, float maxX, float minZ, float maxZ, float cellX, float cellZ) {
+    m_minX = minX;
+    m_minZ = minZ;
+    m_cellX = std::max(0.01f, cellX);
+    m_cellZ = std::max(0.01f, cellZ);
+    m_invCellX = 1.0f / m_cellX;
+    m_invCellZ = 1.0f / m_cellZ;
+    m_cols = std::max(1, (int)std::ceil((maxX - minX) * m_invCellX));
+    m_rows = std::max(1, (int)std::ceil((maxZ - minZ) * m_invCellZ));
+
+    m_items.assign((std::size_t)m_cols * (std::size_t)m_rows * kCellCapacity, -1);
+    m_counts.assign((std::size_t)m_cols * (std::size_t)m_rows, 0);
+    clear();
+}
+
+void BrickGrid::clear() {
+    std::fill(m_counts.begin(), m_counts.end(), (std::uint8_t)0);
+    m_overflow.clear();
+    m_spans.clear();
+    m_rowBase = 0;
+    m_alive = 0;
+    m_entries = 0;
+}
+
+int BrickGrid::colOf(float x) const {
+    int c = (int)std::floor((x - m_minX) * m_invCellX);
+    return std::clamp(c, 0, m_cols - 1);
+}
+
+int BrickGrid::rowOf(float z) const {
+    int r = (int)std::floor((z - m_minZ) * m_invCellZ);
+    return std::clamp(r, 0, m_rows - 1);
+}
+
+void BrickGrid::insert(int index, float minX, float maxX, float minZ, float maxZ) {
+    if (!configured() || index < 0) return;
+    if ((std::size_t)index >= m_spans.size()) m_spans.resize((std::size_t)index + 1);
+
+    Span& s = m_spans[(std::size_t)index];
+    if (s.nr > 0) return; // já registado
+
+    int r0 = rowOf(minZ - kSpanEpsilon);
+    int r1 = rowOf(maxZ + kSpanEpsilon);
+
+    s.c0 = (std::int16_t)colOf(minX - kSpanEpsilon);
+    s.c1 = (std::int16_t)colOf(maxX + kSpanEpsilon);
+    s.r0 = (std::int16_t)physRow(r0);
+    s.nr = (std::int16_t)(r1 - r0 + 1);
+
+    // Se alguma célula do span está cheia o brick vai só para o overflow (não entra em nenhuma
+    // célula): as queries não têm de deduplicar.
+    s.overflow = false;
+    for (int i = 0; i < s.nr && !s.overflow; ++i) {
+        int prow = (s.r0 + i) % m_rows;
+        for (int c = s.c0; c <= s.c1; ++c) {
+            if (m_counts[(std::size_t)(prow * m_cols + c)] >= kCellCapacity) { s.overflow = true; break; }
+        }
+    }
+
+    if (s.overflow) {
+        m_overflow.push_back(index);
+        m_entries++;
+    } else {
+        m_entries += s.nr * (s.c1 - s.c0 + 1);
+        for (int i = 0; i < s.nr; ++i) {
+            int prow = (s.r0 + i) % m_rows;
+            for (int c = s.c0; c <= s.c1; ++c) {
+                std::uint8_t& n = m_counts[(std::size_t)(prow * m_cols + c)];
+                cellItems(c, prow)[n++] = index;
+            }
+        }
+    }
+    m_alive++;
+}
+
+void BrickGrid::remove(int index) {
+    if (index < 0 || (std::size_t)index >= m_spans.size()) return;
+    Span& s = m_spans[(std::size_t)index];
+    if (s.nr <= 0) return;
+
+    if (s.overflow) {
+        auto it = std::find(m_overflow.begin(), m_overflow.end(), index);
+        if (it != m_overflow.end()) m_overflow.erase(it);
+        m_entries--;
+    } else {
+        m_entries -= s.nr * (s.c1 - s.c0 + 1);
+        for (int i = 0; i < s.nr; ++i) {
+            int prow = (s.r0 + i) % m_rows;
+            for (int c = s.c0; c <= s.c1; ++c) {
+                std::uint8_t& n = m_counts[(std::size_t)(prow * m_cols + c)];
+                int* items = cellItems(c, prow);
+                for (int k = 0; k < n; ++k) {
+                    if (items[k] == index) {
+                        items[k] = items[--n]; // ordem dentro da célula não interessa
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    s = Span{};
+    m_alive--;
+}
+
+bool BrickGrid::shiftZ(float dz) {
+    if (!configured() || dz == 0.0f) return true;
+
+    float cells = dz * m_invCellZ;
+    int k = (int)std::lround(cells);
+    bool aligned = (k > 0 && k < m_rows && std::abs(cells - (float)k) <= 1e-3f);
+
+    if (aligned) {
+        // As k rows lógicas do fundo passam a ser as k do topo: só é válido se estiverem vazias.
+        for (int r = m_rows - k; r < m_rows && aligned; ++r) {
+            int prow = physRow(r);
+            for (int c = 0; c < m_cols; ++c) {
+                if (m_counts[(std::size_t)(prow * m_cols + c)] != 0) { aligned = false; break; }
+            }
+        }
+    }
+
+    if (!aligned) return false;
+    m_rowBase = (m_rowBase - k + m_rows) % m_rows;
+    return true;
+}
+
+void BrickGrid::queryRect(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const {
+    out.clear();
+    if (!configured()) return;
+
+    int c0 = colOf(minX), c1 = colOf(maxX);
+    int r0 = rowOf(minZ), r1 = rowOf(maxZ);
+
+    for (int r = r0; r <= r1; ++r) {
+        int prow = physRow(r);
+        for (int c = c0; c <= c1; ++c) {
+            int n = m_counts[(std::size_t)(prow * m_cols + c)];
+            const int* items = cellItems(c, prow);
+            for (int k = 0; k < n; ++k) {
+                // Brick em várias células: só a primeira célula (span ∩ query) o devolve.
+                int idx = items[k];
+                const Span& sp = m_spans[(std::size_t)idx];
+                int lr0 = (sp.r0 - m_rowBase + m_rows) % m_rows;
+                if (c == std::max((int)sp.c0, c0) && r == std::max(lr0, r0)) out.push_back(idx);
+            }
+        }
+    }
+    // Overflow: não está em nenhuma célula, por isso entra sempre (sem duplicados).
+    out.insert(out.end(), m_overflow.begin(), m_overflow.end());
+}
+
+void BrickGrid::querySwept(const glm::vec3& from, const glm::vec3& to, float radius, std::vector<int>& out) const {
+    queryRect(std::min(from.x, to.x) - radius, std::min(from.z, to.z) - radius,
+              std::max(from.x, to.x) + radius, std::max(from.z, to.z) + radius, out);
+}
+
+std::size_t BrickGrid::memoryBytes() const {
+    return m_items.capacity() * sizeof(int) + m_counts.capacity() +
+           m_overflow.capacity() * sizeof(int) + m_spans.capacity() * sizeof(Span);
+}
+
+void BrickGrid::save(SnapshotWriter& w) const {
+    w.pod(m_minX); w.pod(m_minZ);
+    w.pod(m_cellX); w.pod(m_cellZ);
+    w.pod(m_cols); w.pod(m_rows);
+    w.pod(m_rowBase); w.pod(m_alive);
+    w.array(m_items);
+    w.array(m_counts);
+    w.array(m_overflow);
+    w.array(m_spans);
+}
+
+bool BrickGrid::load(SnapshotReader& r) {
+    r.pod(m_minX); r.pod(m_minZ);
+    r.pod(m_cellX); r.pod(m_cellZ);
+    r.pod(m_cols); r.pod(m_rows);
+    r.pod(m_rowBase); r.pod(m_alive);
+    r.array(m_items);
+    r.array(m_counts);
+    r.array(m_overflow);
+    r.array(m_spans);
+    m_invCellX = 1.0f / m_cellX;
+    m_invCellZ = 1.0f / m_cellZ;
+    m_entries = (int)m_overflow.size();
+    for (std::uint8_t c : m_counts) m_entries += c;
+    return r.ok() && m_items.size() == (std::size_t)m_cols * (std::size_t)m_rows * kCellCapacity &&
+           m_counts.size() == (std::size_t)m_cols * (std::size_t)m_rows;
+}
+
+} // namespace game
@@ -0,0 +1,117 @@
+// FieldStats.cpp
+/**
+ * @file FieldStats.cpp
+ * @brief Manutenção incremental dos agregados do campo (ver FieldStats.hpp).
+ *
+ * Notas:
+ *  - Todas as operações são O(1) amortizado: o ring de rows só cresce nas pontas e as rows
+ *    vazias das pontas são removidas no kill.
+ *  - O ring dobra quando enche (cópia pela ordem front..back); em regime não há alocações.
+ */
+#include "game/FieldStats.hpp"
+#include "game/Snapshot.hpp"
+
+#include <algorithm>
+
+namespace game {
+
+void FieldStats::clear() {
+    m_alive = 0;
+    m_totalHp = 0;
+    m_hpCount.fill(0);
+    m_rowHead = 0;
+    m_rowCount = 0;
+    m_rowFrontKey = 0;
+}
+
+void FieldStats::growRing() {
+    // 64 rows cobrem a arena inteira com folga: em jogo normal o ring nunca cresce
+    std::vector<Row> bigger(m_ring.empty() ? 64 : m_ring.size() * 2);
+    for (int k = 0; k < m_rowCount; ++k) bigger[(std::size_t)k] = row(k);
+    m_ring.swap(bigger);
+    m_rowHead = 0;
+}
+
+void FieldStats::pushFrontRow() {
+    if (m_rowCount == (int)m_ring.size()) growRing();
+    m_rowHead = (m_rowHead - 1) & (int)(m_ring.size() - 1);
+    m_rowCount++;
+    row(0) = Row{};
+}
+
+void FieldStats::pushBackRow() {
+    if (m_rowCount == (int)m_ring.size()) growRing();
+    m_rowCount++;
+    row(m_rowCount - 1) = Row{};
+}
+
+void FieldStats::onSpawn(int hp, int rowKey, float localMaxZ) {
+    m_alive++;
+    m_totalHp += std::max(0, hp);
+    m_hpCount[(std::size_t)bucket(hp)]++;
+
+    if (m_rowCount == 0) {
+        pushBackRow();
+        m_rowFrontKey = rowKey;
+    } else if (rowKey < m_rowFrontKey) {
+        // rows novas do push entram no topo (front)
+        for (int k = rowKey; k < m_rowFrontKey; ++k) pushFrontRow();
+        m_rowFrontKey = rowKey;
+    } else {
+        while (rowKey >= m_rowFrontKey + m_rowCount) pushBackRow();
+    }
+
+    Row& r = row(rowKey - m_rowFrontKey);
+    r.maxZ = (r.alive == 0) ? localMaxZ : std::max(r.maxZ, localMaxZ);
+    r.alive++;
+}
+
+void FieldStats::onKill(int hp, int rowKey) {
+    m_alive--;
+    m_totalHp -= std::max(0, hp);
+    m_hpCount[(std::size_t)bucket(hp)]--;
+
+    const int k = rowKey - m_rowFrontKey;
+    if (k < 0 || k >= m_rowCount) return;
+    row(k).alive--;
+
+    // as pontas ficam sempre ocupadas: a última é a row viva mais funda
+    while (m_rowCount > 0 && row(0).alive <= 0) {
+        m_rowHead = (m_rowHead + 1) & (int)(m_ring.size() - 1);
+        m_rowCount--;
+        m_rowFrontKey++;
+    }
+    while (m_rowCount > 0 && row(m_rowCount - 1).alive <= 0) m_rowCount--;
+}
+
+void FieldStats::onDamage(int hpBefore, int hpAfter) {
+    m_totalHp += std::max(0, hpAfter) - std::max(0, hpBefore);
+    m_hpCount[(std::size_t)bucket(hpBefore)]--;
+    m_hpCount[(std::size_t)bucket(hpAfter)]++;
+}
+
+void FieldStats::save(SnapshotWriter& w) const {
+    w.pod(m_alive);
+    w.pod(m_totalHp);
+    w.pod(m_hpCount);
+    w.pod(m_rowFrontKey);
+    w.pod((std::uint32_t)m_rowCount);
+    for (int k = 0; k < m_rowCount; ++k) w.pod(row(k));
+}
+
+bool FieldStats::load(SnapshotReader& r) {
+    std::uint32_t rows = 0;
+    r.pod(m_alive);
+    r.pod(m_totalHp);
+    r.pod(m_hpCount);
+    r.pod(m_rowFrontKey);
+    if (!r.pod(rows) || (std::size_t)rows * sizeof(Row) > r.remaining()) return false;
+    m_rowHead = 0;
+    m_rowCount = 0;
+    while (m_ring.size() < rows) growRing();
+    m_rowCount = (int)rows;
+    for (int k = 0; k < m_rowCount; ++k) r.pod(row(k));
+    return r.ok();
+}
+
+} // namespace game
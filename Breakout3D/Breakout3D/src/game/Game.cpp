@@ -8,12 +8,20 @@
  *  - Se tiver áudio, começa logo com música do menu.
  *
  * Em Game::init():
- *  - Após reset do estado (InitSystem::initGame), troca para a música do modo (ENDLESS/ROGUE/NORMAL)
+ *  - Reset do estado (InitSystem::initGame) com seed novo, ou B3D_SEED=<n> para repetir sempre a mesma run
+ *  - Começa a gravar o replay da run (o anterior, se ainda estava aberto, é escrito primeiro)
+ *  - B3D_REPLAY=<ficheiro.b3dr>: o jogo arranca directamente no playback desse replay
+ *  - Limpa o ring de rewind/seek e guarda o snapshot do tick 0
+ *  - Após o reset, troca para a música do modo (ENDLESS/ROGUE/NORMAL)
  *  - Toca stinger de “start-of-run”
  */
  #include "game/Game.hpp"
  #include "game/systems/InitSystem.hpp"
  
+ #include <cstdio>
+ #include <cstdlib>
+ #include <string>
+ 
  namespace game {
  
  Game::Game(engine::Window& window, engine::Time& time, engine::Renderer& renderer, GameAssets& assets)
@@ -27,10 +35,38 @@
          m_audio.playMusic("music_menu_loop", 0.0f);
          m_currentMusicGroup = "music_menu_loop";
      }
+ 
+     // B3D_REPLAY: ver uma run gravada em tempo real (o input vem do ficheiro, não do teclado).
+     if (const char* env = std::getenv("B3D_REPLAY"); env && *env) {
+         std::string error;
+         if (m_replayPlayer.loadFile(env, &error)) {
+             if (m_replayPlayer.header().configHash != replayConfigHash(m_cfg)) {
+                 std::fprintf(stderr, "replay: %s was recorded with a different GameConfig, expect a desync\n", env);
+             }
+             m_replayPlayback = true;
+             m_state.mode = GameMode::PLAYING;
+             init();
+         } else {
+             std::fprintf(stderr, "replay: %s\n", error.c_str());
+         }
+     }
  }
  
  void Game::init() {
-     InitSystem::initGame(m_state, m_cfg);
+     // B3D_SEED: seed fixo para todas as runs (reproduzir um bug / uma run); 0 ou ausente = seed novo.
+     std::uint64_t seed = 0;
+     if (const char* env = std::getenv("B3D_SEED"); env && *env) seed = std::strtoull(env, nullptr, 10);
+ 
+     finishReplay(); // restart a meio de uma run: a run anterior também fica gravada
+     if (m_replayPlayback) {
+         m_replayPlayer.begin(m_state, m_cfg);
+         m_replayRec = ReplayRecorder(); // em playback não se grava (e um rewind não reabre a run anterior)
+     } else {
+         InitSystem::initGame(m_state, m_cfg, seed);
+         m_replayRec.begin(m_state, m_cfg);
+     }
+     m_sim.reset(); // nova run: não herdar tempo acumulado
+     resetRewind();
  
      // Sempre que começa/recomeça uma run, garantir música correta.
      if (m_audio.isEnabled()) {
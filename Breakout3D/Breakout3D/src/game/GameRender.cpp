@@ -5,9 +5,9 @@
 #include "game/render/RenderContext.hpp"
 #include "game/render/UIRender.hpp"
 #include "game/render/WorldRender.hpp"
-#include "game/ui/OverlayLayout.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -15,7 +15,8 @@
 namespace game {
 
 /*
-    Render pipeline:
+    Render pipeline (thread principal, dono do contexto GL):
+    - Adquire o último RenderSnapshot publicado pela simulação (triple buffer, sem locks).
     - Se estiver em MENU: desenha só UI do menu e sai.
     - Caso contrário:
       1) Background (se activo)
@@ -26,19 +27,39 @@ void Game::render() {
     auto [fbW, fbH] = m_window.getFramebufferSize();
     m_renderer.beginFrame(fbW, fbH);
 
-    // MENU: render dedicado
-    if (m_state.mode == GameMode::MENU) {
-        // Defesa: se por alguma razão render vier antes de update, layout existe na mesma.
-        m_state.menuLayout = ui::calculateMenuLayout(m_renderer, fbW, fbH);
+    // Pré-carregar GIFs de powerups (assíncrono + upload incremental, budget em bytes por tick).
+    // Fica aqui (e não no update) porque o upload é GL.
+    m_assets.startPowerupVideoPreload();
+    m_assets.pumpPowerupVideoPreload(4u << 20);
+
+    m_snapshots.acquire();
+    const RenderSnapshot& snap = m_snapshots.front();
+    if (snap.simFrame == 0) {
+        // A simulação ainda não publicou nada: frame vazio.
+        m_window.swapBuffers();
+        return;
+    }
+    const GameState& state = snap.state;
+
+    // Interpolação: o alpha do snapshot avança com o tempo real desde a publicação
+    // (o render pode correr entre dois passos da simulação).
+    float simAlpha = state.simAlpha;
+    if (state.mode == GameMode::PLAYING && snap.simStep > 0.0f) {
+        float since = std::chrono::duration<float>(std::chrono::steady_clock::now() - snap.publishedAt).count();
+        simAlpha = std::min(1.0f, simAlpha + since / snap.simStep);
+    }
+
+    // MENU: render dedicado (menuLayout já vem calculado pela simulação)
+    if (state.mode == GameMode::MENU) {
         game::render::RenderContext ctx{fbW, fbH, m_time, m_renderer};
-        game::render::renderMenu(ctx, m_state, m_assets);
+        game::render::renderMenu(ctx, state, m_assets);
         m_window.swapBuffers();
         return;
     }
 
     // Background (opcional)
-    if (m_state.currentBg != -1) {
-        m_renderer.drawBackground(m_assets.backgroundTexs[m_state.currentBg].id);
+    if (state.currentBg != -1) {
+        m_renderer.drawBackground(m_assets.backgroundTexs[state.currentBg].id);
     }
 
     // -------- 3D PASS (camera setup) --------
@@ -50,7 +71,7 @@ void Game::render() {
     glm::vec3 camPos, camTarget;
     float fov = 45.0f;
 
-    if (m_state.cameraMode == 1) {
+    if (state.cameraMode == 1) {
         // Mode 1: Top-down (um pouco mais afastado)
         camPos    = glm::vec3(0.0f, base * 1.03f, zMid + 0.5f);
         camTarget = glm::vec3(0.0f, 0.0f, zMid);
@@ -64,11 +85,11 @@ void Game::render() {
 
     // WIN FINISHER: câmara cinematográfica (matemática em game/effects)
     float rollRad = 0.0f;
-    if (m_state.winFinisherActive) {
+    if (state.winFinisherActive) {
         auto cam = game::effects::computeWinFinisherCamera(
             camPos, camTarget, fov, base,
-            m_state.winFinisherTimer,
-            m_state.winFinisherRealTimer
+            state.winFinisherTimer,
+            state.winFinisherRealTimer
         );
         camPos = cam.camPos;
         camTarget = cam.camTarget;
@@ -77,8 +98,8 @@ void Game::render() {
     }
 
     // Fireball shake: jitter subtil na câmara ao impacto
-    if (m_state.fireballShakeTimer > 0.0f && m_cfg.fireballShakeDuration > 1e-4f) {
-        float u = m_state.fireballShakeTimer / m_cfg.fireballShakeDuration; // 1..0
+    if (state.fireballShakeTimer > 0.0f && m_cfg.fireballShakeDuration > 1e-4f) {
+        float u = state.fireballShakeTimer / m_cfg.fireballShakeDuration; // 1..0
         u = std::max(0.0f, std::min(1.0f, u));
 
         float e = u * u; // ease-out
@@ -103,8 +124,8 @@ void Game::render() {
     // Danger line (ENDLESS/ROGUE): projecta a linha para Y de ecrã
     // para a UI poder desenhar a banda/efeito apenas abaixo desse Y.
     float dangerLineScreenY = -1.0f; // UI pixels, origem em baixo
-    if ((m_state.gameType == GameType::ENDLESS || m_state.gameType == GameType::ROGUE) && m_state.endlessDangerActive) {
-        glm::vec3 worldPos(0.0f, 0.0f, m_state.endlessDangerMaxZ);
+    if ((state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) && state.endlessDangerActive) {
+        glm::vec3 worldPos(0.0f, 0.0f, state.endlessDangerMaxZ);
         glm::vec4 clip = P * V * glm::vec4(worldPos, 1.0f);
         if (std::abs(clip.w) > 1e-6f) {
             float ndcY = clip.y / clip.w; // -1..1
@@ -118,9 +139,10 @@ void Game::render() {
     ctx.P = P;
     ctx.camPos = camPos;
     ctx.dangerLineScreenY = dangerLineScreenY;
+    ctx.simAlpha = simAlpha;
 
-    game::render::renderWorld(ctx, m_state, m_cfg, m_assets);
-    game::render::renderUI(ctx, m_state, m_cfg, m_assets);
+    game::render::renderWorld(ctx, state, m_cfg, m_assets);
+    game::render::renderUI(ctx, state, m_cfg, m_assets);
 
     m_window.swapBuffers();
 }
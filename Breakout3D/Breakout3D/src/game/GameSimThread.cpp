@@ -0,0 +1,105 @@
+// GameSimThread.cpp
+/**
+ * @file GameSimThread.cpp
+ * @brief Thread da simulação: input (fila lock-free) -> Game::update -> RenderSnapshot (triple buffer).
+ *
+ * Modelo:
+ *  - Thread principal: pollEvents, Input::update, `submitInput`, `render` (GL), FramePacer.
+ *  - Thread da simulação: `tickSimulation` em loop a 240 Hz (1 passo fixo por iteração);
+ *    60 Hz em menus/pausa/fim de jogo (não há física, só UI e áudio).
+ *  - Nenhum lock no caminho quente: input por SpscQueue, estado por TripleBuffer.
+ *  - `threaded=false` (B3D_SIM_THREAD=0) corre exactamente o mesmo caminho no thread principal
+ *    (debug/profiling).
+ */
+#include "game/Game.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace game {
+
+Game::~Game() {
+    stopSimulation();
+    finishReplay(); // fechar a janela a meio de uma run também deixa o replay em disco
+}
+
+void Game::startSimulation(bool threaded) {
+    if (!threaded || m_simThread.joinable()) return;
+    m_simStop.store(false, std::memory_order_release);
+    m_simThread = std::thread(&Game::simThreadMain, this);
+}
+
+void Game::stopSimulation() {
+    if (!m_simThread.joinable()) return;
+    m_simStop.store(true, std::memory_order_release);
+    m_simThread.join();
+}
+
+void Game::submitInput(const engine::Input& input) {
+    engine::InputSample s = input.sample();
+
+    // Fila cheia (simulação parada/lenta): funde com a amostra pendente para não perder edges.
+    if (m_hasPendingInput) {
+        m_pendingInput.mergeNewer(s);
+        s = m_pendingInput;
+    }
+
+    if (m_inputQueue.push(s)) {
+        m_hasPendingInput = false;
+    } else {
+        m_pendingInput = s;
+        m_hasPendingInput = true;
+    }
+}
+
+void Game::tickSimulation() {
+    // Drena tudo o que chegou desde a última iteração (edges ficam em OR, estado = mais recente).
+    engine::InputSample batch[64];
+    int n = 0;
+    while (n < 64 && m_inputQueue.pop(batch[n])) ++n;
+    m_simInput.applySamples(batch, n);
+
+    m_simTime.tick();
+    update(m_simInput);
+    publishSnapshot();
+}
+
+void Game::publishSnapshot() {
+    RenderSnapshot& snap = m_snapshots.back();
+    snap.state = m_state; // copy-assign: os vectores do slot reutilizam a capacidade
+    snap.simFrame = ++m_simFrame;
+    snap.publishedAt = std::chrono::steady_clock::now();
+    snap.simStep = m_sim.step();
+    m_snapshots.publish();
+}
+
+void Game::simThreadMain() {
+    using clock = std::chrono::steady_clock;
+    auto next = clock::now();
+
+    while (!m_simStop.load(std::memory_order_acquire)) {
+        tickSimulation();
+
+        const double hz = isIdleState(m_state) ? 60.0 : 1.0 / (double)m_sim.step();
+        next += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / hz));
+
+        // Atrasado (ex.: breakpoint): re-sincroniza em vez de correr iterações em rajada.
+        auto now = clock::now();
+        if (next < now) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+bool Game::isIdleState(const GameState& state) {
+    if (state.winFinisherActive) return false;
+    return state.mode == GameMode::MENU ||
+           state.mode == GameMode::PAUSED ||
+           state.mode == GameMode::GAME_OVER ||
+           state.mode == GameMode::WIN;
+}
+
+bool Game::isIdle() const {
+    return isIdleState(m_snapshots.front().state);
+}
+
+} // namespace game
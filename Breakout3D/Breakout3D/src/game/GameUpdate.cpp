@@ -1,19 +1,20 @@
 #include "game/Game.hpp"
 #include "engine/Input.hpp"
 
-#include "game/GameAssets.hpp"
 #include "game/systems/InitSystem.hpp"
 #include "game/systems/InputSystem.hpp"
 #include "game/systems/PhysicsSystem.hpp"
 #include "game/systems/CollisionSystem.hpp"
 #include "game/systems/PowerUpSystem.hpp"
 #include "game/systems/RogueSystem.hpp"
+#include "game/systems/SimulationSystem.hpp"
 #include "game/rogue/RogueCards.hpp"
 #include "game/ui/OverlayLayout.hpp"
 #include "game/ui/RogueCardLayout.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <string>
@@ -25,12 +26,12 @@ namespace game {
     - Faz tick do áudio (fades/loops)
     - Aplica settings de volume (sliders do menu)
     - Faz snapshot do estado para triggers de SFX (diferenças entre frames)
-    - Pré-carrega GIFs dos powerups em background
+    - Rewind do Levels / seek do playback (GameUpdateRewind.cpp)
     - Processa menu/win finisher/input/overlays/timers/win conditions
-    - Por fim, corre a simulação do frame (updatePlayingFrame)
+    - Por fim, corre a simulação em passos fixos (simulateStep -> SimulationSystem::step)
 */
 void Game::update(const engine::Input& input) {
-    float dt = m_time.delta();
+    float dt = m_simTime.delta();
 
     // Tick áudio (fades, gating de loops). Pode estar desactivado.
     m_audio.update(dt);
@@ -43,22 +44,27 @@ void Game::update(const engine::Input& input) {
         m_audio.setStingerVolume(m_state.audioStingerVol);
     }
 
+    // Replay: a run acabou (game over, win, voltou ao menu) -> escreve o ficheiro.
+    if (m_state.mode == GameMode::MENU || m_state.mode == GameMode::GAME_OVER || m_state.mode == GameMode::WIN) {
+        finishReplay();
+    }
+    if (m_replayPlayback && m_state.mode == GameMode::MENU) {
+        m_replayPlayback = false;
+        m_rewind.clear();
+    }
+
+    // Rewind (Levels) / seek (playback): antes dos snapshots de transição, para o salto não
+    // parecer um launch nem uma mudança de modo deste frame.
+    updateRewind(input);
+
     // Snapshot para triggers baseados em diferenças
     GameMode modeBefore = m_state.mode;
-    GameType typeBefore = m_state.gameType;
-    int livesBefore = m_state.lives;
-    int waveBefore = m_state.wave;
-    int endlessRowsBefore = m_state.endlessRowsSpawned;
-    bool dangerBefore = m_state.endlessDangerActive;
-    int streakBefore = m_state.endlessStreakPoints;
-    bool hadPowerupBefore = !m_state.powerups.empty();
 
-    int attachedBefore = 0;
-    for (const auto& b : m_state.balls) if (b.attached) attachedBefore++;
+    int attachedBefore = m_state.balls.attachedCount();
 
-    // Pré-carregar GIFs de powerups (assíncrono + upload incremental)
-    m_assets.startPowerupVideoPreload();
-    m_assets.pumpPowerupVideoPreload(6);
+    // Snapshot "antes" da simulação: só é renovado se o último frame correu passos.
+    if (!m_simBeforeHeld) m_simBefore = captureSimSnapshot();
+    m_simBeforeHeld = false;
 
 #ifdef BREAKOUT3D_DEBUG
     // Debug: spawn de powerups específicos (teclas da fila de cima).
@@ -68,7 +74,7 @@ void Game::update(const engine::Input& input) {
             p.type = type;
             // Bricks começam em cfg.arenaMinZ + 0.85f (InitSystem.cpp).
             p.pos = glm::vec3(m_state.paddlePos.x, 0.4f, m_cfg.arenaMinZ + 0.85f);
-            m_state.powerups.push_back(p);
+            m_state.powerups.push(p);
         };
 
         if (input.keyPressed(engine::Key::K8)) spawnDebugDrop(PowerUpType::EXPAND);
@@ -82,6 +88,27 @@ void Game::update(const engine::Input& input) {
         if (input.keyPressed(engine::Key::K7)) spawnDebugDrop(PowerUpType::REVERSE);
     }
 
+    // Debug: "ball storm" (L) -> +2000 bolas livres a partir do paddle, para medir física +
+    // colisões com muitas bolas (ver também `make storm`, tools/ballstorm.cpp).
+    if (m_state.mode == GameMode::PLAYING && input.keyPressed(engine::Key::L)) {
+        const int stormCount = 2000;
+        for (int k = 0; k < stormCount; ++k) {
+            float ang = glm::radians(-70.0f + 140.0f * m_state.rng.fx.uniform());
+            Ball b;
+            b.pos = m_state.paddlePos + glm::vec3(0.0f, 0.0f, -(m_cfg.paddleSize.z * 0.5f + m_cfg.ballRadius + 0.15f));
+            b.vel = glm::vec3(std::sin(ang), 0.0f, -std::cos(ang)) * m_cfg.ballSpeed;
+            m_state.balls.add(b);
+        }
+    }
+
+    // Debug: força spawn instantâneo de 12 bricks no Endless (K3).
+    if (m_state.mode == GameMode::PLAYING && m_state.gameType == GameType::ENDLESS && input.keyPressed(engine::Key::K3)) {
+        InitSystem::spawnIncrementalBricks(m_state, m_cfg, 12, m_state.wave);
+        m_state.pendingSpawnBricks = 0;
+        m_state.endlessSpawnCooldown = 0.5f;
+        m_state.endlessAutoTimer = 0.0f;
+    }
+
     // Debug: encher cartas Rogue (R em modo ROGUE)
     if (m_state.gameType == GameType::ROGUE && input.keyPressed(engine::Key::R)) {
         m_state.rogueChosen.clear();
@@ -111,7 +138,7 @@ void Game::update(const engine::Input& input) {
 
         for (const auto& card : allCards) {
             if (m_state.rogueChosen.size() >= 20) break;
-            m_state.rogueChosen.push_back(card);
+            m_state.rogueChosen.push(card);
         }
     }
 #endif
@@ -122,8 +149,19 @@ void Game::update(const engine::Input& input) {
     // Finisher (se activo, consome o frame)
     if (updateWinFinisher(dt)) return;
 
-    // Input do jogo (pause, movimento, launch, etc.)
-    InputSystem::handleGameInput(m_state, input, m_cfg, m_window, dt);
+    // Input do jogo (pause, movimento, launch, etc.). Em playback o input vem do replay e o
+    // teclado só pausa a visualização.
+    if (m_replayPlayback) {
+        if (input.keyPressed(engine::Key::Escape)) {
+            if (m_state.mode == GameMode::PLAYING) m_state.mode = GameMode::PAUSED;
+            else if (m_state.mode == GameMode::PAUSED) m_state.mode = GameMode::PLAYING;
+        }
+        if (m_state.mode == GameMode::PLAYING || m_state.mode == GameMode::ROGUE_CARDS) {
+            m_replayPlayer.applyInputs(m_state, m_cfg);
+        }
+    } else {
+        InputSystem::handleGameInput(m_state, input, m_cfg, m_window);
+    }
 
     // Transição PAUSED: SFX + música
     if (modeBefore != m_state.mode) {
@@ -135,65 +173,94 @@ void Game::update(const engine::Input& input) {
         }
     }
 
+    if (modeBefore == GameMode::PLAYING && m_state.mode == GameMode::PAUSED) m_replayRec.pause();
+    if (modeBefore == GameMode::PAUSED && m_state.mode == GameMode::PLAYING) m_replayRec.resume();
+
     // Som de launch (attached -> livre)
-    int attachedAfter = 0;
-    for (const auto& b : m_state.balls) if (b.attached) attachedAfter++;
+    int attachedAfter = m_state.balls.attachedCount();
     if (attachedAfter < attachedBefore) {
         m_audio.playSfx("game/ball_launch", -1.5f);
+        m_replayRec.launch(m_state.launchInputDir);
     }
 
+    // Playback: a escolha de carta já veio do replay; o overlay só é desenhado.
+    if (m_replayPlayback && m_state.mode == GameMode::ROGUE_CARDS) return;
+
     // Overlays/UI modais
     if (updateRogueCardsOverlay(input)) return;
     if (updatePausedOverlay(input)) return;
 
-    // Timers (cooldowns, auto-spawns, etc.)
-    updateTimers(input, dt);
-
-    // WIN (modo NORMAL): quando não há bricks vivos
-    if (m_state.mode == GameMode::PLAYING &&
-        m_state.gameType == GameType::NORMAL &&
-        !InitSystem::anyBricksAlive(m_state)) {
-        m_state.winFinisherActive = true;
-        m_state.winFinisherTimer = 0.0f;
-        m_state.winFinisherRealTimer = 0.0f;
-        m_state.winFinisherAnchorValid = m_state.lastBrickDestroyedValid;
-        m_state.winFinisherAnchorPos = m_state.lastBrickDestroyedPos;
-        m_state.balls.clear();
-        m_state.powerups.clear();
-        return; // importante: evitar perder vida por "no balls"
+    // Simulação em passo fixo: o dt do frame é "pago" em passos de m_sim.step() (240 Hz).
+    // Frames rápidos podem correr 0 passos (o render interpola); frames lentos correm até 12 (50ms).
+    // Com o overlay de fim aberto a simulação fica parada.
+    if (m_state.mode != GameMode::GAME_OVER && m_state.mode != GameMode::WIN) {
+        const int steps = m_sim.advance(dt);
+        for (int i = 0; i < steps; ++i) {
+            if (m_replayPlayback) m_replayPlayer.applyInputs(m_state, m_cfg);
+            if (!simulateStep(m_sim.step())) break;
+        }
+        m_state.simAlpha = m_sim.alpha();
+        m_simBeforeHeld = (steps == 0);
     }
 
-    // LEVEL COMPLETE (modo LEVELS)
-    if (m_state.mode == GameMode::PLAYING &&
-        m_state.gameType == GameType::LEVELS &&
-        !InitSystem::anyBricksAlive(m_state)) {
+    // End overlay (Game Over / Win): depois dos passos, para abrir no frame em que o jogo acaba.
+    updateEndOverlay(input);
+}
+
+Game::SimSnapshot Game::captureSimSnapshot() const {
+    SimSnapshot s;
+    s.mode = m_state.mode;
+    s.type = m_state.gameType;
+    s.lives = m_state.lives;
+    s.wave = m_state.wave;
+    s.endlessRows = m_state.endlessRowsSpawned;
+    s.danger = m_state.endlessDangerActive;
+    s.streak = m_state.endlessStreakPoints;
+    return s;
+}
+
+/*
+    Game::simulateStep:
+    - Corre um passo do SimulationSystem (paddle, timers, win checks, frame de gameplay)
+    - Traduz os eventos do passo em SFX/stingers e reage às transições (música, loops)
+*/
+bool Game::simulateStep(float dt) {
+    m_simEvents.clear();
+    m_replayRec.beforeStep(m_state);
+    const auto result = SimulationSystem::step(m_state, m_cfg, dt, m_simEvents);
+    m_replayRec.afterStep(m_state);
+    playSimEvents(m_simEvents);
 
-        if (m_state.currentLevel >= m_state.levelsBestLevel) {
-            m_state.levelsBestLevel = m_state.currentLevel + 1;
-            if (m_state.levelsBestLevel > 20) m_state.levelsBestLevel = 20;
+    // Playback: avisar uma vez quando o estado deixa de bater com o gravado; no fim do
+    // replay o jogador fica com os controlos.
+    if (m_replayPlayback) {
+        const bool wasInSync = m_replayPlayer.desyncTick() < 0;
+        if (!m_replayPlayer.afterStep(m_state) && wasInSync) {
+            std::fprintf(stderr, "replay: desync at tick %lld\n", m_replayPlayer.desyncTick());
         }
+        if (m_replayPlayer.finished()) {
+            m_replayPlayback = false;
+            m_rewind.clear(); // as entradas levam cursores do player, não marcas do recorder
+        }
+    }
+    captureRewind();
+
+    // Finisher começou: evitar perder vida por "no balls" nos passos seguintes.
+    if (result == SimulationSystem::StepResult::FieldCleared) return false;
 
-        m_state.winFinisherActive = true;
-        m_state.winFinisherTimer = 0.0f;
-        m_state.winFinisherRealTimer = 0.0f;
-        m_state.winFinisherAnchorValid = m_state.lastBrickDestroyedValid;
-        m_state.winFinisherAnchorPos = m_state.lastBrickDestroyedPos;
-        m_state.balls.clear();
-        m_state.powerups.clear();
-        return;
+    // Transição de wave do Rogue: o frame acabou ali (sem reacções de fim de frame).
+    if (result == SimulationSystem::StepResult::Played) {
+        const SimSnapshot before = m_simBefore;
+        updatePlayingAudio(
+            before.mode, before.type,
+            before.lives, before.wave,
+            before.endlessRows, before.danger,
+            before.streak
+        );
     }
+    m_simBefore = captureSimSnapshot();
 
-    // End overlay (Game Over / Win)
-    if (updateEndOverlay(input)) return;
-
-    // Frame principal (física, colisões, rogue/endless logic, score, música, etc.)
-    updatePlayingFrame(
-        input, dt,
-        modeBefore, typeBefore,
-        livesBefore, waveBefore,
-        endlessRowsBefore, dangerBefore,
-        streakBefore, hadPowerupBefore
-    );
+    return m_state.mode == GameMode::PLAYING && !m_state.winFinisherActive;
 }
 
 } // namespace game
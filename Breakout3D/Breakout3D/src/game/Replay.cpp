@@ -0,0 +1,395 @@
+// Replay.cpp
+/**
+ * @file Replay.cpp
+ * @brief Codificação/descodificação dos .b3dr, checksum do GameState e playback tick a tick.
+ */
+#include "game/Replay.hpp"
+#include "game/systems/InitSystem.hpp"
+#include "game/systems/SimulationSystem.hpp"
+#include "game/rogue/RogueCards.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+namespace game {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', '3', 'D', 'R'};
+constexpr std::uint16_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 4 + 2 + 1 + 1 + 8 + 8 + 4;
+
+struct Fnv {
+    std::uint64_t h = 1469598103934665603ULL;
+    void bytes(const void* p, std::size_t n) {
+        const unsigned char* b = (const unsigned char*)p;
+        for (std::size_t i = 0; i < n; ++i) { h ^= b[i]; h *= 1099511628211ULL; }
+    }
+    template <class T> void add(const T& v) { bytes(&v, sizeof(v)); }
+};
+
+void putU64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back((std::uint8_t)(v >> (8 * i)));
+}
+
+std::uint64_t getU64(const std::uint8_t* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (std::uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+} // namespace
+
+std::uint64_t replayStateChecksum(const GameState& s) {
+    Fnv f;
+    f.add(s.mode); f.add(s.score); f.add(s.lives); f.add(s.wave);
+    f.add(s.endlessStreakPoints); f.add(s.endlessRowsSpawned);
+    f.add(s.paddlePos.x); f.add(s.paddlePos.z);
+
+    const int balls = s.balls.size();
+    f.add(balls);
+    for (int i = 0; i < balls; ++i) {
+        f.add(s.balls.pos(i).x); f.add(s.balls.pos(i).z);
+        f.add(s.balls.vel(i).x); f.add(s.balls.vel(i).z);
+        f.add(s.balls.flags(i));
+    }
+
+    f.add(s.bricks.aliveCount());
+    f.add(s.bricks.scrollZ());
+    s.bricks.forEachAlive([&](int i) { f.add(i); f.add(s.bricks.hp(i)); });
+
+    f.add(s.powerups.size());
+    for (const auto& p : s.powerups) { f.add(p.type); f.add(p.pos.x); f.add(p.pos.z); }
+
+    f.add(s.expandTimer); f.add(s.slowTimer); f.add(s.fireballTimer);
+    f.add(s.shieldTimer); f.add(s.reverseTimer); f.add(s.tinyTimer);
+    f.add(s.rogueBricksBrokenThisWave); f.add(s.rogueWaveTimer);
+
+    f.add(s.rng.bricks); f.add(s.rng.drops); f.add(s.rng.wind); f.add(s.rng.cards); f.add(s.rng.fx);
+    return f.h;
+}
+
+std::uint64_t replayConfigHash(const GameConfig& cfg) {
+    static_assert(std::is_trivially_copyable<GameConfig>::value, "GameConfig tem de ser só dados (floats/ints/vec3)");
+    Fnv f;
+    f.bytes(&cfg, sizeof(cfg));
+    return f.h;
+}
+
+// ---------------------------------------------------------------------------
+// ReplayRecorder
+// ---------------------------------------------------------------------------
+void ReplayRecorder::begin(const GameState& state, const GameConfig& cfg, std::uint32_t checksumEvery) {
+    m_buf.clear();
+    m_buf.reserve(16 * 1024);
+    for (char c : kMagic) m_buf.push_back((std::uint8_t)c);
+    m_buf.push_back((std::uint8_t)(kVersion & 0xFF));
+    m_buf.push_back((std::uint8_t)(kVersion >> 8));
+    m_buf.push_back((std::uint8_t)state.gameType);
+    m_buf.push_back((std::uint8_t)state.currentLevel);
+    u64(state.rng.seed);
+    u64(replayConfigHash(cfg));
+    for (int i = 0; i < 4; ++i) m_buf.push_back((std::uint8_t)(checksumEvery >> (8 * i)));
+
+    m_active = true;
+    m_tick = 0;
+    m_lastTick = 0;
+    m_checksumEvery = checksumEvery;
+    m_dir = 0.0f;
+}
+
+// Op no nibble alto; delta de ticks no nibble baixo (15 = "continua num varint").
+void ReplayRecorder::op(ReplayOp o) {
+    const std::uint64_t delta = m_tick - m_lastTick;
+    u8((std::uint8_t)(((std::uint8_t)o << 4) | (delta < 15u ? delta : 15u)));
+    if (delta >= 15u) varint(delta - 15u);
+    m_lastTick = m_tick;
+}
+
+void ReplayRecorder::u64(std::uint64_t v) { putU64(m_buf, v); }
+
+void ReplayRecorder::f32(float v) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, 4);
+    for (int i = 0; i < 4; ++i) m_buf.push_back((std::uint8_t)(bits >> (8 * i)));
+}
+
+void ReplayRecorder::varint(std::uint64_t v) {
+    while (v >= 0x80u) {
+        m_buf.push_back((std::uint8_t)(v | 0x80u));
+        v >>= 7;
+    }
+    m_buf.push_back((std::uint8_t)v);
+}
+
+void ReplayRecorder::beforeStep(const GameState& state) {
+    if (!m_active || state.paddleInputDir == m_dir) return;
+    m_dir = state.paddleInputDir;
+    if (m_dir == -1.0f) op(ReplayOp::DirLeft);
+    else if (m_dir == 0.0f) op(ReplayOp::DirNone);
+    else if (m_dir == 1.0f) op(ReplayOp::DirRight);
+    else { op(ReplayOp::DirValue); f32(m_dir); }
+}
+
+void ReplayRecorder::afterStep(const GameState& state) {
+    if (!m_active) return;
+    ++m_tick;
+    if (m_checksumEvery > 0 && m_tick % m_checksumEvery == 0) {
+        op(ReplayOp::Check);
+        u64(replayStateChecksum(state));
+    }
+}
+
+void ReplayRecorder::launch(const glm::vec3& dir) {
+    if (!m_active) return;
+    op(ReplayOp::Launch);
+    f32(dir.x);
+    f32(dir.z);
+}
+
+void ReplayRecorder::pause() { if (m_active) op(ReplayOp::Pause); }
+void ReplayRecorder::resume() { if (m_active) op(ReplayOp::Resume); }
+
+void ReplayRecorder::pick(int slot, rogue::RogueCardId id) {
+    if (!m_active) return;
+    op(ReplayOp::Pick);
+    u8((std::uint8_t)slot);
+    u8((std::uint8_t)id);
+}
+
+std::vector<std::uint8_t> ReplayRecorder::finish(GameMode endMode) {
+    if (!m_active) return {};
+    op(ReplayOp::End);
+    u8((std::uint8_t)endMode);
+    m_active = false;
+    return m_buf; // cópia: o buffer fica para um `rewind` depois do fim
+}
+
+void ReplayRecorder::rewind(const Mark& m) {
+    if (m_buf.size() < kHeaderSize || m.bytes < kHeaderSize || m.bytes > m_buf.size()) return;
+    m_buf.resize((std::size_t)m.bytes);
+    m_tick = m.tick;
+    m_lastTick = m.lastTick;
+    m_dir = m.dir;
+    m_active = true;
+}
+
+// ---------------------------------------------------------------------------
+// ReplayPlayer
+// ---------------------------------------------------------------------------
+bool ReplayPlayer::load(std::vector<std::uint8_t> bytes, std::string* error) {
+    auto fail = [&](const char* msg) {
+        if (error) *error = msg;
+        m_buf.clear();
+        return false;
+    };
+    m_buf = std::move(bytes);
+    if (m_buf.size() < kHeaderSize || std::memcmp(m_buf.data(), kMagic, 4) != 0) return fail("not a .b3dr replay");
+
+    const std::uint8_t* p = m_buf.data() + 4;
+    std::uint16_t version = (std::uint16_t)(p[0] | (p[1] << 8));
+    if (version != kVersion) return fail("unsupported replay version");
+    if (p[2] > (std::uint8_t)GameType::LEVELS) return fail("bad game type");
+
+    m_header.type = (GameType)p[2];
+    m_header.level = p[3];
+    m_header.seed = getU64(p + 4);
+    m_header.configHash = getU64(p + 12);
+    m_header.checksumEvery = (std::uint32_t)(p[20] | (p[21] << 8) | (p[22] << 16) | ((std::uint32_t)p[23] << 24));
+    m_bodyStart = kHeaderSize;
+    m_c.pos = m_bodyStart;
+    return true;
+}
+
+bool ReplayPlayer::loadFile(const std::string& path, std::string* error) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    return load(std::move(bytes), error);
+}
+
+void ReplayPlayer::begin(GameState& state, const GameConfig& cfg) {
+    m_c = Cursor{};
+    m_c.pos = m_bodyStart;
+
+    state.gameType = m_header.type;
+    state.currentLevel = m_header.level;
+    state.wave = 1;
+    InitSystem::initGame(state, cfg, m_header.seed);
+    state.paddleInputDir = 0.0f;
+
+    m_c.hasNext = readNext();
+}
+
+bool ReplayPlayer::readNext() {
+    auto need = [&](std::size_t n) { return m_c.pos + n <= m_buf.size(); };
+    auto f32 = [&]() {
+        std::uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i) bits |= (std::uint32_t)m_buf[m_c.pos + i] << (8 * i);
+        m_c.pos += 4;
+        float v;
+        std::memcpy(&v, &bits, 4);
+        return v;
+    };
+
+    if (m_c.ended || !need(1)) { m_c.bad = !m_c.ended; return false; }
+    const std::uint8_t head = m_buf[m_c.pos++];
+    m_c.nextOp = (ReplayOp)(head >> 4);
+
+    std::uint64_t delta = head & 0x0Fu;
+    if (delta == 15u) {
+        std::uint64_t extra = 0;
+        for (int shift = 0;; shift += 7) {
+            if (!need(1) || shift > 63) { m_c.bad = true; return false; }
+            std::uint8_t b = m_buf[m_c.pos++];
+            extra |= (std::uint64_t)(b & 0x7Fu) << shift;
+            if (!(b & 0x80u)) break;
+        }
+        delta += extra;
+    }
+    m_c.nextTick += delta;
+
+    switch (m_c.nextOp) {
+    case ReplayOp::DirValue:
+        if (!need(4)) { m_c.bad = true; return false; }
+        m_c.nextF[0] = f32();
+        break;
+    case ReplayOp::Launch:
+        if (!need(8)) { m_c.bad = true; return false; }
+        m_c.nextF[0] = f32();
+        m_c.nextF[1] = f32();
+        break;
+    case ReplayOp::Pick:
+        if (!need(2)) { m_c.bad = true; return false; }
+        m_c.nextSlot = m_buf[m_c.pos];
+        m_c.nextU = m_buf[m_c.pos + 1];
+        m_c.pos += 2;
+        break;
+    case ReplayOp::Check:
+        if (!need(8)) { m_c.bad = true; return false; }
+        m_c.nextU = getU64(&m_buf[m_c.pos]);
+        m_c.pos += 8;
+        break;
+    case ReplayOp::End:
+        if (!need(1)) { m_c.bad = true; return false; }
+        m_c.endMode = (GameMode)m_buf[m_c.pos++];
+        m_c.ended = true;
+        break;
+    case ReplayOp::DirLeft:
+    case ReplayOp::DirNone:
+    case ReplayOp::DirRight:
+    case ReplayOp::Pause:
+    case ReplayOp::Resume:
+        break;
+    default:
+        m_c.bad = true;
+        return false;
+    }
+    return true;
+}
+
+void ReplayPlayer::desync() {
+    if (m_c.desyncTick < 0) m_c.desyncTick = (long long)m_c.tick;
+}
+
+void ReplayPlayer::applyInputs(GameState& state, const GameConfig& cfg) {
+    while (m_c.hasNext && !m_c.ended && m_c.nextTick == m_c.tick) {
+        switch (m_c.nextOp) {
+        case ReplayOp::DirLeft:  state.paddleInputDir = -1.0f; break;
+        case ReplayOp::DirNone:  state.paddleInputDir = 0.0f; break;
+        case ReplayOp::DirRight: state.paddleInputDir = 1.0f; break;
+        case ReplayOp::DirValue: state.paddleInputDir = m_c.nextF[0]; break;
+
+        case ReplayOp::Launch:
+            m_c.launches++;
+            if (SimulationSystem::launchAttached(state, cfg, glm::vec3(m_c.nextF[0], 0.0f, m_c.nextF[1])) == 0) desync();
+            break;
+
+        case ReplayOp::Pause:
+        case ReplayOp::Resume:
+            m_c.pauses += m_c.nextOp == ReplayOp::Pause;
+            break;
+
+        // Igual ao overlay de cartas (Game::updateRogueCardsOverlay).
+        case ReplayOp::Pick:
+            m_c.picks++;
+            if (state.mode != GameMode::ROGUE_CARDS || m_c.nextSlot >= state.rogueOfferCount ||
+                (std::uint64_t)state.rogueOffer[m_c.nextSlot] != m_c.nextU) {
+                desync();
+                break;
+            }
+            rogue::applyPickedCard(state, cfg, state.rogueOffer[m_c.nextSlot]);
+            if (state.mode == GameMode::PLAYING) state.rogueRowSpawnTimer = 0.15f;
+            break;
+
+        case ReplayOp::Check:
+            m_c.checks++;
+            if (replayStateChecksum(state) != m_c.nextU) desync();
+            break;
+
+        case ReplayOp::End:
+            break;
+        }
+        m_c.hasNext = readNext();
+    }
+    if (m_c.bad) desync();
+}
+
+bool ReplayPlayer::afterStep(const GameState& state) {
+    ++m_c.tick;
+    // Só os checksums deste tick: os inputs gravados no mesmo tick são do próximo passo.
+    while (m_c.hasNext && !m_c.ended && m_c.nextTick == m_c.tick && m_c.nextOp == ReplayOp::Check) {
+        m_c.checks++;
+        if (replayStateChecksum(state) != m_c.nextU) desync();
+        m_c.hasNext = readNext();
+    }
+    if (m_c.bad || (m_c.hasNext && m_c.nextTick < m_c.tick)) desync();
+    return m_c.desyncTick < 0;
+}
+
+// ---------------------------------------------------------------------------
+// Seek (keyframes no SnapshotRing)
+// ---------------------------------------------------------------------------
+void replayKeyframe(const ReplayPlayer& player, SnapshotRing& ring, const GameState& state) {
+    if (!ring.due(player.tick())) return;
+    SnapshotWriter w = ring.push(player.tick(), state);
+    w.pod(player.cursor());
+}
+
+std::uint64_t replaySeek(ReplayPlayer& player, SnapshotRing& ring, GameState& state, const GameConfig& cfg,
+                         std::uint64_t tick, float stepDt, SimEvents& scratch) {
+    if (tick < player.tick()) {
+        bool restored = false;
+        if (const int i = ring.find(tick); i >= 0) {
+            SnapshotReader r = ring.reader(i);
+            ReplayPlayer::Cursor c;
+            restored = loadSnapshot(state, r) && r.pod(c);
+            if (restored) player.setCursor(c);
+        }
+        if (!restored) {
+            player.begin(state, cfg);
+            ring.clear();
+            replayKeyframe(player, ring, state);
+        }
+    }
+
+    while (player.tick() < tick && !player.finished() && player.desyncTick() < 0) {
+        player.applyInputs(state, cfg);
+        if (state.mode != GameMode::PLAYING) break;
+
+        scratch.clear();
+        const auto result = SimulationSystem::step(state, cfg, stepDt, scratch);
+        player.afterStep(state);
+        replayKeyframe(player, ring, state);
+        if (result == SimulationSystem::StepResult::FieldCleared) break;
+    }
+    scratch.clear();
+    return player.tick();
+}
+
+} // namespace game
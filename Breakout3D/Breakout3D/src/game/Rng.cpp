@@ -0,0 +1,29 @@
+// Rng.cpp
+/**
+ * @file Rng.cpp
+ * @brief Seed por omissão das runs (o resto do PCG32 é inline no header).
+ */
+#include "game/Rng.hpp"
+
+#include <chrono>
+#include <random>
+
+namespace game {
+
+std::uint64_t RunRng::freshSeed() {
+    std::uint64_t s = (std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    try {
+        std::random_device rd;
+        s ^= ((std::uint64_t)rd() << 32) ^ (std::uint64_t)rd();
+    } catch (...) {
+        // sem random_device: fica só o relógio
+    }
+    // splitmix64: espalha os bits do relógio pelos 64 bits
+    s += 0x9e3779b97f4a7c15ULL;
+    s = (s ^ (s >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    s = (s ^ (s >> 27)) * 0x94d049bb133111ebULL;
+    s ^= s >> 31;
+    return s ? s : 1u;
+}
+
+} // namespace game
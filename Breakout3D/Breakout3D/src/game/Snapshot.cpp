@@ -0,0 +1,166 @@
+// Snapshot.cpp
+/**
+ * @file Snapshot.cpp
+ * @brief Save/restore do estado de simulação do GameState e o ring de snapshots.
+ *
+ * Notas:
+ *  - A lista de escalares está num só sítio (`visitScalars`), usada pelo save e pelo load: um campo
+ *    novo de gameplay no GameState entra aqui uma vez e `scalarBytes` no header muda sozinho.
+ *  - Se a lista mudar de forma incompatível (tipos, ordem), sobe `SnapshotHeader::version`.
+ */
+#include "game/Snapshot.hpp"
+#include "game/GameState.hpp"
+
+#include <algorithm>
+
+namespace game {
+
+namespace {
+
+// S = GameState ou const GameState; fn(campo) para cada escalar/POD de gameplay, sempre pela mesma ordem.
+template <class S, class Fn>
+void visitScalars(S& s, Fn&& fn) {
+    fn(s.mode); fn(s.gameType);
+    fn(s.lives); fn(s.score);
+    fn(s.rng);
+    fn(s.currentLevel);
+
+    fn(s.endlessStreakPoints); fn(s.endlessStreakPosPoints); fn(s.endlessStreakNegPoints);
+    fn(s.endlessStreakIdleTimer); fn(s.endlessStreakBanking); fn(s.endlessStreakBankTimer);
+    fn(s.wave); fn(s.bricksDestroyedThisWave); fn(s.endlessRowsSpawned); fn(s.pendingSpawnBricks);
+
+    fn(s.paddlePos); fn(s.paddlePrevPos); fn(s.paddleInputDir); fn(s.launchInputDir);
+
+    fn(s.expandTimer); fn(s.slowTimer); fn(s.fireballTimer);
+    fn(s.shieldTimer); fn(s.reverseTimer); fn(s.tinyTimer);
+    fn(s.fireballShakeTimer); fn(s.fireballShakeAnchorPos);
+    fn(s.pendingRespawnAfterFireball);
+    fn(s.spawnPingTimer); fn(s.endlessSpawnCooldown); fn(s.endlessAutoTimer); fn(s.endlessElapsedTime);
+
+    fn(s.rogueRewardEvery);
+    fn(s.rogueOffer); fn(s.rogueOfferCount);
+    fn(s.rogueStartingDraftRoundsLeft);
+    fn(s.rogueDropChanceMult); fn(s.rogueBasePaddleScaleX); fn(s.roguePaddleSpeedMult);
+    fn(s.rogueBallSpeedMult); fn(s.rogueBrickPointsMult); fn(s.rogueBankIdleMult);
+    fn(s.rogueBrickDamageBonus); fn(s.rogueFireballRadiusMult); fn(s.rogueShieldDurationMult);
+    fn(s.rogueLifeLossPenaltyBonus); fn(s.rogueRowsPerWaveDelta);
+    fn(s.rogueWindX); fn(s.rogueRandomWindActive); fn(s.rogueRandomWindTimer);
+    fn(s.roguePaddleClampMarginX); fn(s.rogueStickyPaddle);
+    fn(s.rogueMaxWaves);
+    fn(s.rogueBricksBrokenThisWave); fn(s.rogueWaveTimer); fn(s.rogueWaveCooldown); fn(s.rogueRowsSpawned);
+    fn(s.roguePendingRowsToSpawn); fn(s.rogueRowSpawnTimer); fn(s.rogueRowSpawnInterval);
+
+    fn(s.testOneBrick);
+    fn(s.endlessDangerActive); fn(s.endlessDangerTimer); fn(s.endlessDangerMaxZ);
+
+    fn(s.winFinisherActive); fn(s.winFinisherTimer); fn(s.winFinisherRealTimer);
+    fn(s.lastBrickDestroyedValid); fn(s.lastBrickDestroyedPos);
+    fn(s.winFinisherAnchorValid); fn(s.winFinisherAnchorPos);
+    fn(s.winFinisherHoldBrickValid); fn(s.winFinisherHoldBrickPos); fn(s.winFinisherHoldBrickSize);
+    fn(s.winFinisherHoldBrickMaxHp); fn(s.winFinisherHoldBrickHp);
+}
+
+std::uint32_t scalarBytes() {
+    static const std::uint32_t bytes = [] {
+        GameState probe;
+        std::uint32_t n = 0;
+        visitScalars(static_cast<const GameState&>(probe), [&](const auto& v) { n += (std::uint32_t)sizeof(v); });
+        return n;
+    }();
+    return bytes;
+}
+
+} // namespace
+
+void saveSnapshot(const GameState& s, SnapshotWriter& w) {
+    const std::size_t start = w.size();
+    SnapshotHeader h;
+    h.scalarBytes = scalarBytes();
+    w.pod(h);
+
+    visitScalars(s, [&](const auto& v) { w.pod(v); });
+
+    w.array(s.powerups);
+    w.array(s.fireballExplosions);
+    w.array(s.fireballShards);
+    w.array(s.scorePopups);
+    w.array(s.rogueChosen);
+    w.array(s.rogueDropDeck);
+    w.array(s.rogueRemainingNormal);
+    w.array(s.rogueRemainingOp);
+
+    s.balls.save(w);
+    s.bricks.save(w);
+
+    // Tamanho final no header (o writer pode crescer entretanto: escrever por offset, não por ponteiro).
+    h.bytes = (std::uint32_t)(w.size() - start);
+    std::memcpy(w.data() + start + offsetof(SnapshotHeader, bytes), &h.bytes, sizeof(h.bytes));
+}
+
+bool loadSnapshot(GameState& s, SnapshotReader& r) {
+    SnapshotHeader h, expected;
+    if (!r.pod(h) || std::memcmp(h.magic, expected.magic, 4) != 0 || h.version != expected.version ||
+        h.scalarBytes != scalarBytes() || h.bytes < sizeof(SnapshotHeader) ||
+        h.bytes - sizeof(SnapshotHeader) > r.remaining()) {
+        return false;
+    }
+
+    visitScalars(s, [&](auto& v) { r.pod(v); });
+
+    r.array(s.powerups);
+    r.array(s.fireballExplosions);
+    r.array(s.fireballShards);
+    r.array(s.scorePopups);
+    r.array(s.rogueChosen);
+    r.array(s.rogueDropDeck);
+    r.array(s.rogueRemainingNormal);
+    r.array(s.rogueRemainingOp);
+    if (!r.ok() || !s.balls.load(r) || !s.bricks.load(r)) return false;
+
+    // Eventos de áudio pendentes pertencem ao "presente" abandonado.
+    s.audioSpawnedPowerups.clear();
+    s.audioPickedPowerups.clear();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotRing
+// ---------------------------------------------------------------------------
+void SnapshotRing::reset(int capacity, std::uint32_t every) {
+    m_bufs.resize((std::size_t)std::max(1, capacity));
+    m_ticks.assign(m_bufs.size(), 0);
+    m_every = std::max(1u, every);
+    clear();
+}
+
+bool SnapshotRing::due(std::uint64_t tick) const {
+    if (m_bufs.empty() || tick % m_every != 0) return false;
+    return m_size == 0 || tick > tickAt(m_size - 1);
+}
+
+SnapshotWriter SnapshotRing::push(std::uint64_t tick, const GameState& state) {
+    if (m_size == (int)m_bufs.size()) {
+        m_first = (m_first + 1) % (int)m_bufs.size(); // recicla o mais antigo
+        m_size--;
+    }
+    const std::size_t k = slot(m_size++);
+    m_ticks[k] = tick;
+    SnapshotWriter w(m_bufs[k]);
+    saveSnapshot(state, w);
+    return w;
+}
+
+int SnapshotRing::find(std::uint64_t tick) const {
+    for (int i = m_size - 1; i >= 0; --i) {
+        if (tickAt(i) <= tick) return i;
+    }
+    return -1;
+}
+
+std::size_t SnapshotRing::memoryBytes() const {
+    std::size_t n = 0;
+    for (const auto& b : m_bufs) n += b.capacity();
+    return n;
+}
+
+} // namespace game
@@ -8,10 +8,11 @@
  *
  * Destaques:
  * - Rails laterais estendidos apenas no sentido da câmara (para dar "pista").
- * - Bricks escolhem mesh consoante HP atual (assets *hit variants).
+ * - Bricks num único draw instanced; HP atual escolhe a layer do texture array (*hit variants).
  * - Fireball tem trail barato sem histórico (offsets contra a velocidade).
  * - Powerups são meshes próprias, com tilt para a câmara + spin + bob.
  * - Alguns meshes recebem “correções” em render-space (ex: TINY virar barra).
+ * - Paddle/balls/powerups são desenhados entre os 2 últimos passos fixos (mix(prev, pos, ctx.simAlpha)).
  */
  #include "game/render/WorldRender.hpp"
  #include "game/GameAssets.hpp"
@@ -21,11 +22,17 @@
  
  #include <algorithm>
  #include <cmath>
+ #include <vector>
  #include <glm/glm.hpp>
  #include <glm/gtc/matrix_transform.hpp>
  
  namespace game::render {
  
+ // Posição interpolada entre o passo fixo anterior e o actual (entidades novas: sem histórico).
+ static glm::vec3 interpPos(const glm::vec3& prev, const glm::vec3& cur, bool hasPrev, float alpha) {
+     return hasPrev ? glm::mix(prev, cur, alpha) : cur;
+ }
+ 
  void renderWorld(const RenderContext& ctx, const GameState& state, const GameConfig& cfg, const GameAssets& assets) {
      // -------- 3D PASS content (camera já foi definida pelo caller) --------
      float arenaW = (cfg.arenaMaxX - cfg.arenaMinX);
@@ -33,6 +40,9 @@
      // Branco: não “pinta” a cena, só multiplica textura por 1.
      glm::vec3 tint(1.0f);
  
+     const float alpha = std::clamp(ctx.simAlpha, 0.0f, 1.0f);
+     const glm::vec3 paddlePos = interpPos(state.paddlePrevPos, state.paddlePos, true, alpha);
+ 
      // ---- Walls / Arena rails (extendidos na direção da câmara) ----
      float sideThickness = 1.2f;
      float topThickness  = 1.2f;
@@ -63,33 +73,18 @@
          tint
      );
  
-     // ---- Bricks: escolher mesh consoante hp/maxHp (hit variants) ----
-     auto pickBrickMesh = [&](int maxHp, int hp) -> const engine::Mesh* {
-         const engine::Mesh* m = &assets.brick01;
- 
-         if (maxHp == 4) {
-             if (hp == 4)      m = &assets.brick04;
-             else if (hp == 3) m = &assets.brick04_1hit;
-             else if (hp == 2) m = &assets.brick04_2hit;
-             else              m = &assets.brick04_3hit;
-         } else if (maxHp == 3) {
-             if (hp == 3)      m = &assets.brick03;
-             else if (hp == 2) m = &assets.brick03_1hit;
-             else              m = &assets.brick03_2hit;
-         } else if (maxHp == 2) {
-             if (hp == 2)      m = &assets.brick02;
-             else              m = &assets.brick02_1hit;
-         } else {
-             m = &assets.brick01;
-         }
-         return m;
-     };
- 
-     for (const auto& b : state.bricks) {
-         if (!b.alive) continue;
-         const engine::Mesh* m = pickBrickMesh(b.maxHp, b.hp);
-         ctx.renderer.drawMesh(*m, b.pos, b.size, tint);
-     }
+     // ---- Bricks: um draw instanced; hp/maxHp escolhe a layer (hit variants) ----
+     // Lista do renderer (reutilizada entre frames): em regime não aloca.
+     std::vector<engine::MeshInstance>& brickInstances = ctx.renderer.instanceScratch();
+     brickInstances.clear();
+     state.bricks.forEachAlive([&](int i) {
+         engine::MeshInstance inst;
+         inst.pos = state.bricks.center(i);
+         inst.layer = (float)GameAssets::brickLayer(state.bricks.maxHp(i), state.bricks.hp(i));
+         inst.size = state.bricks.size(i);
+         brickInstances.push_back(inst);
+     });
+     ctx.renderer.drawMeshInstanced(assets.brick01, assets.brickTexArray, brickInstances, tint);
  
      // ---- Fireball debris shards (visual feel de "break") ----
      if (!state.fireballShards.empty()) {
@@ -112,11 +107,11 @@
      if (state.expandTimer > 0.0f) currentPaddleSize.x *= cfg.expandScaleFactor;
      if (state.tinyTimer > 0.0f) currentPaddleSize.x *= cfg.tinyScaleFactor;
  
-     ctx.renderer.drawMesh(assets.paddle, state.paddlePos, currentPaddleSize, tint);
+     ctx.renderer.drawMesh(assets.paddle, paddlePos, currentPaddleSize, tint);
  
      // ---- Shield barrier (atrás do paddle) ----
      if (state.shieldTimer > 0.0f) {
-         float barrierZ = state.paddlePos.z + cfg.shieldOffsetZ;
+         float barrierZ = paddlePos.z + cfg.shieldOffsetZ;
          barrierZ = std::min(barrierZ, 19.0f);
  
          glm::vec3 barrierPos(0.0f, 0.0f, barrierZ);
@@ -128,10 +123,12 @@
      // ---- Balls (fireball vs normal) ----
      float ballD = cfg.ballRadius * 2.0f;
  
-     for (const auto& b : state.balls) {
+     for (int bi = 0; bi < state.balls.size(); ++bi) {
+         const Ball b = state.balls.get(bi);
+         const glm::vec3 bp = interpPos(b.prevPos, b.pos, b.hasPrev, alpha);
          if (b.isFireball) {
              glm::vec3 fireTint(1.00f, 0.55f, 0.15f);
-             ctx.renderer.drawMesh(assets.fireball, b.pos, glm::vec3(ballD), fireTint);
+             ctx.renderer.drawMesh(assets.fireball, bp, glm::vec3(ballD), fireTint);
  
              // Trail barato: N cópias no sentido oposto da velocidade
              float speed2 = b.vel.x * b.vel.x + b.vel.z * b.vel.z;
@@ -142,14 +139,14 @@
  
                  for (int i = 1; i <= trailCount; ++i) {
                      float u = (float)i / (float)(trailCount + 1);
-                     glm::vec3 tp = b.pos - dir * (spacing * (float)i);
+                     glm::vec3 tp = bp - dir * (spacing * (float)i);
                      float s = ballD * (0.90f - 0.55f * u);
                      glm::vec3 tcol(1.0f, 0.55f + 0.25f * (1.0f - u), 0.20f);
                      ctx.renderer.drawMesh(assets.fireball, tp, glm::vec3(s), tcol);
                  }
              }
          } else {
-             ctx.renderer.drawMesh(assets.ball, b.pos, glm::vec3(ballD), tint);
+             ctx.renderer.drawMesh(assets.ball, bp, glm::vec3(ballD), tint);
          }
      }
  
@@ -171,7 +168,7 @@
          else if (p.type == PowerUpType::TINY)        m = &assets.minus;
  
          glm::mat4 M(1.0f);
-         M = glm::translate(M, p.pos + glm::vec3(0, 0.5f + powerUpBob, 0));
+         M = glm::translate(M, interpPos(p.prevPos, p.pos, p.hasPrev, alpha) + glm::vec3(0, 0.5f + powerUpBob, 0));
          M = glm::rotate(M, powerUpTilt, glm::vec3(1, 0, 0));
  
          // Snail: roda mais 90º no Y para mostrar perfil.
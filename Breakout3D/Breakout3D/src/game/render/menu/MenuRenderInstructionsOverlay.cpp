@@ -190,7 +190,7 @@
              const engine::Mesh* mesh;
              glm::vec3 tint;
              float scale;
-             int videoIdx; // index into GameAssets::powerupVideoFrames
+             int videoIdx; // index into GameAssets::powerupVideos
          };
  
          // Lista de entries (ordem = ordem de navegação no inspector).
@@ -302,13 +302,12 @@
              m.ctx.renderer.drawUIQuad(V.x - bt, V.y, bt, V.h, glm::vec4(1,1,1,0.12f));
              m.ctx.renderer.drawUIQuad(V.x + V.w, V.y, bt, V.h, glm::vec4(1,1,1,0.12f));
  
-             // Procurar frames “pré-extraídos” (GameAssets::powerupVideo).
-             const auto& gif = m.assets.powerupVideo(e.videoIdx);
+             // Frame actual do preview em streaming (layer do texture array; loop interno do gif).
+             engine::StreamingGif* gif = m.assets.powerupVideo(e.videoIdx);
+             int videoLayer = gif ? gif->frameAtTime(m.ctx.time.now()) : -1;
  
-             if (!gif.empty()) {
-                 // Frame actual baseado no tempo (loop interno do gif).
-                 const auto& fr = gif.frameAtTime(m.ctx.time.now());
-                 m.ctx.renderer.drawUIQuad(V.x, V.y, V.w, V.h, glm::vec4(1,1,1,1), fr.id);
+             if (videoLayer >= 0) {
+                 m.ctx.renderer.drawUIQuadLayer(V.x, V.y, V.w, V.h, glm::vec4(1,1,1,1), gif->texture(), videoLayer);
              } else {
                  // Placeholder: indica se falta path ou se está “a carregar”.
                  std::string ph = m.assets.powerupVideoPaths[e.videoIdx].empty()
@@ -223,8 +223,9 @@
      // Oferta:
      // - NÃO remove do pool só por aparecer.
      // - Garante cartas únicas dentro da oferta (partial shuffle).
-     std::vector<RogueCardId> eligible;
-     eligible.reserve(pool.size());
+     // Scratch reutilizado entre ofertas (thread_local: a simulação pode ter o seu thread).
+     static thread_local std::vector<RogueCardId> eligible, tmp;
+     eligible.clear();
      for (auto id : pool) {
          if (isEligibleForWave(id, opPack, waveProgress)) eligible.push_back(id);
      }
@@ -232,9 +233,9 @@
      int n = std::min(count, (int)eligible.size());
      if (n <= 0) return;
  
-     std::vector<RogueCardId> tmp = eligible;
+     tmp = eligible;
      for (int i = 0; i < n; ++i) {
-         int j = i + (rand() % (int)(tmp.size() - i));
+         int j = i + state.rng.cards.range((int)(tmp.size() - i));
          std::swap(tmp[(size_t)i], tmp[(size_t)j]);
  
          state.rogueOffer[i] = tmp[(size_t)i];
@@ -253,13 +254,15 @@
  // Add ao deck de drops, sem duplicados.
  static void addDrop(GameState& state, PowerUpType t) {
      if (std::find(state.rogueDropDeck.begin(), state.rogueDropDeck.end(), t) == state.rogueDropDeck.end()) {
-         state.rogueDropDeck.push_back(t);
+         state.rogueDropDeck.push(t);
      }
  }
  
  // Guarda histórico de picks (para HUD/inspector/debug).
  static void markChosen(GameState& state, RogueCardId id) {
-     state.rogueChosen.push_back(id);
+     static_assert(sizeof(kDefs) / sizeof(kDefs[0]) <= decltype(GameState::rogueChosen)::capacity(),
+                   "rogueChosen: capacidade abaixo do nº de cartas");
+     state.rogueChosen.push(id);
  }
  
  // Powerup card: adiciona ao deck + dá o powerup agora (efeito imediato).
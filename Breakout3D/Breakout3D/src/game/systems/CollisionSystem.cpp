@@ -3,12 +3,20 @@
  * @brief Colisões principais do jogo (paredes, paddle, bricks).
  *
  * Resumo:
- *  - handleWorldCollisions(): bounces nas paredes (X e Z “top”).
- *  - handlePaddleCollision(): colisão bola-paddle em XZ, com bounce + ângulo.
- *    Inclui regra Rogue: "sticky paddle" (cola a bola ao bater na frente).
- *  - handleBrickCollisions(): colisões com bricks:
- *    - normal hit: dano (com bonus Rogue), score/bank, drops
- *    - fireball hit: explosão AoE, shards, ring FX, e mata a bola de fireball
+ *  - moveBall(): integra a bola com CCD (swept sphere em XZ). Em cada iteração procura o
+ *    primeiro contacto (time of impact) contra paredes, shield, paddle e bricks (candidatos do
+ *    BrickGrid ao longo do segmento, filtrados por BrickField::sweptCandidates), avança até lá,
+ *    responde e continua com o tempo que sobra.
+ *    Vários bounces por passo, sem túneis a qualquer velocidade/dt.
+ *  - moveBalls(): todas as bolas; as que estão em voo livre vão pelo kernel SoA do BallSet
+ *    (integração + paredes, 4 bolas por instrução), as outras pelo moveBall.
+ *  - paredes: X e Z “top”; shield: plano atrás do paddle (só a bola a ir para +Z).
+ *  - paddle: bounce + ângulo pelo hitX. Regra Rogue: "sticky paddle" (cola a bola ao bater na frente).
+ *  - bricks:
+ *    - normal hit: dano (com bonus Rogue), score/bank, drops, reflexão pela normal do contacto
+ *    - fireball hit: explosão AoE (BrickField::queryCircle: scan SoA em lote), shards, ring FX, e mata a bola de fireball
+ *  - Sem cooldown entre hits: o contacto deixa a bola fora do brick e a afastar-se, por isso
+ *    não há multi-hits fantasma (e duas bolas podem acertar no mesmo passo).
  */
  #include "game/systems/CollisionSystem.hpp"
  #include "game/entities/Brick.hpp"
@@ -17,6 +25,8 @@
  
  #include <algorithm>
  #include <cmath>
+ #include <limits>
+ #include <vector>
  #include <glm/glm.hpp>
  #include <glm/gtc/constants.hpp>
  
@@ -24,58 +34,93 @@
      return std::max(a, std::min(v, b));
  }
  
- /**
-  * @brief Teste de interseção esfera vs AABB no plano XZ.
-  * - Ignora Y (o jogo é “2.5D” em termos de colisão para bola/bricks/paddle).
-  */
- static bool sphereAabbXZ(const glm::vec3& c, float r,
-                          const glm::vec3& bpos, const glm::vec3& bsize) {
-     float hx = bsize.x * 0.5f;
-     float hz = bsize.z * 0.5f;
- 
-     float minX = bpos.x - hx, maxX = bpos.x + hx;
-     float minZ = bpos.z - hz, maxZ = bpos.z + hz;
- 
-     float cx = clampf(c.x, minX, maxX);
-     float cz = clampf(c.z, minZ, maxZ);
- 
-     float dx = c.x - cx;
-     float dz = c.z - cz;
-     return (dx * dx + dz * dz) <= (r * r);
- }
- 
  namespace game {
  
- bool CollisionSystem::handleWorldCollisions(Ball& ball, const GameConfig& cfg) {
-     bool hit = false;
- 
-     // Left wall
-     if (ball.pos.x - cfg.ballRadius < cfg.arenaMinX) {
-         ball.pos.x = cfg.arenaMinX + cfg.ballRadius;
-         ball.vel.x = std::abs(ball.vel.x);
-         hit = true;
+ // Folga ao sair de um contacto (evita voltar a tocar por arredondamento).
+ static constexpr float kContactSkin = 0.002f;
+ 
+ // Contactos máximos por bola por passo (cantos apertados; acima disto a bola pára o resto do passo).
+ static constexpr int kMaxContactsPerStep = 8;
+ 
+ bool CollisionSystem::sweepSphereAabbXZ(const glm::vec3& p, const glm::vec3& d, float r,
+                                         float minX, float maxX, float minZ, float maxZ,
+                                         float& tHit, glm::vec2& normal) {
+     // Já em contacto no início: t = 0, normal a partir do ponto mais próximo.
+     float cx = clampf(p.x, minX, maxX);
+     float cz = clampf(p.z, minZ, maxZ);
+     float ox = p.x - cx, oz = p.z - cz;
+     if (ox * ox + oz * oz <= r * r) {
+         if (ox * ox + oz * oz > 1e-12f) {
+             float len = std::sqrt(ox * ox + oz * oz);
+             normal = glm::vec2(ox / len, oz / len);
+         } else {
+             // centro dentro do AABB: eixo dominante vs o centro (como o bounce discreto antigo)
+             float hx = std::max(1e-4f, (maxX - minX) * 0.5f), hz = std::max(1e-4f, (maxZ - minZ) * 0.5f);
+             float rx = (p.x - (minX + maxX) * 0.5f) / hx;
+             float rz = (p.z - (minZ + maxZ) * 0.5f) / hz;
+             normal = (std::abs(rx) > std::abs(rz)) ? glm::vec2(rx >= 0.0f ? 1.0f : -1.0f, 0.0f)
+                                                    : glm::vec2(0.0f, rz >= 0.0f ? 1.0f : -1.0f);
+         }
+         tHit = 0.0f;
+         return true;
      }
-     // Right wall
-     if (ball.pos.x + cfg.ballRadius > cfg.arenaMaxX) {
-         ball.pos.x = cfg.arenaMaxX - cfg.ballRadius;
-         ball.vel.x = -std::abs(ball.vel.x);
-         hit = true;
+ 
+     // Raio contra o AABB expandido por r (slabs); depois trata os cantos arredondados.
+     float tEnter = 0.0f, tExit = 1.0f;
+     int axis = -1;
+     const float lo[2] = { minX - r, minZ - r };
+     const float hi[2] = { maxX + r, maxZ + r };
+     const float o[2] = { p.x, p.z };
+     const float v[2] = { d.x, d.z };
+     for (int k = 0; k < 2; ++k) {
+         if (std::abs(v[k]) < 1e-12f) {
+             if (o[k] < lo[k] || o[k] > hi[k]) return false;
+             continue;
+         }
+         float inv = 1.0f / v[k];
+         float t0 = (lo[k] - o[k]) * inv;
+         float t1 = (hi[k] - o[k]) * inv;
+         if (t0 > t1) std::swap(t0, t1);
+         if (t0 > tEnter) { tEnter = t0; axis = k; }
+         tExit = std::min(tExit, t1);
+         if (tEnter > tExit) return false;
      }
-     // Top wall (front wall)
-     if (ball.pos.z - cfg.ballRadius < cfg.arenaMinZ) {
-         ball.pos.z = cfg.arenaMinZ + cfg.ballRadius;
-         ball.vel.z = std::abs(ball.vel.z);
-         hit = true;
+     // axis < 0: o início já está dentro do AABB expandido, numa zona de canto (senão havia
+     // sobreposição) -> só o círculo desse canto pode dar contacto.
+     float qx = p.x + d.x * tEnter;
+     float qz = p.z + d.z * tEnter;
+     bool inX = (qx >= minX && qx <= maxX);
+     bool inZ = (qz >= minZ && qz <= maxZ);
+     if (axis >= 0 && (inX || inZ)) {
+         // face
+         normal = (axis == 0) ? glm::vec2(v[0] > 0.0f ? -1.0f : 1.0f, 0.0f)
+                              : glm::vec2(0.0f, v[1] > 0.0f ? -1.0f : 1.0f);
+         tHit = tEnter;
+         return true;
      }
  
-     return hit;
+     // canto: raio contra o círculo de raio r no vértice mais próximo do ponto de entrada
+     float kx = (qx < minX) ? minX : maxX;
+     float kz = (qz < minZ) ? minZ : maxZ;
+     float mx = p.x - kx, mz = p.z - kz;
+     float a = d.x * d.x + d.z * d.z;
+     float bq = mx * d.x + mz * d.z;
+     float c = mx * mx + mz * mz - r * r;
+     float disc = bq * bq - a * c;
+     if (a < 1e-12f || disc < 0.0f) return false;
+     float t = (-bq - std::sqrt(disc)) / a;
+     if (t < 0.0f || t > 1.0f) return false;
+ 
+     float hx = p.x + d.x * t - kx, hz = p.z + d.z * t - kz;
+     float len = std::max(1e-6f, std::sqrt(hx * hx + hz * hz));
+     normal = glm::vec2(hx / len, hz / len);
+     tHit = t;
+     return true;
  }
  
- bool CollisionSystem::handlePaddleCollision(Ball& ball, const GameState& state,
-                                             const glm::vec3& paddlePos,
-                                             const glm::vec3& paddleSize,
-                                             const GameConfig& cfg) {
-     // AABB do paddle (XZ)
+ // Resposta da bola ao paddle (bola já em contacto). Devolve sempre true (houve hit).
+ static bool respondPaddle(Ball& ball, const GameState& state, const glm::vec3& paddlePos,
+                           const glm::vec3& paddleSize, const GameConfig& cfg) {
      float halfZ = paddleSize.z * 0.5f;
      float paddleHalfX = paddleSize.x * 0.5f;
      float minX = paddlePos.x - paddleHalfX;
@@ -90,301 +135,449 @@
      float dx = ball.pos.x - cx;
      float dz = ball.pos.z - cz;
  
-     // hit sphere vs AABB
-     if (dx*dx + dz*dz <= cfg.ballRadius*cfg.ballRadius) {
-         // Resolve por eixo dominante (para evitar “stuck” em cantos)
-         float ax = std::abs(dx);
-         float az = std::abs(dz);
+     // Resolve por eixo dominante (para evitar “stuck” em cantos)
+     float ax = std::abs(dx);
+     float az = std::abs(dz);
+ 
+     float speed = glm::length(glm::vec2(ball.vel.x, ball.vel.z));
+     if (speed < 1e-4f) speed = cfg.ballSpeed;
+ 
+     // Tende a resolver em Z (mais “breakout feel”), salvo quando X é muito maior
+     bool resolveX = (ax > az * 1.05f);
+ 
+     if (resolveX) {
+         // bateu num lado do paddle -> inverte X
+         ball.vel.x = -ball.vel.x;
+         float sideSign = (ball.pos.x < cx) ? -1.0f : 1.0f;
+         ball.pos.x = cx + sideSign * (cfg.ballRadius + kContactSkin);
+     } else {
+         // bateu na frente/atrás -> inverte Z + “angle control” pelo hitX
+         bool frontSide = (ball.pos.z < paddlePos.z);
+ 
+         // Rogue: sticky paddle (só na frente, só se a bola vem em direção ao paddle, e não em fireball)
+         if (frontSide && ball.vel.z > 0.0f &&
+             state.gameType == GameType::ROGUE && state.rogueStickyPaddle && !ball.isFireball) {
+             ball.attached = true;
+             ball.vel = glm::vec3(0.0f);
+             ball.pos.z = minZ - cfg.ballRadius - kContactSkin;
+             return true;
+         }
  
-         float speed = glm::length(glm::vec2(ball.vel.x, ball.vel.z));
-         if (speed < 1e-4f) speed = cfg.ballSpeed;
+         float t = (ball.pos.x - paddlePos.x) / std::max(0.001f, paddleHalfX);
+         t = clampf(t, -1.0f, 1.0f);
+         float ang = t * glm::radians(60.0f);
  
-         // Tende a resolver em Z (mais “breakout feel”), salvo quando X é muito maior
-         bool resolveX = (ax > az * 1.05f);
+         ball.vel.x = std::sin(ang) * speed;
+         ball.vel.z = (frontSide ? -std::cos(ang) : std::cos(ang)) * speed;
  
-         if (resolveX) {
-             // bateu num lado do paddle -> inverte X
-             ball.vel.x = -ball.vel.x;
-             float sideSign = (ball.pos.x < cx) ? -1.0f : 1.0f;
-             ball.pos.x = cx + sideSign * (cfg.ballRadius + 0.002f);
-         } else {
-             // bateu na frente/atrás -> inverte Z + “angle control” pelo hitX
-             bool frontSide = (ball.pos.z < paddlePos.z);
- 
-             // Rogue: sticky paddle (só na frente, só se a bola vem em direção ao paddle, e não em fireball)
-             if (frontSide && ball.vel.z > 0.0f &&
-                 state.gameType == GameType::ROGUE && state.rogueStickyPaddle && !ball.isFireball) {
-                 ball.attached = true;
-                 ball.vel = glm::vec3(0.0f);
-                 ball.pos.z = minZ - cfg.ballRadius - 0.002f;
-                 return true;
-             }
+         ball.pos.z = (frontSide ? (minZ - cfg.ballRadius - kContactSkin)
+                                 : (maxZ + cfg.ballRadius + kContactSkin));
+     }
  
-             float t = (ball.pos.x - paddlePos.x) / std::max(0.001f, paddleHalfX);
-             t = clampf(t, -1.0f, 1.0f);
-             float ang = t * glm::radians(60.0f);
+     return true;
+ }
+ 
+ // Impacto no brick `bi` (bola em contacto, `normal` a apontar do brick para a bola).
+ static CollisionSystem::BrickCollisionInfo applyBrickHit(Ball& ball, GameState& state, const GameConfig& cfg,
+                                                          int bi, const glm::vec2& normal) {
+     CollisionSystem::BrickCollisionInfo info;
+     BrickField& field = state.bricks;
+ 
+     const glm::vec3 brPos = field.center(bi);
+     const glm::vec3 brSize = field.size(bi);
+     const int brMaxHp = field.maxHp(bi);
+ 
+     info.hit = true;
+     const bool fireballActive = ball.isFireball;
+     info.fireball = fireballActive;
+     info.hpBefore = field.hp(bi);
+     info.maxHp = brMaxHp;
+ 
+     // --- Helpers de scoring ---
+     auto brickPoints = [&](int hp) -> int {
+         // hp 1..6 (endless pode ir até 6)
+         switch (hp) {
+             case 1: return 50;
+             case 2: return 120;
+             case 3: return 220;
+             case 4: return 350;
+             case 5: return 500;
+             default: return 700;
+         }
+     };
  
-             ball.vel.x = std::sin(ang) * speed;
-             ball.vel.z = (frontSide ? -std::cos(ang) : std::cos(ang)) * speed;
+     auto awardBrickPoints = [&](int maxHp, bool immediateScore) -> int {
+         int baseScore = brickPoints(maxHp);
+         int waveBonus = (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE)
+                         ? (state.wave * 25) : 0;
  
-             ball.pos.z = (frontSide ? (minZ - cfg.ballRadius - 0.002f)
-                                     : (maxZ + cfg.ballRadius + 0.002f));
+         int pts = baseScore + waveBonus;
+ 
+         if (state.gameType == GameType::ROGUE) {
+             pts = (int)std::round((float)pts * state.rogueBrickPointsMult);
          }
  
-         return true;
-     }
+         // Endless/Rogue: vai para streak bank (a não ser hits “imediatos” tipo fireball)
+         if (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) {
+             if (immediateScore) {
+                 state.score += pts;
+                 return pts;
+             }
  
-     return false;
- }
+             state.endlessStreakPoints += pts;
+             state.endlessStreakPosPoints += pts;
+             state.endlessStreakIdleTimer = 0.0f;
+             state.endlessStreakBanking = false;
+             state.endlessStreakBankTimer = 0.0f;
  
- CollisionSystem::BrickCollisionInfo CollisionSystem::handleBrickCollisions(Ball& ball, GameState& state, const GameConfig& cfg) {
-     BrickCollisionInfo info;
+             if (state.gameType == GameType::ENDLESS) {
+                 // lógica de spawn por “quota” de bricks destruídos
+                 state.bricksDestroyedThisWave++;
  
-     // pequeno cooldown para evitar multi-hits no mesmo frame/instante
-     if (state.brickHitCooldown > 0.0f) {
-         return info;
-     }
+                 const float t = state.endlessElapsedTime;
+                 float u = (t <= 120.0f) ? 0.0f : std::min(1.0f, (t - 120.0f) / 480.0f); // 2min->10min
+                 int required = (int)std::round(22.0f - (7.0f * u)); // 22 -> 15
+                 required = std::max(15, std::min(22, required));
  
-     for (auto& br : state.bricks) {
-         if (!br.alive) continue;
- 
-         if (sphereAabbXZ(ball.pos, cfg.ballRadius, br.pos, br.size)) {
-             info.hit = true;
-             const bool fireballActive = ball.isFireball;
-             info.fireball = fireballActive;
-             info.hpBefore = br.hp;
-             info.maxHp = br.maxHp;
- 
-             // --- Helpers de scoring ---
-             auto brickPoints = [&](int hp) -> int {
-                 // hp 1..6 (endless pode ir até 6)
-                 switch (hp) {
-                     case 1: return 50;
-                     case 2: return 120;
-                     case 3: return 220;
-                     case 4: return 350;
-                     case 5: return 500;
-                     default: return 700;
+                 if (state.bricksDestroyedThisWave >= required) {
+                     state.pendingSpawnBricks += 12;
+                     state.bricksDestroyedThisWave -= required;
                  }
-             };
+             }
+         } else {
+             // Normal/Levels: score direto
+             state.score += pts;
+         }
  
-             auto awardBrickPoints = [&](int maxHp, bool immediateScore) -> int {
-                 int baseScore = brickPoints(maxHp);
-                 int waveBonus = (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE)
-                                 ? (state.wave * 25) : 0;
+         return pts;
+     };
  
-                 int pts = baseScore + waveBonus;
+     // Mata brick + drop + progress + anchor de VFX
+     auto killBrick = [&](int idx, bool allowPowerupDrop) -> int {
+         if (!field.alive(idx)) return 0;
+         field.kill(idx);
+         info.bricksKilled += 1;
  
-                 if (state.gameType == GameType::ROGUE) {
-                     pts = (int)std::round((float)pts * state.rogueBrickPointsMult);
-                 }
+         const glm::vec3 pos = field.center(idx);
  
-                 // Endless/Rogue: vai para streak bank (a não ser hits “imediatos” tipo fireball)
-                 if (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) {
-                     if (immediateScore) {
-                         state.score += pts;
-                         return pts;
-                     }
- 
-                     state.endlessStreakPoints += pts;
-                     state.endlessStreakPosPoints += pts;
-                     state.endlessStreakIdleTimer = 0.0f;
-                     state.endlessStreakBanking = false;
-                     state.endlessStreakBankTimer = 0.0f;
- 
-                     if (state.gameType == GameType::ENDLESS) {
-                         // lógica de spawn por “quota” de bricks destruídos
-                         state.bricksDestroyedThisWave++;
- 
-                         const float t = state.endlessElapsedTime;
-                         float u = (t <= 120.0f) ? 0.0f : std::min(1.0f, (t - 120.0f) / 480.0f); // 2min->10min
-                         int required = (int)std::round(22.0f - (7.0f * u)); // 22 -> 15
-                         required = std::max(15, std::min(22, required));
- 
-                         if (state.bricksDestroyedThisWave >= required) {
-                             state.pendingSpawnBricks += 12;
-                             state.bricksDestroyedThisWave -= required;
-                         }
-                     }
-                 } else {
-                     // Normal/Levels: score direto
-                     state.score += pts;
-                 }
+         // âncora de VFX (último brick partido)
+         state.lastBrickDestroyedValid = true;
+         state.lastBrickDestroyedPos = pos;
  
-                 return pts;
-             };
+         // Rogue: quota por wave
+         if (state.gameType == GameType::ROGUE) {
+             state.rogueBricksBrokenThisWave++;
+         }
  
-             // Mata brick + drop + progress + anchor de VFX
-             auto killBrick = [&](Brick& b, bool allowPowerupDrop) -> int {
-                 if (!b.alive) return 0;
-                 b.alive = false;
-                 info.bricksKilled += 1;
+         // Drops (com base Rogue diferente)
+         if (allowPowerupDrop) {
+             float chance = cfg.powerUpChance;
+             if (state.gameType == GameType::ROGUE) {
+                 chance = game::rogue::effectiveDropChance(state, cfg);
+             }
+             PowerUpSystem::spawnPowerUp(state, pos, chance);
+         }
  
-                 // âncora de VFX (último brick partido)
-                 state.lastBrickDestroyedValid = true;
-                 state.lastBrickDestroyedPos = b.pos;
+         // fireball mete pontos imediatamente (para o popup e feedback)
+         return awardBrickPoints(field.maxHp(idx), fireballActive);
+     };
  
-                 // Rogue: quota por wave
-                 if (state.gameType == GameType::ROGUE) {
-                     state.rogueBricksBrokenThisWave++;
-                 }
+     // -------- FIREBALL PATH (AoE + mata a bola) --------
+     if (fireballActive) {
+         int explosionPts = 0;
  
-                 // Drops (com base Rogue diferente)
-                 if (allowPowerupDrop) {
-                     float chance = cfg.powerUpChance;
-                     if (state.gameType == GameType::ROGUE) {
-                         chance = game::rogue::effectiveDropChance(state, cfg);
-                     }
-                     PowerUpSystem::spawnPowerUp(state, b.pos, chance);
-                 }
+         float r = cfg.fireballExplosionRadius;
+         if (state.gameType == GameType::ROGUE) {
+             r *= std::max(0.25f, state.rogueFireballRadiusMult);
+         }
+
+         // mata vizinhos com o centro dentro do raio (scan SoA em lote por ordem de slot)
+         static thread_local std::vector<int> aoe;
+         if (aoe.capacity() == 0) aoe.reserve(256); // o scan reserva espaço para todos os vivos
+         field.queryCircle(brPos.x, brPos.z, r, aoe);
+         for (int oi : aoe) {
+             if (!field.alive(oi)) continue;
+             // só o brick diretamente atingido pode dar drop (anti-flood)
+             bool allowDrop = (oi == bi);
+             int got = killBrick(oi, allowDrop);
+             if (got > 0) explosionPts += got;
+         }
  
-                 // fireball mete pontos imediatamente (para o popup e feedback)
-                 return awardBrickPoints(b.maxHp, fireballActive);
-             };
+         // Normal: se foi o último brick, guarda “snapshot” para o finisher
+         if (state.gameType == GameType::NORMAL && state.mode == GameMode::PLAYING) {
+             if (field.aliveCount() == 0) {
+                 state.winFinisherHoldBrickValid = true;
+                 state.winFinisherHoldBrickPos = brPos;
+                 state.winFinisherHoldBrickSize = brSize;
+                 state.winFinisherHoldBrickMaxHp = brMaxHp;
+                 state.winFinisherHoldBrickHp = 1;
+             }
+         }
  
-             // -------- FIREBALL PATH (AoE + mata a bola) --------
-             if (fireballActive) {
-                 int explosionPts = 0;
+         // FX: ring + popup (endless)
+         state.fireballExplosions.push({ brPos, 0.0f });
+         if (explosionPts > 0) {
+             if (state.gameType == GameType::ENDLESS) {
+                 state.scorePopups.push({ explosionPts, 0.0f });
+             }
+         }
  
-                 float r = cfg.fireballExplosionRadius;
-                 if (state.gameType == GameType::ROGUE) {
-                     r *= std::max(0.25f, state.rogueFireballRadiusMult);
-                 }
-                 float r2 = r * r;
- 
-                 // mata vizinhos dentro do raio
-                 for (auto& other : state.bricks) {
-                     if (!other.alive) continue;
-                     float dx = other.pos.x - br.pos.x;
-                     float dz = other.pos.z - br.pos.z;
-                     if ((dx * dx + dz * dz) <= r2) {
-                         // só o brick diretamente atingido pode dar drop (anti-flood)
-                         bool allowDrop = (&other == &br);
-                         int got = killBrick(other, allowDrop);
-                         if (got > 0) explosionPts += got;
-                     }
-                 }
+         // FX: camera shake + shards
+         state.fireballShakeTimer = cfg.fireballShakeDuration;
+         state.fireballShakeAnchorPos = brPos;
+         {
+             auto frand = [&]() -> float { return state.rng.fx.uniform(); };
+             for (int i = 0; i < cfg.fireballShardCount; ++i) {
+                 float a = frand() * glm::two_pi<float>();
+                 float rr = 0.15f + frand() * 0.55f;
+                 glm::vec3 p = brPos + glm::vec3(std::cos(a) * rr,
+                                                  0.12f + frand() * 0.18f,
+                                                  std::sin(a) * rr);
+ 
+                 float dirA = frand() * glm::two_pi<float>();
+                 float sp = cfg.fireballShardSpeed * (0.65f + frand() * 0.55f);
+                 glm::vec3 v(std::cos(dirA) * sp,
+                            cfg.fireballShardUp * (0.65f + frand() * 0.55f),
+                            std::sin(dirA) * sp);
+ 
+                 GameState::FireballShard s;
+                 s.pos = p;
+                 s.vel = v;
+                 s.t = 0.0f;
+                 state.fireballShards.push(s); // pool cheia: os restantes não aparecem
+             }
+         }
  
-                 // Normal: se foi o último brick, guarda “snapshot” para o finisher
-                 if (state.gameType == GameType::NORMAL && state.mode == GameMode::PLAYING) {
-                     bool anyAlive = false;
-                     for (const auto& b : state.bricks) {
-                         if (b.alive) { anyAlive = true; break; }
-                     }
-                     if (!anyAlive) {
-                         state.winFinisherHoldBrickValid = true;
-                         state.winFinisherHoldBrickPos = br.pos;
-                         state.winFinisherHoldBrickSize = br.size;
-                         state.winFinisherHoldBrickMaxHp = br.maxHp;
-                         state.winFinisherHoldBrickHp = 1;
-                     }
-                 }
+         // Fireball é one-shot: apaga a bola e sinaliza respawn
+         ball.alive = false;
+         ball.isFireball = false;
+         ball.vel = glm::vec3(0.0f);
+         state.pendingRespawnAfterFireball = true;
  
-                 // FX: ring + popup (endless)
-                 state.fireballExplosions.push_back({ br.pos, 0.0f });
-                 if (explosionPts > 0) {
-                     if (state.gameType == GameType::ENDLESS) {
-                         state.scorePopups.push_back({ explosionPts, 0.0f });
-                     }
-                 }
+         info.broke = (info.bricksKilled > 0);
+         info.hpAfter = 0;
+         return info;
+     }
  
-                 // FX: camera shake + shards
-                 state.fireballShakeTimer = cfg.fireballShakeDuration;
-                 state.fireballShakeAnchorPos = br.pos;
-                 {
-                     auto frand = []() -> float { return (float)rand() / (float)RAND_MAX; };
-                     for (int i = 0; i < cfg.fireballShardCount; ++i) {
-                         float a = frand() * glm::two_pi<float>();
-                         float rr = 0.15f + frand() * 0.55f;
-                         glm::vec3 p = br.pos + glm::vec3(std::cos(a) * rr,
-                                                          0.12f + frand() * 0.18f,
-                                                          std::sin(a) * rr);
- 
-                         float dirA = frand() * glm::two_pi<float>();
-                         float sp = cfg.fireballShardSpeed * (0.65f + frand() * 0.55f);
-                         glm::vec3 v(std::cos(dirA) * sp,
-                                    cfg.fireballShardUp * (0.65f + frand() * 0.55f),
-                                    std::sin(dirA) * sp);
- 
-                         GameState::FireballShard s;
-                         s.pos = p;
-                         s.vel = v;
-                         s.t = 0.0f;
-                         state.fireballShards.push_back(s);
-                     }
+     // -------- NORMAL PATH (dano + bounce) --------
+     {
+         int dmg = 1;
+         if (state.gameType == GameType::ROGUE) {
+             dmg += std::max(0, state.rogueBrickDamageBonus);
+         }
+ 
+         const int hpAfter = field.hp(bi) - dmg;
+         field.setHp(bi, hpAfter);
+ 
+         if (hpAfter <= 0) {
+             // Normal: se é o último brick, snapshot para finisher slow-down
+             if (state.gameType == GameType::NORMAL && state.mode == GameMode::PLAYING) {
+                 // o brick atingido ainda conta como vivo aqui
+                 if (field.aliveCount() <= 1) {
+                     state.winFinisherHoldBrickValid = true;
+                     state.winFinisherHoldBrickPos = brPos;
+                     state.winFinisherHoldBrickSize = brSize;
+                     state.winFinisherHoldBrickMaxHp = brMaxHp;
+                     state.winFinisherHoldBrickHp = 1;
                  }
+             }
  
-                 // Fireball é one-shot: apaga a bola e sinaliza respawn
-                 ball.alive = false;
-                 ball.isFireball = false;
-                 ball.vel = glm::vec3(0.0f);
-                 state.pendingRespawnAfterFireball = true;
+             (void)killBrick(bi, true);
+             info.broke = true;
+         }
  
-                 state.brickHitCooldown = 0.045f;
-                 info.broke = (info.bricksKilled > 0);
-                 info.hpAfter = 0;
-                 return info;
-             }
+         info.hpAfter = std::max(0, hpAfter);
  
-             // -------- NORMAL PATH (dano + bounce) --------
-             {
-                 int dmg = 1;
-                 if (state.gameType == GameType::ROGUE) {
-                     dmg += std::max(0, state.rogueBrickDamageBonus);
-                 }
+         if (!info.broke) {
+             info.damaged = true;
+             if (info.hpBefore > 1 && info.hpAfter == 1) info.cracked = true;
+         }
+     }
  
-                 br.hp -= dmg;
- 
-                 if (br.hp <= 0) {
-                     // Normal: se é o último brick, snapshot para finisher slow-down
-                     if (state.gameType == GameType::NORMAL && state.mode == GameMode::PLAYING) {
-                         bool anyOtherAlive = false;
-                         for (const auto& other : state.bricks) {
-                             if (&other == &br) continue;
-                             if (other.alive) { anyOtherAlive = true; break; }
-                         }
-                         if (!anyOtherAlive) {
-                             state.winFinisherHoldBrickValid = true;
-                             state.winFinisherHoldBrickPos = br.pos;
-                             state.winFinisherHoldBrickSize = br.size;
-                             state.winFinisherHoldBrickMaxHp = br.maxHp;
-                             state.winFinisherHoldBrickHp = 1;
-                         }
-                     }
- 
-                     (void)killBrick(br, true);
-                     info.broke = true;
-                 }
+     // Bounce: reflexão pela normal do contacto (faces = inverter um eixo; cantos = reflexão real)
+     float vn = ball.vel.x * normal.x + ball.vel.z * normal.y;
+     if (vn < 0.0f) {
+         ball.vel.x -= 2.0f * vn * normal.x;
+         ball.vel.z -= 2.0f * vn * normal.y;
+     }
+     ball.pos.x += normal.x * kContactSkin;
+     ball.pos.z += normal.y * kContactSkin;
+     return info;
+ }
  
-                 info.hpAfter = std::max(0, br.hp);
+ // Junta um hit ao resumo: flags OR, kills somados, hp/maxHp do último.
+ static void mergeBrickInfo(CollisionSystem::BrickCollisionInfo& acc, const CollisionSystem::BrickCollisionInfo& hit) {
+     acc.hit = true;
+     acc.fireball = acc.fireball || hit.fireball;
+     acc.damaged = acc.damaged || hit.damaged;
+     acc.cracked = acc.cracked || hit.cracked;
+     acc.broke = acc.broke || hit.broke;
+     acc.bricksKilled += hit.bricksKilled;
+     acc.hpBefore = hit.hpBefore;
+     acc.hpAfter = hit.hpAfter;
+     acc.maxHp = hit.maxHp;
+ }
  
-                 if (!info.broke) {
-                     info.damaged = true;
-                     if (info.hpBefore > 1 && info.hpAfter == 1) info.cracked = true;
-                 }
-             }
+ CollisionSystem::BallMoveInfo CollisionSystem::moveBall(Ball& ball, GameState& state, const glm::vec3& paddleSize,
+                                                         const GameConfig& cfg, float dt) {
+     BallMoveInfo out;
+     if (ball.attached || !ball.alive) return out;
+ 
+     enum class Kind { None, WallX, WallZ, Paddle, Brick };
+ 
+     // (thread_local: a simulação pode correr no seu próprio thread; capacidade reservada à
+     // cabeça para os primeiros passos de jogo não irem ao malloc)
+     static thread_local std::vector<int> candidates;
+     if (candidates.capacity() == 0) candidates.reserve(128);
+     BrickField& field = state.bricks;
+     const float r = cfg.ballRadius;
+ 
+     const glm::vec3& paddlePos = state.paddlePos;
+     const float pMinX = paddlePos.x - paddleSize.x * 0.5f, pMaxX = paddlePos.x + paddleSize.x * 0.5f;
+     const float pMinZ = paddlePos.z - paddleSize.z * 0.5f, pMaxZ = paddlePos.z + paddleSize.z * 0.5f;
+ 
+     // Shield: plano atrás do paddle, só trava bolas a ir para +Z.
+     const bool shield = (state.shieldTimer > 0.0f);
+     const float shieldZ = std::min(paddlePos.z + cfg.shieldOffsetZ, 19.0f) - r;
+ 
+     bool paddleOverlapDone = false;
+     float remaining = dt;
+ 
+     for (int it = 0; it < kMaxContactsPerStep && remaining > 0.0f; ++it) {
+         const glm::vec3 d = ball.vel * remaining;
+ 
+         Kind kind = Kind::None;
+         float tBest = 2.0f;
+         glm::vec2 nBest(0.0f);
+         int brickBest = -1;
+ 
+         auto consider = [&](Kind k, float t, const glm::vec2& n, int brick) {
+             if (t < tBest) { tBest = t; kind = k; nBest = n; brickBest = brick; }
+         };
+ 
+         // Paredes (planos para o centro da bola). Já para lá do plano e a entrar = contacto em t=0.
+         if (d.x < 0.0f) {
+             float plane = cfg.arenaMinX + r;
+             consider(Kind::WallX, std::max(0.0f, (plane - ball.pos.x) / d.x), glm::vec2(1.0f, 0.0f), -1);
+         } else if (d.x > 0.0f) {
+             float plane = cfg.arenaMaxX - r;
+             consider(Kind::WallX, std::max(0.0f, (plane - ball.pos.x) / d.x), glm::vec2(-1.0f, 0.0f), -1);
+         }
+         if (d.z < 0.0f) {
+             float plane = cfg.arenaMinZ + r;
+             consider(Kind::WallZ, std::max(0.0f, (plane - ball.pos.z) / d.z), glm::vec2(0.0f, 1.0f), -1);
+         } else if (d.z > 0.0f && shield) {
+             consider(Kind::WallZ, std::max(0.0f, (shieldZ - ball.pos.z) / d.z), glm::vec2(0.0f, -1.0f), -1);
+         }
  
-             // Bounce (eixo dominante vs o centro do brick)
-             glm::vec3 diff = ball.pos - br.pos;
-             float ax = std::abs(diff.x) / (br.size.x * 0.5f);
-             float az = std::abs(diff.z) / (br.size.z * 0.5f);
+         // Paddle (o paddle já se moveu neste passo: sobreposição inicial responde 1x, mesmo a afastar-se)
+         {
+             float t; glm::vec2 n;
+             if (sweepSphereAabbXZ(ball.pos, d, r, pMinX, pMaxX, pMinZ, pMaxZ, t, n)) {
+                 bool movingIn = (d.x * n.x + d.z * n.y) < 0.0f;
+                 if (t > 0.0f || movingIn || !paddleOverlapDone) consider(Kind::Paddle, t, n, -1);
+             }
+         }
  
-             if (ax > az) {
-                 ball.vel.x = -ball.vel.x;
-                 float sign = (diff.x >= 0.0f) ? 1.0f : -1.0f;
-                 ball.pos.x = br.pos.x + sign * (br.size.x * 0.5f + cfg.ballRadius + 0.002f);
+         // Bricks: candidatos da grelha ao longo do segmento, filtrados em lote (SoA, SSE2/AVX2)
+         // pelo AABB expandido; só os que sobram vão ao teste exacto. Vêm pela ordem das células:
+         // empates entre bricks vão para o slot mais baixo, para o resultado não depender da grelha.
+         field.querySwept(ball.pos, ball.pos + d, r, candidates);
+         field.sweptCandidates(ball.pos, d, r, candidates);
+         for (int bi : candidates) {
+             float t; glm::vec2 n;
+             if (!sweepSphereAabbXZ(ball.pos, d, r, field.minX(bi), field.maxX(bi), field.minZ(bi), field.maxZ(bi), t, n))
+                 continue;
+             // sobreposição inicial a afastar-se (acabou de ressaltar): ignora
+             if (t == 0.0f && (d.x * n.x + d.z * n.y) >= 0.0f) continue;
+             if (t == tBest && kind == Kind::Brick && bi < brickBest) {
+                 nBest = n;
+                 brickBest = bi;
              } else {
-                 ball.vel.z = -ball.vel.z;
-                 float sign = (diff.z >= 0.0f) ? 1.0f : -1.0f;
-                 ball.pos.z = br.pos.z + sign * (br.size.z * 0.5f + cfg.ballRadius + 0.002f);
+                 consider(Kind::Brick, t, n, bi);
              }
+         }
  
-             state.brickHitCooldown = 0.045f;
-             return info;
+         if (kind == Kind::None || tBest > 1.0f) {
+             ball.pos += d;
+             remaining = 0.0f;
+             break;
          }
+ 
+         ball.pos += d * tBest;
+         remaining *= (1.0f - tBest);
+         out.contacts++;
+ 
+         switch (kind) {
+             case Kind::WallX:
+                 ball.vel.x = (nBest.x > 0.0f) ? std::abs(ball.vel.x) : -std::abs(ball.vel.x);
+                 ball.pos.x = clampf(ball.pos.x, cfg.arenaMinX + r, cfg.arenaMaxX - r);
+                 out.wall = true;
+                 break;
+             case Kind::WallZ:
+                 if (nBest.y > 0.0f) {
+                     ball.vel.z = std::abs(ball.vel.z);
+                     ball.pos.z = std::max(ball.pos.z, cfg.arenaMinZ + r);
+                     out.wall = true;
+                 } else {
+                     // shield (sem SFX de parede, como antes)
+                     ball.vel.z = -std::abs(ball.vel.z);
+                     ball.pos.z = std::min(ball.pos.z, shieldZ - kContactSkin);
+                 }
+                 break;
+             case Kind::Paddle:
+                 paddleOverlapDone = true;
+                 out.paddle = respondPaddle(ball, state, paddlePos, paddleSize, cfg);
+                 break;
+             case Kind::Brick: {
+                 mergeBrickInfo(out.brick, applyBrickHit(ball, state, cfg, brickBest, nBest));
+                 break;
+             }
+             default: break;
+         }
+ 
+         // sticky paddle / fireball consumida: a bola deixa de ser simulada neste passo
+         if (ball.attached || !ball.alive) break;
      }
  
-     return info;
+     return out;
+ }
+ 
+ CollisionSystem::BallMoveInfo CollisionSystem::moveBalls(GameState& state, const glm::vec3& paddleSize,
+                                                          const GameConfig& cfg, float dt, SimdLevel level) {
+     BallMoveInfo out;
+     BallSet& balls = state.balls;
+     if (balls.empty()) return out;
+ 
+     // Faixas que obrigam ao CCD: bricks (maxZ do mais fundo, O(1)) e paddle/shield (mais atrás).
+     BallSet::FreeBounds fb;
+     fb.minX = cfg.arenaMinX;
+     fb.maxX = cfg.arenaMaxX;
+     fb.minZ = cfg.arenaMinZ;
+     fb.brickZoneMaxZ = (state.bricks.aliveCount() > 0) ? state.bricks.deepestMaxZ()
+                                                        : -std::numeric_limits<float>::infinity();
+     fb.paddleZoneMinZ = state.paddlePos.z - paddleSize.z * 0.5f;
+     fb.radius = cfg.ballRadius;
+     fb.maxStep = 0.5f * std::min(cfg.arenaMaxX - cfg.arenaMinX, cfg.arenaMaxZ - cfg.arenaMinZ) - cfg.ballRadius;
+ 
+     static thread_local std::vector<int> slow;
+     if (slow.capacity() < (std::size_t)balls.size()) slow.reserve((std::size_t)balls.size() * 2 + 64);
+     const int walls = balls.advanceFree(dt, fb, slow, level);
+     out.wall = walls > 0;
+     out.contacts = walls;
+ 
+     // Caminho lento: uma bola de cada vez (pode partir bricks, colar no paddle, morrer em fireball)
+     for (int i : slow) {
+         Ball b = balls.get(i);
+         BallMoveInfo mv = moveBall(b, state, paddleSize, cfg, dt);
+         balls.set(i, b);
+ 
+         out.wall = out.wall || mv.wall;
+         out.paddle = out.paddle || mv.paddle;
+         out.contacts += mv.contacts;
+         if (mv.brick.hit) mergeBrickInfo(out.brick, mv.brick);
+     }
+     return out;
  }
  
  } // namespace game
@@ -16,7 +16,6 @@
  #include "game/LevelLayouts.hpp"
  
  #include <cstdlib>
- #include <ctime>
  #include <algorithm>
  #include <fstream>
  #include <string>
@@ -26,8 +25,8 @@
  namespace game {
  
  // Weighted base HP selection para bricks “random”
- static int pickWeightedBaseHp_1to4() {
-     int r = rand() % 100;
+ static int pickWeightedBaseHp_1to4(Pcg32& rng) {
+     int r = rng.range(100);
      if (r < 30) return 1;
      if (r < 55) return 2;
      if (r < 80) return 3;
@@ -50,11 +49,14 @@
      return 0;
  }
  
+ // Limpa o campo e (re)configura a grelha de colisão sobre a arena
+ static void resetBricks(GameState& state, const GameConfig& cfg) {
+     state.bricks.configureGrid(cfg.arenaMinX, cfg.arenaMaxX, cfg.arenaMinZ, cfg.arenaMaxZ,
+                                cfg.brickGridCellX, cfg.brickGridCellZ);
+ }
+ 
  bool InitSystem::anyBricksAlive(const GameState& state) {
-     for (const auto& b : state.bricks) {
-         if (b.alive) return true;
-     }
-     return false;
+     return state.bricks.stats().alive() > 0; // O(1), FieldStats
  }
  
  void InitSystem::resetBallAndPaddle(GameState& state, const GameConfig& cfg) {
@@ -63,17 +65,18 @@
          0.0f, 0.0f,
          cfg.arenaMaxZ - (cfg.paddleSize.z * 0.5f) - 0.25f
      );
+     state.paddlePrevPos = state.paddlePos; // sem "slide" interpolado desde a run anterior
  
      // 1 bola inicial colada ao paddle
      state.balls.clear();
      Ball firstBall;
      PhysicsSystem::resetBallToPaddle(firstBall, state.paddlePos, cfg);
-     state.balls.push_back(firstBall);
+     state.balls.add(firstBall);
  }
  
- void InitSystem::initGame(GameState& state, const GameConfig& cfg) {
-     // seed RNG
-     srand(static_cast<unsigned int>(time(nullptr)));
+ void InitSystem::initGame(GameState& state, const GameConfig& cfg, std::uint64_t seed) {
+     // RNG da run (todas as streams; nada de rand() global)
+     state.rng.reseed(seed ? seed : RunRng::freshSeed());
  
      // base state
      state.mode = GameMode::PLAYING;
@@ -125,7 +128,6 @@
      state.fireballShakeAnchorPos = glm::vec3(0.0f);
      state.scorePopups.clear();
      state.pendingRespawnAfterFireball = false;
-     state.brickHitCooldown = 0.0f;
  
      // ---------- Generate bricks ----------
      if (state.gameType == GameType::LEVELS) {
@@ -154,7 +156,7 @@
  }
  
  void InitSystem::generateBricks(GameState& state, const GameConfig& cfg, int waveNumber) {
-     state.bricks.clear();
+     resetBricks(state, cfg);
  
      const int cols = 12;
      int rows = 9; // default
@@ -186,7 +188,7 @@
          b.pos.y = 0.0f;
          b.pos.z = startZ + 4.0f * (brickSize.z + gapZ);
          b.maxHp = b.hp = 1;
-         state.bricks.push_back(b);
+         state.bricks.add(b);
          return;
      }
  
@@ -209,7 +211,7 @@
                  else hp = 4;
  
                  b.maxHp = b.hp = hp;
-                 state.bricks.push_back(b);
+                 state.bricks.add(b);
                  continue;
              }
  
@@ -218,28 +220,28 @@
  
              if (state.gameType == GameType::ROGUE && waveNumber > 0) {
                  // Rogue: curva de HP vem do RogueSystem
-                 int hp = RogueSystem::pickBrickHpForWave(waveNumber, isFrontHalf);
+                 int hp = RogueSystem::pickBrickHpForWave(state.rng.bricks, waveNumber, isFrontHalf);
                  b.maxHp = b.hp = std::min(6, std::max(1, hp));
              } else {
                  if (isFrontHalf) {
                      // front: mais fácil
-                     int r2 = rand() % 100;
+                     int r2 = state.rng.bricks.range(100);
                      if (r2 < 45)      b.maxHp = b.hp = 1;
                      else if (r2 < 85) b.maxHp = b.hp = 2;
                      else              b.maxHp = b.hp = 3;
                  } else {
                      // back: mais pesado e escala com wave
                      if (waveNumber == 0) {
-                         b.maxHp = b.hp = pickWeightedBaseHp_1to4();
+                         b.maxHp = b.hp = pickWeightedBaseHp_1to4(state.rng.bricks);
                      } else {
                          int hpBonus = waveNumber / 5;
-                         int baseHp = pickWeightedBaseHp_1to4();
+                         int baseHp = pickWeightedBaseHp_1to4(state.rng.bricks);
                          b.maxHp = b.hp = std::min(6, baseHp + hpBonus);
                      }
                  }
              }
  
-             state.bricks.push_back(b);
+             state.bricks.add(b);
          }
      }
  }
@@ -262,10 +264,7 @@
      float push = rowsToInsert * stepZ;
  
      // empurra bricks existentes “para baixo” (em direção ao paddle)
-     for (auto& br : state.bricks) {
-         if (!br.alive) continue;
-         br.pos.z += push;
-     }
+     state.bricks.shiftZ(push);
  
      int totalRowsBefore = state.endlessRowsSpawned;
  
@@ -283,18 +282,18 @@
          b.pos.y = 0.0f;
          b.pos.z = topZ + rowLocal * stepZ;
  
-         int baseHp = pickWeightedBaseHp_1to4();
+         int baseHp = pickWeightedBaseHp_1to4(state.rng.bricks);
          int difficultyBonus = (rowGlobal / 20);
          b.maxHp = b.hp = std::min(6, baseHp + difficultyBonus);
  
-         state.bricks.push_back(b);
+         state.bricks.add(b);
      }
  
      state.endlessRowsSpawned = totalRowsBefore + rowsToInsert;
  }
  
  void InitSystem::generateBricksFromLevel(GameState& state, const GameConfig& cfg, int levelNumber) {
-     state.bricks.clear();
+     resetBricks(state, cfg);
  
      auto levels = getAllLevels();
      if (levelNumber < 1 || levelNumber > (int)levels.size()) {
@@ -321,7 +320,7 @@
          b.size = glm::vec3(brickW, 0.6f, brickH);
          b.hp = b.maxHp = data.hp;
          b.alive = true;
-         state.bricks.push_back(b);
+         state.bricks.add(b);
      }
  }
  
@@ -4,17 +4,18 @@
  *
  * Notas:
  *  - ESC alterna PLAYING <-> PAUSED (mas não funciona em modos especiais tipo ROGUE_CARDS).
- *  - Movimento do paddle: A/D ou setas. Reverse curse inverte.
+ *  - Movimento do paddle: A/D ou setas. Reverse curse inverte. Aqui só se lê a direcção
+ *    (state.paddleInputDir); a integração corre no passo fixo da simulação.
  *  - Launch: SPACE quando a bola está attached. Direção vem do rato via unproject
  *    (usa a mesma câmara do render para o aim bater certo).
  *  - Rogue: se houver rows pendentes a spawnar, não deixa lançar (fairness/pacing).
+ *  - A direcção do launch fica em state.launchInputDir para o Game a gravar no replay.
  */
  #include "game/systems/InputSystem.hpp"
  #include "game/GameConfig.hpp"
  #include "game/GameState.hpp"
  #include "game/entities/Ball.hpp"
- #include "game/systems/PhysicsSystem.hpp"
- #include "game/rogue/RogueCards.hpp"
+ #include "game/systems/SimulationSystem.hpp"
  #include "engine/Window.hpp"
  
  #include <glm/glm.hpp>
@@ -125,14 +126,14 @@
  void InputSystem::handleGameInput(GameState& state,
                                    const engine::Input& input,
                                    const GameConfig& cfg,
-                                   engine::Window& window,
-                                   float dt) {
+                                   engine::Window& window) {
      // ESC só vale em PLAYING/PAUSED (não mexe em ROGUE_CARDS, etc)
      if (input.keyPressed(engine::Key::Escape)) {
          if (state.mode == GameMode::PLAYING) state.mode = GameMode::PAUSED;
          else if (state.mode == GameMode::PAUSED) state.mode = GameMode::PLAYING;
      }
  
+     state.paddleInputDir = 0.0f;
      if (state.mode != GameMode::PLAYING) return;
  
      auto [fbW, fbH] = window.getFramebufferSize();
@@ -172,25 +173,21 @@
          dir = -dir;
      }
  
-     PhysicsSystem::updatePaddle(state, cfg, dir, dt);
+     // O movimento em si acontece em cada passo fixo (PhysicsSystem::updatePaddle).
+     state.paddleInputDir = dir;
  
      // ---------------- Ball launching ----------------
-     for (auto& ball : state.balls) {
-         // Rogue fairness: se estamos a spawnar rows pendentes, mantém a bola attached.
-         if (state.gameType == GameType::ROGUE && state.roguePendingRowsToSpawn > 0) {
-             continue;
-         }
- 
-         // Enquanto attached: SPACE lança
-         if (ball.attached && input.keyDown(engine::Key::Space)) {
-             ball.attached = false;
- 
-             glm::vec3 d = computeLaunchDirFromMouse(state, input, cfg, window, ball);
-             float sp = cfg.ballSpeed;
-             if (state.gameType == GameType::ROGUE) sp *= game::rogue::ballSpeedMult(state);
- 
-             ball.vel = d * sp;
-         }
+     // Rogue fairness: se estamos a spawnar rows pendentes, mantém a bola attached.
+     if (state.gameType == GameType::ROGUE && state.roguePendingRowsToSpawn > 0) return;
+     if (!input.keyDown(engine::Key::Space)) return;
+ 
+     // Enquanto attached: SPACE lança. A mira usa a primeira bola attached e todas saem na mesma
+     // direcção, pelo mesmo caminho que o replay (SimulationSystem::launchAttached).
+     for (int i = 0; i < state.balls.size(); ++i) {
+         if (!state.balls.attached(i)) continue;
+         state.launchInputDir = computeLaunchDirFromMouse(state, input, cfg, window, state.balls.get(i));
+         SimulationSystem::launchAttached(state, cfg, state.launchInputDir);
+         break;
      }
  }
  
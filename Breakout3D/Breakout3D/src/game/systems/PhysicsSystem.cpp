@@ -5,17 +5,22 @@
  * Ideias chave:
  *  - Paddle speed e tamanho são “dinâmicos”: Rogue modifiers + timers (SLOW/EXPAND/TINY).
  *  - Clamp do paddle respeita arena + (Rogue) margem extra para “CENTERED ARENA”.
- *  - Balls: se attached, seguem o paddle; caso contrário, integram posição e aplicam efeitos de ambiente.
- *  - Rogue wind:
+ *  - Balls: se attached, seguem o paddle; caso contrário, aplicam efeitos de ambiente à velocidade.
+ *    A posição é integrada por `CollisionSystem::moveBalls` (kernel SoA + CCD), que também trata do shield.
+ *  - Rogue wind (sobre os arrays do BallSet, sem branches por bola):
  *      - rogueWindX: vento constante (pequeno empurrão lateral) com renormalização de speed.
- *      - rogueRandomWindActive: rajadas aleatórias a cada 0.3s (também renormaliza).
- *  - Shield: cria uma barreira atrás do paddle que reflete bolas em vez de perder.
- *  - Remoção: bola que passa z > 20 (abaixo do campo) é removida.
+ *      - rogueRandomWindActive: a cada 0.3s cada bola livre leva uma rajada aleatória (também renormaliza).
+ *  - Remoção: bola que passa z > 20 (abaixo do campo) é removida (swap-remove).
+ *  - Interpolação: `storePreviousTransforms` guarda pos do passo anterior (paddle/bolas/powerups)
+ *    antes de cada passo fixo; entidades criadas a meio do passo ficam com hasPrev=false.
  */
  #include "game/systems/PhysicsSystem.hpp"
  #include "game/entities/Ball.hpp"
  #include "game/rogue/RogueCards.hpp"
  #include <algorithm>
+ #include <cmath>
+ #include <cstdlib>
+ #include <vector>
  #include <glm/glm.hpp>
  
  namespace game {
@@ -25,6 +30,7 @@
      ball.attached = true;
      ball.alive = true;
      ball.vel = glm::vec3(0.0f);
+     ball.hasPrev = false; // teleporte: não interpolar a partir da posição antiga
  
      // Posiciona ligeiramente à frente do paddle (para o lado dos bricks, -Z)
      ball.pos = paddlePos + glm::vec3(
@@ -33,6 +39,15 @@
      );
  }
  
+ void PhysicsSystem::storePreviousTransforms(GameState& state) {
+     state.paddlePrevPos = state.paddlePos;
+     state.balls.storePrevious();
+     for (auto& p : state.powerups) {
+         p.prevPos = p.pos;
+         p.hasPrev = true;
+     }
+ }
+ 
  void PhysicsSystem::updatePaddle(GameState& state, const GameConfig& cfg, float dir, float dt) {
      // Velocidade base + modificadores
      float currentPaddleSpeed = cfg.paddleSpeed;
@@ -70,86 +85,44 @@
  }
  
  void PhysicsSystem::updateBalls(GameState& state, const GameConfig& cfg, float dt) {
-     // Recalcula paddle size (para coisas como shield/barreira e attached positioning)
-     glm::vec3 currentPaddleSize = cfg.paddleSize;
-     if (state.gameType == GameType::ROGUE) {
-         currentPaddleSize.x *= game::rogue::basePaddleScaleX(state);
+     BallSet& balls = state.balls;
+ 
+     // Se attached, forçamos a bola a seguir o paddle (sem “descolar”)
+     for (int i = 0; i < balls.size(); ++i) {
+         if (!balls.attached(i)) continue;
+         Ball b = balls.get(i);
+         resetBallToPaddle(b, state.paddlePos, cfg);
+         balls.set(i, b);
      }
-     if (state.expandTimer > 0.0f) {
-         currentPaddleSize.x *= cfg.expandScaleFactor;
-     }
-     if (state.tinyTimer > 0.0f) {
-         currentPaddleSize.x *= cfg.tinyScaleFactor;
-     }
- 
-     for (size_t i = 0; i < state.balls.size(); ) {
-         Ball& b = state.balls[i];
- 
-         // Se attached, forçamos a bola a seguir o paddle (sem “descolar”)
-         if (b.attached) {
-             resetBallToPaddle(b, state.paddlePos, cfg);
-             i++;
-             continue;
-         }
- 
-         // Integração simples
-         b.pos += b.vel * dt;
  
+     if (state.gameType == GameType::ROGUE) {
          // ---------------- Rogue: vento constante (lateral) ----------------
-         if (state.gameType == GameType::ROGUE && !b.attached && std::abs(state.rogueWindX) > 1e-4f) {
-             float sp = glm::length(glm::vec2(b.vel.x, b.vel.z));
- 
-             // empurra X
-             b.vel.x += state.rogueWindX * dt;
- 
-             // renormaliza para manter magnitude (não acelerar/desacelerar por acidente)
-             float sp2 = glm::length(glm::vec2(b.vel.x, b.vel.z));
-             if (sp > 1e-4f && sp2 > 1e-4f) {
-                 float k = sp / sp2;
-                 b.vel.x *= k;
-                 b.vel.z *= k;
-             }
+         if (std::abs(state.rogueWindX) > 1e-4f) {
+             balls.applyWindX(state.rogueWindX * dt);
          }
  
          // ---------------- Rogue: vento caótico (rajadas) ----------------
-         if (state.gameType == GameType::ROGUE && !b.attached && state.rogueRandomWindActive) {
+         // Um timer por passo; quando dispara, cada bola livre leva a sua rajada.
+         if (state.rogueRandomWindActive) {
              state.rogueRandomWindTimer += dt;
              if (state.rogueRandomWindTimer >= 0.3f) {
-                 float windForce = 2.8f + (float)(rand() % 20) * 0.08f; // 2.8 .. 4.4
-                 if (rand() % 2 == 0) windForce = -windForce;
- 
-                 float sp = glm::length(glm::vec2(b.vel.x, b.vel.z));
-                 b.vel.x += windForce;
- 
-                 float sp2 = glm::length(glm::vec2(b.vel.x, b.vel.z));
-                 if (sp > 1e-4f && sp2 > 1e-4f) {
-                     float k = sp / sp2;
-                     b.vel.x *= k;
-                     b.vel.z *= k;
+                 static thread_local std::vector<float> gust;
+                 gust.resize((size_t)balls.size());
+                 for (float& g : gust) {
+                     float windForce = 2.8f + (float)state.rng.wind.range(20) * 0.08f; // 2.8 .. 4.4
+                     if (state.rng.wind.range(2) == 0) windForce = -windForce;
+                     g = windForce;
                  }
- 
+                 balls.applyWindX(0.0f, gust.data());
                  state.rogueRandomWindTimer = 0.0f;
              }
          }
+     }
  
-         // ---------------- Shield barrier ----------------
-         if (state.shieldTimer > 0.0f) {
-             float barrierZ = state.paddlePos.z + cfg.shieldOffsetZ;
-             barrierZ = std::min(barrierZ, 19.0f);
- 
-             // Só reflete se a bola estiver a ir “para trás” (Z positivo)
-             if (b.vel.z > 0.0f && (b.pos.z + cfg.ballRadius) >= barrierZ) {
-                 b.pos.z = barrierZ - cfg.ballRadius - 0.002f;
-                 b.vel.z = -std::abs(b.vel.z);
-             }
-         }
- 
-         // Remoção de bolas fora do campo
-         if (b.pos.z - cfg.ballRadius > 20.0f) {
-             state.balls.erase(state.balls.begin() + i);
-         } else {
-             i++;
-         }
+     // Remoção de bolas fora do campo (swap-remove: sem deslocar a cauda)
+     for (int i = 0; i < balls.size(); ) {
+         if (balls.pos(i).z - cfg.ballRadius > 20.0f) balls.removeAt(i);
+         else i++;
      }
  }
  
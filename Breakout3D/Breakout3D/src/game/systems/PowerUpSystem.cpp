@@ -29,28 +29,27 @@
      if (state.gameType == GameType::ROGUE) {
          if (state.rogueDropDeck.empty()) return;
  
-         float r = (float)rand() / (float)RAND_MAX;
+         float r = state.rng.drops.uniform();
          if (r > chance) return;
  
          PowerUp p;
          p.pos = pos;
          p.pos.y = 0.4f;
-         p.type = state.rogueDropDeck[(size_t)(rand() % state.rogueDropDeck.size())];
+         p.type = state.rogueDropDeck[(size_t)state.rng.drops.range((int)state.rogueDropDeck.size())];
  
-         state.powerups.push_back(p);
-         state.audioSpawnedPowerups.push_back(p.type);
+         if (state.powerups.push(p)) state.audioSpawnedPowerups.push(p.type);
          return;
      }
  
      // Outros modos: chance global
-     float r = (float)rand() / (float)RAND_MAX;
+     float r = state.rng.drops.uniform();
      if (r > chance) return;
  
      PowerUp p;
      p.pos = pos;
      p.pos.y = 0.4f;
  
-     int r2 = rand() % 100;
+     int r2 = state.rng.drops.range(100);
      // Distribuição weighted (ajustada para curses aparecerem mais)
      if (r2 < 22)       p.type = PowerUpType::EXTRA_BALL; // 22%
      else if (r2 < 36)  p.type = PowerUpType::EXPAND;     // 14%
@@ -61,8 +60,7 @@
      else if (r2 < 93)  p.type = PowerUpType::REVERSE;    // 7%
      else               p.type = PowerUpType::TINY;       // 7%
  
-     state.powerups.push_back(p);
-     state.audioSpawnedPowerups.push_back(p.type);
+     if (state.powerups.push(p)) state.audioSpawnedPowerups.push(p.type); // pool cheia: sem drop
  }
  
  void PowerUpSystem::applyPowerUpEffect(GameState& state, const GameConfig& cfg, PowerUpType type) {
@@ -72,7 +70,7 @@
          // Spawn 3 bolas a partir da primeira bola ativa (ou do paddle)
          glm::vec3 spawnPos = state.paddlePos + glm::vec3(0, 0, -0.5f);
          if (!state.balls.empty()) {
-             spawnPos = state.balls[0].pos;
+             spawnPos = state.balls.pos(0);
          }
  
          for (int k = 0; k < 3; k++) {
@@ -85,7 +83,7 @@
  
              nb.vel = glm::vec3(std::sin(ang), 0.0f, -std::cos(ang)) * sp;
              nb.attached = false;
-             state.balls.push_back(nb);
+             state.balls.add(nb);
          }
      } else if (type == PowerUpType::SLOW) {
          state.slowTimer = cfg.powerUpDuration;
@@ -99,7 +97,7 @@
          fb.isFireball = true;
  
          PhysicsSystem::resetBallToPaddle(fb, state.paddlePos, cfg);
-         state.balls.push_back(fb);
+         state.balls.add(fb);
  
          state.fireballTimer = 0.0f; // legacy
      } else if (type == PowerUpType::SHIELD) {
@@ -183,13 +181,13 @@
              }
  
              applyPowerUpEffect(state, cfg, p.type);
-             state.audioPickedPowerups.push_back(p.type);
+             state.audioPickedPowerups.push(p.type);
              p.alive = false;
          }
  
-         // Cleanup
+         // Cleanup (swap-remove: o último vem para i e é processado já a seguir)
          if (!p.alive || p.pos.z > 20.0f) {
-             state.powerups.erase(state.powerups.begin() + i);
+             state.powerups.swapRemove(i);
          } else {
              i++;
          }
@@ -28,7 +28,7 @@
      return "breakout3d_rogue_best.txt";
  }
  
- static void saveRogueBestScore(int best) {
+ void RogueSystem::saveRogueBestScore(int best) {
      std::ofstream f(rogueBestScorePath(), std::ios::trunc);
      if (!f) return;
      f << best;
@@ -76,19 +76,19 @@
      return (state.rogueMaxWaves > 0) && (clearedWave >= state.rogueMaxWaves);
  }
  
- int RogueSystem::pickBrickHpForWave(int wave, bool isFrontHalf) {
+ int RogueSystem::pickBrickHpForWave(Pcg32& rng, int wave, bool isFrontHalf) {
      wave = std::max(1, wave);
  
      // Wave 1: 1-2 HP
      if (wave == 1) {
-         int r = rand() % 100;
+         int r = rng.range(100);
          if (isFrontHalf) return (r < 70) ? 1 : 2;
          return (r < 45) ? 1 : 2;
      }
  
      // Wave 2-3: adiciona 3 HP às vezes
      if (wave <= 3) {
-         int r = rand() % 100;
+         int r = rng.range(100);
          if (isFrontHalf) {
              if (r < 55) return 1;
              if (r < 90) return 2;
@@ -102,7 +102,7 @@
  
      // Wave 4-6: introduz 4 HP
      if (wave <= 6) {
-         int r = rand() % 100;
+         int r = rng.range(100);
          if (isFrontHalf) {
              if (r < 35) return 1;
              if (r < 75) return 2;
@@ -117,7 +117,7 @@
      }
  
      // Wave 7+: maioritariamente 3-4, raros 5, e depois soft-scaling
-     int r = rand() % 100;
+     int r = rng.range(100);
      int hp = 3;
  
      if (wave <= 8) {
@@ -132,7 +132,7 @@
  
      // front half puxa para 3
      if (isFrontHalf && hp > 3) {
-         int rr = rand() % 100;
+         int rr = rng.range(100);
          if (rr < 55) hp = 3;
      }
  
@@ -202,10 +202,7 @@
  
      // Empurra bricks existentes para abrir espaço no "back"
      float push = (float)rowsToInsert * stepZ;
-     for (auto& br : state.bricks) {
-         if (!br.alive) continue;
-         br.pos.z += push;
-     }
+     state.bricks.shiftZ(push);
  
      // Spawna novas rows no back (tratadas como mais difíceis)
      int count = rowsToInsert * cols;
@@ -221,10 +218,10 @@
          b.pos.y = 0.0f;
          b.pos.z = topZ + rowLocal * stepZ;
  
-         int hp = RogueSystem::pickBrickHpForWave(state.wave, /*isFrontHalf=*/false);
+         int hp = RogueSystem::pickBrickHpForWave(state.rng.bricks, state.wave, /*isFrontHalf=*/false);
          b.maxHp = b.hp = std::min(6, std::max(1, hp));
  
-         state.bricks.push_back(b);
+         state.bricks.add(b);
      }
  
      state.rogueRowsSpawned += rowsToInsert;
@@ -237,13 +234,5 @@
      return 0;
  }
  
- void RogueSystem::maybeUpdateRogueBest(GameState& state) {
-     if (state.gameType != GameType::ROGUE) return;
-     if (state.score > state.rogueBestScore) {
-         state.rogueBestScore = state.score;
-         saveRogueBestScore(state.rogueBestScore);
-     }
- }
- 
  } // namespace game
  
\ No newline at end of file
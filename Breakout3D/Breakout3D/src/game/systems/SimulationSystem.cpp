@@ -0,0 +1,216 @@
+// SimulationSystem.cpp
+/**
+ * @file SimulationSystem.cpp
+ * @brief Passo fixo do gameplay: paddle, timers, condições de vitória do Normal/Levels e helpers (bank, bests, launch).
+ *
+ * Ordem de um passo (igual ao que o Game::simulateStep fazia):
+ *  1) storePreviousTransforms (interpolação no render)
+ *  2) paddle com state.paddleInputDir
+ *  3) timers (cooldowns, powerups, FX, popups)
+ *  4) Normal/Levels: campo vazio -> finisher (sem frame de gameplay)
+ *  5) frame de gameplay (SimulationSystemPlaying.cpp)
+ *
+ * Timers:
+ *  - Corre uma vez por passo fixo (dt = passo da simulação), não por frame.
+ *  - O hotkey de debug K3 (spawn de bricks no Endless) vive no Game::update, porque é um
+ *    edge de tecla (1x por frame) e um frame pode ter vários passos.
+ */
+ #include "game/systems/SimulationSystem.hpp"
+ #include "game/systems/PhysicsSystem.hpp"
+ #include "game/systems/InitSystem.hpp"
+ #include "game/rogue/RogueCards.hpp"
+
+ #include <algorithm>
+ #include <cmath>
+ 
+ namespace game {
+ 
+ SimulationSystem::StepResult SimulationSystem::step(GameState& state, const GameConfig& cfg, float dt, SimEvents& events) {
+     // Para o gate do SFX de drop: havia powerups a cair no início do passo?
+     const bool hadPowerup = !state.powerups.empty();
+ 
+     PhysicsSystem::storePreviousTransforms(state);
+     PhysicsSystem::updatePaddle(state, cfg, state.paddleInputDir, dt);
+ 
+     updateTimers(state, cfg, dt);
+ 
+     // WIN (NORMAL) / LEVEL COMPLETE (LEVELS): quando não há bricks vivos -> finisher.
+     if (state.mode == GameMode::PLAYING &&
+         (state.gameType == GameType::NORMAL || state.gameType == GameType::LEVELS) &&
+         !InitSystem::anyBricksAlive(state)) {
+ 
+         if (state.gameType == GameType::LEVELS && state.currentLevel >= state.levelsBestLevel) {
+             state.levelsBestLevel = state.currentLevel + 1;
+             if (state.levelsBestLevel > 20) state.levelsBestLevel = 20;
+         }
+ 
+         state.winFinisherActive = true;
+         state.winFinisherTimer = 0.0f;
+         state.winFinisherRealTimer = 0.0f;
+         state.winFinisherAnchorValid = state.lastBrickDestroyedValid;
+         state.winFinisherAnchorPos = state.lastBrickDestroyedPos;
+         state.balls.clear();
+         state.powerups.clear();
+         events.push_back({SimEventType::FieldCleared, 0});
+         return StepResult::FieldCleared; // importante: evitar perder vida por "no balls"
+     }
+ 
+     return playingFrame(state, cfg, dt, hadPowerup, events);
+ }
+ 
+ void SimulationSystem::updateTimers(GameState& state, const GameConfig& cfg, float dt) {
+     // Cooldowns gerais
+     if (state.endlessSpawnCooldown > 0.0f)
+         state.endlessSpawnCooldown = std::max(0.0f, state.endlessSpawnCooldown - dt);
+ 
+     // Endless timers
+     if (state.gameType == GameType::ENDLESS) {
+         state.endlessAutoTimer += dt;
+         if (state.mode == GameMode::PLAYING) {
+             state.endlessElapsedTime += dt;
+         }
+     }
+ 
+     // Rogue timers
+     if (state.gameType == GameType::ROGUE) {
+         if (state.rogueWaveCooldown > 0.0f) {
+             state.rogueWaveCooldown = std::max(0.0f, state.rogueWaveCooldown - dt);
+         }
+         if (state.rogueRowSpawnTimer > 0.0f) {
+             state.rogueRowSpawnTimer = std::max(0.0f, state.rogueRowSpawnTimer - dt);
+         }
+         if (state.mode == GameMode::PLAYING) {
+             state.rogueWaveTimer += dt;
+         }
+     }
+ 
+     // Powerup timers
+     if (state.expandTimer  > 0.0f) state.expandTimer  = std::max(0.0f, state.expandTimer  - dt);
+     if (state.slowTimer    > 0.0f) state.slowTimer    = std::max(0.0f, state.slowTimer    - dt);
+     if (state.fireballTimer> 0.0f) state.fireballTimer= std::max(0.0f, state.fireballTimer- dt);
+     if (state.shieldTimer  > 0.0f) state.shieldTimer  = std::max(0.0f, state.shieldTimer  - dt);
+     if (state.reverseTimer > 0.0f) state.reverseTimer = std::max(0.0f, state.reverseTimer - dt);
+     if (state.tinyTimer    > 0.0f) state.tinyTimer    = std::max(0.0f, state.tinyTimer    - dt);
+ 
+     // Fireball explosion FX timers
+     if (!state.fireballExplosions.empty()) {
+         for (size_t i = 0; i < state.fireballExplosions.size(); ) {
+             state.fireballExplosions[i].t += dt;
+             if (state.fireballExplosions[i].t >= cfg.fireballExplosionFxDuration) {
+                 state.fireballExplosions.swapRemove(i);
+             } else {
+                 ++i;
+             }
+         }
+     }
+ 
+     // Fireball shake timer
+     if (state.fireballShakeTimer > 0.0f) {
+         state.fireballShakeTimer = std::max(0.0f, state.fireballShakeTimer - dt);
+     }
+ 
+     // Fireball shard simulation (debris)
+     if (!state.fireballShards.empty()) {
+         const float g = 12.0f;
+         for (size_t i = 0; i < state.fireballShards.size(); ) {
+             auto& s = state.fireballShards[i];
+             s.t += dt;
+ 
+             // drag no plano XZ
+             float drag = cfg.fireballShardDrag;
+             s.vel.x *= std::exp(-drag * dt);
+             s.vel.z *= std::exp(-drag * dt);
+ 
+             // gravidade e integração
+             s.vel.y -= g * dt;
+             s.pos += s.vel * dt;
+ 
+             // kill conditions
+             if (s.t >= cfg.fireballShardLife || s.pos.y < -0.25f) {
+                 state.fireballShards.swapRemove(i);
+             } else {
+                 ++i;
+             }
+         }
+     }
+ 
+     // Score popup timers (removeIf mantém a ordem: o HUD empilha pela ordem de spawn)
+     if (!state.scorePopups.empty()) {
+         const float popupDur = 2.10f;
+         state.scorePopups.removeIf([&](GameState::ScorePopup& p) {
+             p.t += dt;
+             return p.t >= popupDur;
+         });
+     }
+ }
+ 
+ int SimulationSystem::launchAttached(GameState& state, const GameConfig& cfg, const glm::vec3& dir) {
+     // Rogue fairness: se estamos a spawnar rows pendentes, mantém a bola attached (como o InputSystem).
+     if (state.gameType == GameType::ROGUE && state.roguePendingRowsToSpawn > 0) return 0;
+ 
+     glm::vec3 d(dir.x, 0.0f, dir.z);
+     float len = glm::length(d);
+     if (len < 1e-6f) return 0;
+     d /= len;
+ 
+     float sp = cfg.ballSpeed;
+     if (state.gameType == GameType::ROGUE) sp *= game::rogue::ballSpeedMult(state);
+ 
+     int launched = 0;
+     for (int i = 0; i < state.balls.size(); ++i) {
+         if (!state.balls.attached(i)) continue;
+         Ball ball = state.balls.get(i);
+         ball.attached = false;
+         ball.vel = d * sp;
+         state.balls.set(i, ball);
+         launched++;
+     }
+     return launched;
+ }
+ 
+ glm::vec3 SimulationSystem::paddleSize(const GameState& state, const GameConfig& cfg) {
+     glm::vec3 size = cfg.paddleSize;
+     if (state.gameType == GameType::ROGUE) size.x *= game::rogue::basePaddleScaleX(state);
+     if (state.expandTimer > 0.0f) size.x *= cfg.expandScaleFactor;
+     if (state.tinyTimer > 0.0f) size.x *= cfg.tinyScaleFactor;
+     return size;
+ }
+ 
+ /**
+  * @brief Converte o bank (positivo ou negativo) em score real, e limpa o estado do bank.
+  *
+  * Regras:
+  *  - Se bank == 0, não faz nada (evita trabalho inútil).
+  *  - score nunca fica negativo (clamp a 0).
+  *  - limpa também contadores auxiliares (pos/neg) e timers do sistema de banking.
+  */
+ void SimulationSystem::commitStreak(GameState& state) {
+     if (state.endlessStreakPoints == 0) return;
+ 
+     // Bank pode ser negativo devido a penalidades.
+     state.score = std::max(0, state.score + state.endlessStreakPoints);
+ 
+     // Reset total e breakdown (pos/neg)
+     state.endlessStreakPoints = 0;
+     state.endlessStreakPosPoints = 0;
+     state.endlessStreakNegPoints = 0;
+ 
+     // Reset timers/flags do “banking”
+     state.endlessStreakIdleTimer = 0.0f;
+     state.endlessStreakBanking = false;
+     state.endlessStreakBankTimer = 0.0f;
+ }
+ 
+ // Os bests já vêm carregados no initGame; gravar fica com quem consome o evento.
+ void SimulationSystem::updateBest(GameState& state, SimEvents& events) {
+     if (state.gameType == GameType::ENDLESS && state.score > state.endlessBestScore) {
+         state.endlessBestScore = state.score;
+         events.push_back({SimEventType::EndlessBest, state.endlessBestScore});
+     }
+     if (state.gameType == GameType::ROGUE && state.score > state.rogueBestScore) {
+         state.rogueBestScore = state.score;
+         events.push_back({SimEventType::RogueBest, state.rogueBestScore});
+     }
+ }
+ 
+ } // namespace game
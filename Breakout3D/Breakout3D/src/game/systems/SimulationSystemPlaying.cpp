@@ -0,0 +1,284 @@
+// SimulationSystemPlaying.cpp
+/**
+ * @file SimulationSystemPlaying.cpp
+ * @brief “Frame” principal do gameplay enquanto PLAYING (física, colisões, ondas, score bank, powerups, vidas).
+ *
+ * Este update é o coração do loop quando o jogo está a correr:
+ *  - Física das bolas (inclui wind/shield/remoção via PhysicsSystem).
+ *  - Colisões: paredes, paddle, bricks (CollisionSystem).
+ *  - Pós-processo: remover bolas mortas, respawn pós-fireball (sem perder vida).
+ *  - Endless/Rogue: sistema de “streak bank” (acumula, anima, commit).
+ *  - Rogue: progressão de wave (quota/time), oferta de cartas e rows “queued”.
+ *  - Spawn incremental de bricks no Endless.
+ *  - Condição de lose por bricks chegarem ao paddle (Endless e Rogue).
+ *  - Powerups e vidas (perder/ganhar, penalidades).
+ *
+ * Áudio:
+ *  - Nada aqui toca som: hits, drops, pickups, vida perdida e fim de run saem como SimEvents.
+ *    A música e os loops (danger, tiers, waves) são reacções do Game ao estado depois do passo.
+ */
+ #include "game/systems/SimulationSystem.hpp"
+ #include "game/systems/PhysicsSystem.hpp"
+ #include "game/systems/CollisionSystem.hpp"
+ #include "game/systems/InitSystem.hpp"
+ #include "game/systems/PowerUpSystem.hpp"
+ #include "game/systems/RogueSystem.hpp"
+ #include "game/rogue/RogueCards.hpp"
+
+ #include <glm/glm.hpp>
+ 
+ #include <algorithm>
+ 
+ namespace game {
+ 
+ SimulationSystem::StepResult SimulationSystem::playingFrame(GameState& state, const GameConfig& cfg, float dt,
+                                                             bool hadPowerupBefore, SimEvents& events) {
+     // ------------------------------------------------------------------
+     // Física
+     // ------------------------------------------------------------------
+     PhysicsSystem::updateBalls(state, cfg, dt);
+ 
+     // ------------------------------------------------------------------
+     // Movimento + colisões (voo livre em lote; perto de bricks/paddle: CCD por bola)
+     // ------------------------------------------------------------------
+     {
+         auto mv = CollisionSystem::moveBalls(state, paddleSize(state, cfg), cfg, dt);
+ 
+         // No máximo 1 evento de cada tipo por passo (com muitas bolas não satura o áudio)
+         if (mv.wall) events.push_back({SimEventType::WallHit, 0});
+         if (mv.paddle) events.push_back({SimEventType::PaddleHit, 0});
+ 
+         // Bricks: fireball ou break -> break; cracked -> crack; otherwise -> hit
+         const auto& br = mv.brick;
+         if (br.hit) {
+             if (br.fireball) events.push_back({SimEventType::FireballBreak, 0});
+             else if (br.broke) events.push_back({SimEventType::BrickBreak, 0});
+             else if (br.cracked) events.push_back({SimEventType::BrickCrack, 0});
+             else events.push_back({SimEventType::BrickHit, 0});
+         }
+     }
+ 
+     // ------------------------------------------------------------------
+     // Limpeza de bolas (efeitos one-shot como Fireball)
+     // ------------------------------------------------------------------
+     state.balls.removeDead();
+ 
+     // Respawn “justo” após Fireball consumir a bola (não custa vida).
+     if (state.pendingRespawnAfterFireball && state.balls.empty() && !state.winFinisherActive) {
+         Ball b;
+         b.isFireball = false;
+         PhysicsSystem::resetBallToPaddle(b, state.paddlePos, cfg);
+         state.balls.add(b);
+         state.pendingRespawnAfterFireball = false;
+     }
+ 
+     // ------------------------------------------------------------------
+     // Bank / Streak (Endless + Rogue)
+     // ------------------------------------------------------------------
+     // Acumula pontos em endlessStreakPoints e só faz commit após idle (com mini “bank anim”).
+     if ((state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) && state.mode == GameMode::PLAYING) {
+         float idleToBank = 2.5f; // ~2-3s
+         if (state.gameType == GameType::ROGUE) {
+             idleToBank *= std::max(0.35f, state.rogueBankIdleMult);
+         }
+         const float bankAnim = 0.55f;
+ 
+         if (state.endlessStreakPoints != 0) {
+             if (!state.endlessStreakBanking) {
+                 state.endlessStreakIdleTimer += dt;
+                 if (state.endlessStreakIdleTimer >= idleToBank) {
+                     state.endlessStreakBanking = true;
+                     state.endlessStreakBankTimer = 0.0f;
+                 }
+             } else {
+                 state.endlessStreakBankTimer += dt;
+                 if (state.endlessStreakBankTimer >= bankAnim) {
+                     commitStreak(state);
+                     updateBest(state, events);
+                 }
+             }
+         }
+     }
+ 
+     // ------------------------------------------------------------------
+     // Rogue: progressão de waves (quota/time)
+     // ------------------------------------------------------------------
+     // Não é “limpar tudo”: avança por quota ou por time limit, com cooldown.
+     if (state.gameType == GameType::ROGUE && state.mode == GameMode::PLAYING && state.rogueWaveCooldown <= 0.0f) {
+         int required = RogueSystem::bricksRequiredForWave(state.wave);
+         float minT   = RogueSystem::minTimeForWave(state.wave);
+         float limit  = RogueSystem::timeLimitForWave(state.wave);
+ 
+         bool quotaMet = (state.rogueWaveTimer >= minT) && (state.rogueBricksBrokenThisWave >= required);
+         bool timeMet  = (state.rogueWaveTimer >= limit);
+ 
+         if (quotaMet || timeMet) {
+             int clearedWave = std::max(1, state.wave);
+ 
+             // Garante que o bank entra no score antes da transição.
+             commitStreak(state);
+             updateBest(state, events);
+ 
+             // Vitória do Rogue (fim da run)
+             if (RogueSystem::shouldWinAfterClearingWave(state, clearedWave)) {
+                 state.mode = GameMode::WIN;
+                 state.balls.clear();
+                 state.powerups.clear();
+                 events.push_back({SimEventType::RunComplete, clearedWave});
+                 return StepResult::WaveBreak;
+             }
+ 
+             // Avança wave
+             state.wave = clearedWave + 1;
+             RogueSystem::onWaveAdvanced(state);
+ 
+             // Queue de rows para inserir após card-pick (spawn gradual).
+             state.roguePendingRowsToSpawn = RogueSystem::rowsToInsertForWave(state, state.wave);
+ 
+             // Oferta de cartas (com OP pack a cada 3 waves “no início” do act)
+             if (RogueSystem::shouldOfferCardsAfterClearingWave(state, clearedWave)) {
+                 int nextWave = std::max(1, clearedWave + 1);
+                 bool opPack = (nextWave % 3) == 0 && nextWave >= 3;
+                 game::rogue::dealOffer(state, 3, opPack, nextWave);
+ 
+                 state.mode = GameMode::ROGUE_CARDS;
+                 state.hoveredRogueCard = -1;
+                 state.hoveredRogueCardPickButton = -1;
+             }
+             return StepResult::WaveBreak;
+         }
+     }
+ 
+     // Rogue: spawn gradual de rows “queued” (1 row por intervalo).
+     if (state.gameType == GameType::ROGUE && state.mode == GameMode::PLAYING && state.roguePendingRowsToSpawn > 0) {
+         if (state.rogueRowSpawnTimer <= 0.0f) {
+             RogueSystem::spawnWaveRows(state, cfg, /*rowsToInsert=*/1);
+             state.roguePendingRowsToSpawn--;
+             state.rogueRowSpawnTimer = state.rogueRowSpawnInterval;
+         }
+     }
+ 
+     // ------------------------------------------------------------------
+     // Endless: spawns queued
+     // ------------------------------------------------------------------
+     if (state.gameType == GameType::ENDLESS && state.pendingSpawnBricks > 0) {
+         InitSystem::spawnIncrementalBricks(state, cfg, state.pendingSpawnBricks, state.wave);
+         state.pendingSpawnBricks = 0;
+     }
+ 
+     // Endless: pressão por tempo (intervalo desce ao longo da run, com grace).
+     if (state.gameType == GameType::ENDLESS && state.mode == GameMode::PLAYING && state.endlessSpawnCooldown <= 0.0f) {
+         const float t = state.endlessElapsedTime;
+ 
+         const float grace = 60.0f;
+         if (t < grace) {
+             state.endlessAutoTimer = 0.0f;
+         } else {
+             float u = std::min(1.0f, (t - grace) / 540.0f); // 0..1 (9 min)
+             float interval = 26.0f - (14.0f * u);
+             interval = std::max(12.0f, interval);
+ 
+             if (state.pendingSpawnBricks < 12 && state.endlessAutoTimer >= interval) {
+                 state.pendingSpawnBricks += 12;
+                 state.endlessSpawnCooldown = 0.50f;
+                 state.endlessAutoTimer = 0.0f;
+             }
+         }
+     }
+ 
+     // ------------------------------------------------------------------
+     // Endless/Rogue: danger + lose (bricks chegam ao paddle)
+     // ------------------------------------------------------------------
+     if (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) {
+         float limitZ = state.paddlePos.z - 0.5f;
+         float warningThresholdZ = limitZ - (1.33f * 3.0f);
+ 
+         // Row viva mais funda do ring: O(1), sem percorrer os bricks.
+         bool anyAlive = state.bricks.aliveCount() > 0;
+         float maxZFound = anyAlive ? state.bricks.deepestMaxZ() : -20.0f;
+ 
+         if (anyAlive && maxZFound >= limitZ) {
+             commitStreak(state);
+             updateBest(state, events);
+             state.mode = GameMode::GAME_OVER;
+             state.balls.clear();
+         }
+ 
+         if (state.mode != GameMode::GAME_OVER) {
+             state.endlessDangerActive = (anyAlive && maxZFound >= warningThresholdZ);
+             if (state.endlessDangerActive) {
+                 state.endlessDangerTimer += dt;
+                 state.endlessDangerMaxZ = maxZFound;
+             } else {
+                 state.endlessDangerTimer = 0.0f;
+                 state.endlessDangerMaxZ = -20.0f;
+             }
+         }
+     }
+ 
+     // ------------------------------------------------------------------
+     // Powerups
+     // ------------------------------------------------------------------
+     PowerUpSystem::updatePowerUps(state, cfg, dt);
+ 
+     // Drop: só quando passa de “não há” -> “há”.
+     if (!state.powerups.empty() && !hadPowerupBefore) {
+         events.push_back({SimEventType::PowerupDropped, 0});
+     }
+ 
+     // Spawned types (silenciado para não spammar; o drop já vende o momento)
+     state.audioSpawnedPowerups.clear();
+ 
+     for (auto t : state.audioPickedPowerups) {
+         events.push_back({SimEventType::PowerupPicked, (int)t});
+     }
+     state.audioPickedPowerups.clear();
+ 
+     // ------------------------------------------------------------------
+     // Perda de vida (quando não há bolas e não estamos em finisher)
+     // ------------------------------------------------------------------
+     if (!state.winFinisherActive && state.balls.empty()) {
+         state.lives--;
+         events.push_back({SimEventType::LifeLost, state.lives});
+ 
+         // Penalidade por perder vida
+         int lossPenalty = cfg.lifeLossPenalty;
+         if (state.gameType == GameType::ROGUE) {
+             lossPenalty += state.rogueLifeLossPenaltyBonus;
+             if (lossPenalty < 0) lossPenalty = 0;
+         }
+ 
+         if (lossPenalty > 0) {
+             if (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) {
+                 // Penalidade entra no bank (pode ficar negativo), commit depois.
+                 state.endlessStreakPoints -= lossPenalty;
+                 state.endlessStreakNegPoints += lossPenalty;
+                 state.endlessStreakIdleTimer = 0.0f;
+                 state.endlessStreakBanking = false;
+                 state.endlessStreakBankTimer = 0.0f;
+             } else {
+                 // Normal: direto no score, clamp >= 0
+                 state.score = std::max(0, state.score - lossPenalty);
+             }
+         }
+ 
+         // Ainda há vidas -> respawn bola attached
+         if (state.lives > 0) {
+             Ball b;
+             PhysicsSystem::resetBallToPaddle(b, state.paddlePos, cfg);
+             state.balls.add(b);
+         } else {
+             // Run acabou: commit bank e atualiza bests.
+             if (state.gameType == GameType::ENDLESS || state.gameType == GameType::ROGUE) {
+                 commitStreak(state);
+                 updateBest(state, events);
+             }
+             // Se ainda há bricks -> GAME_OVER; se não há -> WIN.
+             state.mode = InitSystem::anyBricksAlive(state) ? GameMode::GAME_OVER : GameMode::WIN;
+         }
+     }
+ 
+     return StepResult::Played;
+ }
+ 
+ } // namespace game
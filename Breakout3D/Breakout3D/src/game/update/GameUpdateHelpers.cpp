@@ -1,20 +1,18 @@
 // GameUpdateHelpers.cpp
 /**
  * @file GameUpdateHelpers.cpp
- * @brief Helpers do Game para Endlessness (best score + commit do streak bank).
+ * @brief Helpers do Game para Endlessness (persistência do best score) e escrita do replay da run.
  *
  * Conceitos:
- *  - Endless/Rogue usam “streak bank” (endlessStreakPoints):
- *      - ganha pontos -> acumula no bank
- *      - penalidades -> podem tornar o bank negativo
- *      - commit -> soma bank ao score real (com clamp >= 0), e limpa estado do bank
+ *  - O commit do “streak bank” e a comparação com o best vivem no SimulationSystem
+ *    (commitStreak/updateBest); quando o best sobe, o passo emite SimEventType::EndlessBest.
  *
  * Persistência:
  *  - Best score é guardado num ficheiro no $HOME (se existir) ou fallback local.
+ *  - O replay da última run vai para o mesmo sítio (ou para B3D_REPLAY_OUT, se definido).
  */
  #include "game/Game.hpp"
 
- #include <algorithm>
  #include <cstdlib>
  #include <fstream>
  
@@ -34,46 +32,25 @@
      f << best;
  }
  
- /**
-  * @brief Converte o bank (positivo ou negativo) em score real, e limpa o estado do bank.
-  *
-  * Regras:
-  *  - Se bank == 0, não faz nada (evita trabalho inútil).
-  *  - score nunca fica negativo (clamp a 0).
-  *  - limpa também contadores auxiliares (pos/neg) e timers do sistema de banking.
-  */
- void Game::commitEndlessStreak(GameState& state) {
-     if (state.endlessStreakPoints == 0) return;
- 
-     // Bank pode ser negativo devido a penalidades.
-     state.score = std::max(0, state.score + state.endlessStreakPoints);
- 
-     // Reset total e breakdown (pos/neg)
-     state.endlessStreakPoints = 0;
-     state.endlessStreakPosPoints = 0;
-     state.endlessStreakNegPoints = 0;
- 
-     // Reset timers/flags do “banking”
-     state.endlessStreakIdleTimer = 0.0f;
-     state.endlessStreakBanking = false;
-     state.endlessStreakBankTimer = 0.0f;
+ std::string Game::replayPath() {
+     if (const char* out = std::getenv("B3D_REPLAY_OUT"); out && *out) return out;
+     const char* home = std::getenv("HOME");
+     if (home && *home) {
+         return std::string(home) + "/.breakout3d_last.b3dr";
+     }
+     return "breakout3d_last.b3dr";
  }
  
- /**
-  * @brief Atualiza best score do Endless (se aplicável).
-  *
-  * Nota:
-  *  - Só atualiza no modo ENDLESS.
-  *  - Assumimos que state.endlessBestScore já foi carregado no init().
-  */
- void Game::maybeUpdateEndlessBest(GameState& state) {
-     if (state.gameType != GameType::ENDLESS) return;
+ // Escreve o replay da run em curso (se houver). Só sobrescreve o ficheiro se a run chegou a jogar.
+ void Game::finishReplay() {
+     if (!m_replayRec.active()) return;
+     const bool played = m_replayRec.tick() > 0;
+     std::vector<std::uint8_t> bytes = m_replayRec.finish(m_state.mode);
+     if (!played) return;
  
-     if (state.score > state.endlessBestScore) {
-         state.endlessBestScore = state.score;
-         saveEndlessBestScore(state.endlessBestScore);
-     }
+     std::ofstream f(replayPath(), std::ios::binary | std::ios::trunc);
+     if (!f) return;
+     f.write((const char*)bytes.data(), (std::streamsize)bytes.size());
  }
  
  } // namespace game
- 
\ No newline at end of file
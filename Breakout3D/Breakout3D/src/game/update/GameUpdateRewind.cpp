@@ -0,0 +1,114 @@
+// GameUpdateRewind.cpp
+/**
+ * @file GameUpdateRewind.cpp
+ * @brief Rewind no modo Levels e seek no playback de replays, sobre o SnapshotRing do Game.
+ *
+ * Responsabilidades:
+ *  - Tirar um snapshot do estado de simulação a cada 0.5 s de jogo (só em Levels e em playback).
+ *  - Levels: BACKSPACE (em jogo ou no game over) volta ~2 s atrás e o jogo continua dali; a
+ *    gravação do replay é cortada no mesmo ponto, por isso o ficheiro continua a reproduzir.
+ *  - Playback: setas esquerda/direita saltam 5 s (`replaySeek`, Replay.hpp): para trás repõe o
+ *    snapshot mais próximo e avança sem áudio até ao tick pedido; para a frente só avança.
+ *
+ * Notas:
+ *  - Cada entrada do ring leva, depois do GameState, a marca do recorder (Levels) ou o cursor
+ *    do player (playback): estado e stream de input voltam juntos.
+ *  - Depois de um salto, o próximo passo trata-o como uma saída de pausa: a música volta à do
+ *    estado novo sem stingers nem SFX de vida/wave.
+ */
+ #include "game/Game.hpp"
+ #include "game/Snapshot.hpp"
+
+ namespace game {
+
+ static constexpr std::uint32_t kRewindEveryTicks = 120;  // 0.5 s a 240 Hz
+ static constexpr int kRewindCapacity = 64;                // 32 s de histórico
+ static constexpr std::uint64_t kRewindStepTicks = 480;    // BACKSPACE: ~2 s
+ static constexpr std::uint64_t kSeekStepTicks = 1200;     // setas no playback: 5 s
+
+ bool Game::rewindEnabled() const {
+     return m_replayPlayback || m_state.gameType == GameType::LEVELS;
+ }
+
+ std::uint64_t Game::rewindTick() const {
+     return m_replayPlayback ? m_replayPlayer.tick() : m_replayRec.tick();
+ }
+
+ void Game::resetRewind() {
+     m_rewind.reset(kRewindCapacity, kRewindEveryTicks);
+     captureRewind(); // tick 0: o início do nível/replay
+ }
+
+ void Game::captureRewind() {
+     if (!rewindEnabled()) return;
+     const std::uint64_t tick = rewindTick();
+     if (!m_rewind.due(tick)) return;
+
+     if (m_replayPlayback) {
+         replayKeyframe(m_replayPlayer, m_rewind, m_state);
+         return;
+     }
+     SnapshotWriter w = m_rewind.push(tick, m_state);
+     w.pod(m_replayRec.mark());
+ }
+
+ // Levels: estado + marca do recorder (o playback usa o replaySeek, com o cursor do player).
+ bool Game::restoreRewind(int index) {
+     SnapshotReader r = m_rewind.reader(index);
+     ReplayRecorder::Mark mark;
+     if (!loadSnapshot(m_state, r) || !r.pod(mark)) return false;
+     m_replayRec.rewind(mark);
+     return true;
+ }
+
+ void Game::afterStateJump(const SimSnapshot& before) {
+     m_simBefore = captureSimSnapshot();
+     m_simBefore.mode = GameMode::PAUSED;   // próximo passo: "saída de pausa" (música do estado novo)
+     m_simBefore.danger = before.danger;    // o loop de danger liga/desliga conforme o estado novo
+     m_simBeforeHeld = true;
+     m_prevMode = m_state.mode;
+     m_sim.reset();
+ }
+
+ void Game::seekReplay(std::uint64_t target) {
+     const SimSnapshot before = captureSimSnapshot();
+     const bool paused = m_state.mode == GameMode::PAUSED;
+
+     // Sem áudio: os eventos dos passos saltados são descartados.
+     replaySeek(m_replayPlayer, m_rewind, m_state, m_cfg, target, m_sim.step(), m_simEvents);
+
+     if (paused && m_state.mode == GameMode::PLAYING) m_state.mode = GameMode::PAUSED;
+     afterStateJump(before);
+ }
+
+ void Game::updateRewind(const engine::Input& input) {
+     // Playback: setas = seek (o input do jogo vem do replay, as setas estão livres).
+     if (m_replayPlayback) {
+         if (m_state.mode != GameMode::PLAYING && m_state.mode != GameMode::PAUSED) return;
+         const std::uint64_t tick = m_replayPlayer.tick();
+         if (input.keyPressed(engine::Key::Left)) seekReplay(tick > kSeekStepTicks ? tick - kSeekStepTicks : 0);
+         else if (input.keyPressed(engine::Key::Right)) seekReplay(tick + kSeekStepTicks);
+         return;
+     }
+
+     // Levels: BACKSPACE volta atrás (também a partir do game over: "retry" perto de onde se perdeu).
+     if (m_state.gameType != GameType::LEVELS || !input.keyPressed(engine::Key::Backspace)) return;
+     if (m_state.mode != GameMode::PLAYING && m_state.mode != GameMode::GAME_OVER) return;
+     if (m_state.winFinisherActive) return;
+
+     const SimSnapshot before = captureSimSnapshot();
+     const std::uint64_t tick = m_replayRec.tick();
+     int i = m_rewind.find(tick > kRewindStepTicks ? tick - kRewindStepTicks : 0);
+     if (i < 0 && m_rewind.size() > 0) i = 0; // mais atrás do que o ring guarda: o mais antigo
+     if (i < 0) return;
+
+     if (!restoreRewind(i)) {
+         init(); // snapshot inválido (não devia acontecer): recomeça o nível
+         return;
+     }
+     m_rewind.dropAfter(i); // o "futuro" abandonado não volta
+     m_audio.playSfx("ui/ui_back");
+     afterStateJump(before);
+ }
+
+ } // namespace game
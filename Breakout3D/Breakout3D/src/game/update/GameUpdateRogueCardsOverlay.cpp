@@ -66,6 +66,7 @@
              m_audio.playSfx("rogue/rogue_card_pick", -2.0f);
              m_audio.playStinger("stinger_card_pick", +2.0f);
  
+             m_replayRec.pick(m_state.hoveredRogueCard, m_state.rogueOffer[m_state.hoveredRogueCard]);
              game::rogue::applyPickedCard(m_state, m_cfg, m_state.rogueOffer[m_state.hoveredRogueCard]);
  
              // Se o draft terminou e voltámos ao gameplay, iniciar cadência de spawn das rows.
@@ -2,17 +2,30 @@
 #include "engine/Time.hpp"
 #include "engine/Renderer.hpp"
 #include "engine/Input.hpp"
+#include "engine/AssetFS.hpp"
+#include "engine/FramePacer.hpp"
 
 #include "game/Game.hpp"
 #include "game/GameAssets.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 /*
     Entry point:
     - Cria janela, renderer e carrega assets.
     - Corre loop principal:
-        tick time -> poll events -> update input -> update game -> render game
+        tick time -> poll events -> update input -> submit input -> render snapshot -> pace
+      (a simulação corre no seu thread: input -> update -> publish snapshot)
+    - Pacing (V-Sync desligado): FPS alvo = refresh do monitor (ou B3D_TARGET_FPS; 0 = sem limite);
+      menu/pausa/fim de jogo descem para 30 FPS, janela minimizada para 5 FPS.
+    - B3D_FRAME_STATS=<segundos> imprime CPU% e jitter por modo nesse intervalo (e no fim).
 */
 int main() {
+    // Assets empacotados (opcional): com assets.b3dpak presente, os loaders lêem do pack (mmap).
+    // Sem pack, tudo vem dos ficheiros soltos em assets/. O mapping vive até ao fim do processo.
+    engine::AssetFS::mountPack("assets.b3dpak");
+
     engine::Window window;
     // Slightly taller default window so the big menu title fits above the options cleanly.
     if (!window.create(1280, 900, "Breakout3D")) return -1;
@@ -34,15 +47,40 @@ int main() {
     game::Game game(window, time, renderer, assets);
     // Não chamar init() aqui - o jogo começa no estado MENU.
 
+    engine::FramePacer pacer;
+    {
+        int hz = window.refreshRate();
+        pacer.setTargetFps(hz > 0 ? (double)hz : 144.0);
+        if (const char* fps = std::getenv("B3D_TARGET_FPS"); fps && *fps) pacer.setTargetFps(std::atof(fps));
+    }
+    const char* statsEnv = std::getenv("B3D_FRAME_STATS");
+    const bool frameStats = statsEnv && *statsEnv;
+    if (frameStats) pacer.setStatsInterval(std::max(1.0, std::atof(statsEnv)));
+
+    // Simulação no seu próprio thread (B3D_SIM_THREAD=0 corre-a em série neste thread).
+    const char* simEnv = std::getenv("B3D_SIM_THREAD");
+    const bool simThreaded = !(simEnv && simEnv[0] == '0');
+    game.startSimulation(simThreaded);
+
     while (!window.shouldClose()) {
         time.tick();
         window.pollEvents();
 
         input.update(window);
-        game.update(input);
+        game.submitInput(input);
+        if (!simThreaded) game.tickSimulation();
         game.render();
+
+        engine::FramePacer::Mode paceMode = engine::FramePacer::Mode::Active;
+        if (window.isIconified()) paceMode = engine::FramePacer::Mode::Background;
+        else if (game.isIdle()) paceMode = engine::FramePacer::Mode::Idle;
+        pacer.endFrame(window, paceMode);
     }
 
+    if (frameStats) pacer.logStats(false);
+
+    game.stopSimulation();
+
     assets.destroy();
     renderer.shutdown();
     window.destroy();
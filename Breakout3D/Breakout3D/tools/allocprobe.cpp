@@ -0,0 +1,300 @@
+// allocprobe.cpp
+// -----------------------------------------------------------------------------
+// allocprobe.cpp
+//
+// Responsabilidade:
+//  - Conta as alocações (operator new global substituído) durante gameplay headless e falha se
+//    houver alguma depois do aquecimento: em regime, o passo fixo não pode ir ao malloc.
+//  - Joga com o bot (tools/sim_bot.hpp) em todos os modos e força drops de FIREBALL para
+//    encher as pools de FX (explosões, shards, popups); copia o GameState a cada 4 passos,
+//    como o snapshot de render do jogo.
+//  - Antes dos jogos, verifica os handles de `engine::Pool<..., true>` (nenhuma pool do
+//    GameState os usa, por isso o gameplay não os exercita).
+//
+// Uso:
+//  allocprobe [--games N] [--warmup S] [--seconds S] [--fireball-every S] [--seed N]
+//    --games           jogos por modo (default 4); o jogo g usa o seed `seed + g`
+//    --warmup          segundos de jogo sem contar (default 10): buffers chegam à capacidade
+//    --seconds         segundos contados por jogo (default 120)
+//    --fireball-every  um drop de FIREBALL em cima do paddle a cada S segundos (default 2, 0 = nunca)
+//
+// Notas:
+//  - Só contam as alocações dentro de cada fase medida (passo, pick, cópia); o resto
+//    (init, prints) fica de fora.
+//  - Mostra por modo: passos contados, alocações (passos / picks de cartas / cópias do estado) e
+//    os high-water marks das pools do GameState e os spawns recusados por pool cheia.
+//  - Handles: um handle tem de sobreviver a swapRemove/removeIf/remove de outros elementos e à
+//    cópia da pool, e deixar de resolver depois da sua remoção (ou do clear), mesmo com o slot
+//    reutilizado. Qualquer falha sai com 1, como as alocações.
+// -----------------------------------------------------------------------------
+
+#include "engine/Pool.hpp"
+#include "game/systems/InitSystem.hpp"
+#include "game/rogue/RogueCards.hpp"
+#include "sim_bot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ---------------------------------------------------------------------------
+// Contador global (substitui o operator new/delete do programa inteiro)
+// ---------------------------------------------------------------------------
+namespace {
+
+std::atomic<bool> g_counting{false};
+std::atomic<std::uint64_t> g_allocs{0};
+std::atomic<std::uint64_t> g_bytes{0};
+
+void* countedAlloc(std::size_t n) {
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(n, std::memory_order_relaxed);
+    }
+    return std::malloc(n ? n : 1);
+}
+
+void* countedAlignedAlloc(std::size_t n, std::align_val_t al) {
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(n, std::memory_order_relaxed);
+    }
+    const std::size_t a = std::max(sizeof(void*), (std::size_t)al);
+    return std::aligned_alloc(a, (std::max<std::size_t>(n, 1) + a - 1) / a * a);
+}
+
+} // namespace
+
+void* operator new(std::size_t n) {
+    if (void* p = countedAlloc(n)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) {
+    if (void* p = countedAlloc(n)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+void* operator new(std::size_t n, std::align_val_t al) {
+    if (void* p = countedAlignedAlloc(n, al)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n, std::align_val_t al) {
+    if (void* p = countedAlignedAlloc(n, al)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+using game::GameConfig;
+using game::GameMode;
+using game::GameState;
+using game::GameType;
+using simbot::kStep;
+
+// Alocações feitas durante o tempo de vida do objecto (acumula em `total`).
+struct Phase {
+    std::uint64_t& total;
+    std::uint64_t at;
+    explicit Phase(std::uint64_t& t) : total(t), at(g_allocs.load()) { g_counting = true; }
+    ~Phase() {
+        g_counting = false;
+        total += g_allocs.load() - at;
+    }
+};
+
+struct ModeResult {
+    long long steps = 0;
+    std::uint64_t stepAllocs = 0, pickAllocs = 0, copyAllocs = 0;
+    std::size_t maxPowerups = 0, maxExplosions = 0, maxShards = 0, maxPopups = 0;
+    std::uint32_t dropped = 0;
+};
+
+void runGame(const GameConfig& cfg, GameType type, std::uint64_t seed, long long warmupSteps,
+             long long countSteps, long long fireballEvery, ModeResult& out) {
+    GameState s;
+    s.gameType = type;
+    s.wave = 1;
+    s.currentLevel = 1;
+    game::InitSystem::initGame(s, cfg, seed);
+
+    simbot::Bot bot(seed);
+    game::SimEvents events;
+    events.reserve(64);
+    GameState render = s; // o "snapshot de render": copy-assign reutiliza a capacidade dele
+
+    const long long total = warmupSteps + countSteps;
+    for (long long step = 0; step < total; ++step) {
+        const bool counted = step >= warmupSteps;
+        std::uint64_t ignored = 0;
+
+        if (s.mode == GameMode::ROGUE_CARDS) {
+            if (s.rogueOfferCount <= 0) break;
+            Phase ph(counted ? out.pickAllocs : ignored);
+            int slot = (int)(bot.rng() % (unsigned)s.rogueOfferCount);
+            game::rogue::applyPickedCard(s, cfg, s.rogueOffer[slot]);
+            if (s.mode == GameMode::PLAYING) s.rogueRowSpawnTimer = 0.15f;
+            continue;
+        }
+        if (s.mode != GameMode::PLAYING) break;
+
+        {
+            Phase ph(counted ? out.stepAllocs : ignored);
+            if (fireballEvery > 0 && step % fireballEvery == fireballEvery - 1) {
+                game::PowerUp p;
+                p.type = game::PowerUpType::FIREBALL;
+                p.pos = glm::vec3(s.paddlePos.x, 0.4f, s.paddlePos.z - 1.0f);
+                s.powerups.push(p);
+            }
+            bot.drive(s, cfg);
+            events.clear();
+            auto r = game::SimulationSystem::step(s, cfg, kStep, events);
+            for (const auto& e : events) bot.observe(e);
+            if (r == game::SimulationSystem::StepResult::FieldCleared) break;
+        }
+        if ((step & 3) == 0) {
+            Phase ph(counted ? out.copyAllocs : ignored);
+            render = s;
+        }
+        if (counted) out.steps++;
+
+        out.maxPowerups = std::max(out.maxPowerups, s.powerups.size());
+        out.maxExplosions = std::max(out.maxExplosions, s.fireballExplosions.size());
+        out.maxShards = std::max(out.maxShards, s.fireballShards.size());
+        out.maxPopups = std::max(out.maxPopups, s.scorePopups.size());
+    }
+    out.dropped += s.powerups.dropped() + s.fireballExplosions.dropped() + s.fireballShards.dropped() +
+                   s.scorePopups.dropped();
+}
+
+// Handles de Pool<int, 8, true>: valor = id do elemento, para saber a quem o handle resolve.
+int checkPoolHandles() {
+    using HandlePool = engine::Pool<int, 8, true>;
+    int failures = 0;
+    auto expect = [&](bool ok, const char* what) {
+        if (!ok) {
+            std::printf("pool handles: FAILED %s\n", what);
+            failures++;
+        }
+    };
+    auto resolvesTo = [](const HandlePool& p, engine::PoolHandle h, int v) {
+        const int* e = p.get(h);
+        return e && *e == v;
+    };
+    auto indexOf = [](const HandlePool& p, int v) {
+        for (std::size_t i = 0; i < p.size(); ++i)
+            if (p[i] == v) return i;
+        return p.size();
+    };
+
+    HandlePool p;
+    engine::PoolHandle h[13];
+    for (int v = 0; v < 8; ++v) {
+        p.push(v);
+        h[v] = p.handleAt(p.size() - 1);
+    }
+    expect(!p.push(99) && p.dropped() == 1, "push on a full pool");
+
+    // swapRemove do 2: o 7 vem para o lugar dele, os outros continuam a resolver.
+    p.swapRemove(indexOf(p, 2));
+    expect(!p.get(h[2]), "handle resolves after its swapRemove");
+    for (int v : {0, 1, 3, 4, 5, 6, 7}) expect(resolvesTo(p, h[v], v), "handle lost after swapRemove of another");
+
+    // removeIf dos múltiplos de 3 (compacta pela ordem).
+    p.removeIf([](int v) { return v % 3 == 0; });
+    for (int v : {0, 3, 6}) expect(!p.get(h[v]), "handle resolves after its removeIf");
+    for (int v : {1, 4, 5, 7}) expect(resolvesTo(p, h[v], v), "handle lost after removeIf of others");
+
+    // remove por handle: só uma vez.
+    expect(p.remove(h[5]), "remove(handle) of a live element");
+    expect(!p.remove(h[5]) && !p.get(h[5]), "second remove(handle) of the same element");
+    for (int v : {1, 4, 7}) expect(resolvesTo(p, h[v], v), "handle lost after remove(handle) of another");
+
+    // Reencher: os slots livres são reutilizados e os handles antigos continuam mortos.
+    for (int v = 8; v < 13; ++v) {
+        p.push(v);
+        h[v] = p.handleAt(p.size() - 1);
+    }
+    expect(p.full(), "refill to capacity");
+    for (int v : {0, 2, 3, 5, 6}) expect(!p.get(h[v]), "stale handle resolves after slot reuse");
+    for (int v : {1, 4, 7}) expect(resolvesTo(p, h[v], v), "handle lost after refill");
+    for (int v = 8; v < 13; ++v) expect(resolvesTo(p, h[v], v), "new handle after slot reuse");
+
+    // Cópia (snapshot de render): handles resolvem na cópia como no original.
+    const HandlePool copy = p;
+    for (int v : {1, 4, 7}) expect(resolvesTo(copy, h[v], v), "handle lost in a copy");
+    expect(!copy.get(h[2]), "stale handle resolves in a copy");
+
+    p.clear();
+    for (int v : {1, 4, 7}) expect(!p.get(h[v]), "handle resolves after clear");
+    p.push(42);
+    for (int v : {1, 4, 7}) expect(!p.get(h[v]), "handle resolves after clear + slot reuse");
+
+    if (failures == 0) std::printf("pool handles: ok\n");
+    return failures;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int games = 4;
+    float warmup = 10.0f, seconds = 120.0f, fireballEvery = 2.0f;
+    std::uint64_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--games") && i + 1 < argc) games = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--warmup") && i + 1 < argc) warmup = std::max(0.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--fireball-every") && i + 1 < argc) fireballEvery = std::max(0.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: allocprobe [--games N] [--warmup S] [--seconds S] [--fireball-every S] [--seed N]\n");
+            return 2;
+        }
+    }
+
+    const int handleFailures = checkPoolHandles();
+
+    const GameConfig cfg;
+    const long long warmupSteps = (long long)(warmup / kStep);
+    const long long countSteps = (long long)(seconds / kStep);
+    const long long fbEvery = (long long)(fireballEvery / kStep);
+
+    const struct { GameType type; const char* name; } modes[] = {
+        { GameType::NORMAL, "normal" }, { GameType::ENDLESS, "endless" },
+        { GameType::ROGUE, "rogue" },   { GameType::LEVELS, "levels" },
+    };
+
+    std::printf("%-8s | %9s | %6s | %6s | %6s | %-24s | %s\n",
+                "mode", "steps", "step", "pick", "copy", "pool max (pu/ex/sh/pop)", "refused");
+    std::uint64_t totalAllocs = 0;
+    for (const auto& m : modes) {
+        ModeResult r;
+        for (int g = 0; g < games; ++g) runGame(cfg, m.type, seed + (std::uint64_t)g, warmupSteps, countSteps, fbEvery, r);
+        char pools[64];
+        std::snprintf(pools, sizeof(pools), "%zu/%zu/%zu/%zu", r.maxPowerups, r.maxExplosions, r.maxShards, r.maxPopups);
+        std::printf("%-8s | %9lld | %6llu | %6llu | %6llu | %-24s | %u\n", m.name, r.steps,
+                    (unsigned long long)r.stepAllocs, (unsigned long long)r.pickAllocs,
+                    (unsigned long long)r.copyAllocs, pools, r.dropped);
+        totalAllocs += r.stepAllocs + r.pickAllocs + r.copyAllocs;
+    }
+
+    if (handleFailures > 0) return 1;
+    if (totalAllocs > 0) {
+        std::printf("%llu allocation(s) after warm-up (%llu bytes)\n", (unsigned long long)totalAllocs,
+                    (unsigned long long)g_bytes.load());
+        return 1;
+    }
+    std::printf("no allocations after warm-up\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+// b3dpak.cpp
+// -----------------------------------------------------------------------------
+// b3dpak.cpp
+//
+// Responsabilidade:
+//  - Empacotar a pasta de assets num único ficheiro .b3dpak (ver engine/PakFormat.hpp).
+//  - Listar o índice de um pack existente (--list), para debug.
+//
+// Uso:
+//  b3dpak <assetsDir> <out.b3dpak>     (ex.: b3dpak assets assets.b3dpak)
+//  b3dpak --list <file.b3dpak>
+//
+// Notas:
+//  - Só entram extensões usadas em runtime (os .blend e afins ficam de fora).
+//  - Os nomes são os paths lógicos que o jogo pede (ex.: "assets/models/Ball.obj").
+//  - Payloads guardados sem compressão (PNG/GIF já vêm comprimidos e o WAV é lido
+//    directamente do mmap pelo áudio); o formato reserva kFlagZlib para o futuro.
+// -----------------------------------------------------------------------------
+
+#include "engine/PakFormat.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace pak = engine::pak;
+
+namespace {
+
+struct InputFile {
+    std::string name;        // path lógico normalizado
+    fs::path diskPath;
+    std::uint64_t hash = 0;
+    std::uint64_t size = 0;
+};
+
+bool isRuntimeAsset(const fs::path& p) {
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    static const char* kExts[] = {".obj", ".mtl", ".png", ".jpg", ".ktx2", ".gif", ".wav", ".ttf", ".vert", ".frag", ".txt"};
+    for (const char* e : kExts) {
+        if (ext == e) return true;
+    }
+    return false;
+}
+
+std::uint64_t alignUp(std::uint64_t v, std::uint64_t a) {
+    return (v + a - 1) / a * a;
+}
+
+void writePadding(std::ofstream& out, std::uint64_t from, std::uint64_t to) {
+    static const char zeros[256] = {};
+    while (from < to) {
+        std::uint64_t n = std::min<std::uint64_t>(sizeof(zeros), to - from);
+        out.write(zeros, (std::streamsize)n);
+        from += n;
+    }
+}
+
+int packDir(const std::string& rootArg, const std::string& outPath) {
+    fs::path root(rootArg);
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        std::cerr << "[b3dpak] not a directory: " << rootArg << "\n";
+        return 1;
+    }
+
+    std::vector<InputFile> files;
+    for (auto const& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        if (!isRuntimeAsset(entry.path())) continue;
+
+        InputFile f;
+        f.diskPath = entry.path();
+        f.name = pak::normalizePath(entry.path().generic_string());
+        f.hash = pak::hashPath(f.name);
+        f.size = (std::uint64_t)entry.file_size();
+        files.push_back(std::move(f));
+    }
+
+    // Índice ordenado por hash (nome como desempate, para o output ser determinístico).
+    std::sort(files.begin(), files.end(), [](const InputFile& a, const InputFile& b) {
+        if (a.hash != b.hash) return a.hash < b.hash;
+        return a.name < b.name;
+    });
+    for (size_t i = 1; i < files.size(); ++i) {
+        if (files[i].name == files[i - 1].name) {
+            std::cerr << "[b3dpak] duplicate entry: " << files[i].name << "\n";
+            return 1;
+        }
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[b3dpak] can't write: " << outPath << "\n";
+        return 1;
+    }
+
+    pak::Header hdr{};
+    std::memcpy(hdr.magic, pak::kMagic, sizeof(hdr.magic));
+    hdr.version = pak::kVersion;
+    hdr.entryCount = (std::uint32_t)files.size();
+    hdr.alignment = pak::kDefaultAlignment;
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr)); // placeholder
+
+    std::vector<pak::Entry> entries(files.size());
+    std::string names;
+    std::uint64_t pos = sizeof(hdr);
+    std::uint64_t payloadBytes = 0;
+    std::vector<char> buf;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        const InputFile& f = files[i];
+
+        std::uint64_t start = alignUp(pos, hdr.alignment);
+        writePadding(out, pos, start);
+        pos = start;
+
+        std::ifstream in(f.diskPath, std::ios::binary);
+        buf.resize((size_t)f.size);
+        if (!in || (f.size > 0 && !in.read(buf.data(), (std::streamsize)f.size))) {
+            std::cerr << "[b3dpak] can't read: " << f.diskPath.string() << "\n";
+            return 1;
+        }
+        out.write(buf.data(), (std::streamsize)f.size);
+        pos += f.size;
+        payloadBytes += f.size;
+
+        pak::Entry& e = entries[i];
+        e.hash = f.hash;
+        e.offset = start;
+        e.size = f.size;
+        e.rawSize = f.size;
+        e.nameOffset = (std::uint32_t)names.size();
+        e.flags = 0;
+
+        names += f.name;
+        names += '\0';
+    }
+
+    hdr.indexOffset = alignUp(pos, alignof(pak::Entry));
+    writePadding(out, pos, hdr.indexOffset);
+    out.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(pak::Entry)));
+    pos = hdr.indexOffset + entries.size() * sizeof(pak::Entry);
+
+    hdr.namesOffset = pos;
+    hdr.namesSize = names.size();
+    out.write(names.data(), (std::streamsize)names.size());
+    pos += names.size();
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    if (!out) {
+        std::cerr << "[b3dpak] write failed: " << outPath << "\n";
+        return 1;
+    }
+
+    std::printf("[b3dpak] %s: %zu files, %.2f MB payload, %.2f MB total\n",
+                outPath.c_str(), files.size(), payloadBytes / (1024.0 * 1024.0), pos / (1024.0 * 1024.0));
+    return 0;
+}
+
+int listPak(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    pak::Header hdr{};
+    if (!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)) ||
+        std::memcmp(hdr.magic, pak::kMagic, sizeof(hdr.magic)) != 0) {
+        std::cerr << "[b3dpak] not a pack: " << path << "\n";
+        return 1;
+    }
+
+    std::vector<pak::Entry> entries(hdr.entryCount);
+    std::string names((size_t)hdr.namesSize, '\0');
+    in.seekg((std::streamoff)hdr.indexOffset);
+    in.read(reinterpret_cast<char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(pak::Entry)));
+    in.seekg((std::streamoff)hdr.namesOffset);
+    in.read(names.data(), (std::streamsize)names.size());
+    if (!in) {
+        std::cerr << "[b3dpak] truncated pack: " << path << "\n";
+        return 1;
+    }
+
+    for (const auto& e : entries) {
+        std::printf("%016llx  %10llu  %10llu  %s%s\n",
+                    (unsigned long long)e.hash, (unsigned long long)e.offset, (unsigned long long)e.size,
+                    names.c_str() + e.nameOffset, (e.flags & pak::kFlagZlib) ? "  [zlib]" : "");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) return listPak(argv[2]);
+    if (argc == 3) return packDir(argv[1], argv[2]);
+
+    std::cerr << "usage: b3dpak <assetsDir> <out.b3dpak>\n"
+              << "       b3dpak --list <file.b3dpak>\n";
+    return 2;
+}
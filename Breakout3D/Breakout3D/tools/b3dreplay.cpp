@@ -0,0 +1,205 @@
+// b3dreplay.cpp
+// -----------------------------------------------------------------------------
+// b3dreplay.cpp
+//
+// Responsabilidade:
+//  - Playback headless de um replay (.b3dr, ver game/Replay.hpp) à velocidade máxima do CPU,
+//    sobre a libbreakout_sim.a: initGame com o seed gravado, input injectado tick a tick.
+//  - Confere os checksums do GameState gravados a cada N ticks e diz em que tick a run
+//    divergiu (desync), se divergiu.
+//
+// Uso:
+//  b3dreplay <file.b3dr> [--info] [--repeat N] [--seek N]
+//    --info     só mostra o header (não simula)
+//    --repeat   corre o playback N vezes (medir throughput de ficheiros curtos)
+//    --seek     N saltos para ticks aleatórios (para trás e para a frente) com keyframes no
+//               SnapshotRing; cada salto tem de dar o mesmo estado que o playback seguido
+//
+// Exit code: 0 = reproduziu até ao fim sem desync, 1 = desync/replay truncado, 2 = erro.
+//
+// Notas:
+//  - O replay vem do jogo (por omissão ~/.breakout3d_last.b3dr) ou do `breakout_sim --record`.
+//  - Um GameConfig diferente do da gravação (hash no header) é avisado: quase de certeza dá desync.
+//  - Para ver o mesmo replay renderizado em tempo real: B3D_REPLAY=<file.b3dr> ./breakout3d
+// -----------------------------------------------------------------------------
+
+#include "game/Replay.hpp"
+#include "game/Snapshot.hpp"
+#include "game/systems/SimulationSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+using game::GameConfig;
+using game::GameMode;
+using game::GameState;
+using game::GameType;
+using clock_type = std::chrono::steady_clock;
+
+constexpr float kStep = 1.0f / 240.0f;
+
+const char* modeName(GameType t) {
+    switch (t) {
+    case GameType::NORMAL: return "normal";
+    case GameType::ENDLESS: return "endless";
+    case GameType::ROGUE: return "rogue";
+    case GameType::LEVELS: return "levels";
+    }
+    return "?";
+}
+
+const char* gameModeName(GameMode m) {
+    switch (m) {
+    case GameMode::MENU: return "menu";
+    case GameMode::PLAYING: return "playing";
+    case GameMode::PAUSED: return "paused";
+    case GameMode::ROGUE_CARDS: return "rogue cards";
+    case GameMode::GAME_OVER: return "game over";
+    case GameMode::WIN: return "win";
+    }
+    return "?";
+}
+
+// Um playback completo. Pára no fim do replay, num desync, ou quando o jogo sai de
+// PLAYING sem o replay ter acabado (ex.: ficou em ROGUE_CARDS sem pick gravado).
+void playOnce(game::ReplayPlayer& player, const GameConfig& cfg, GameState& s) {
+    game::SimEvents events;
+    events.reserve(64);
+    player.begin(s, cfg);
+
+    while (!player.finished() && player.desyncTick() < 0) {
+        player.applyInputs(s, cfg);
+        // Em ROGUE_CARDS não correm ticks: o pick tinha de estar gravado neste tick.
+        if (s.mode != GameMode::PLAYING) break;
+
+        events.clear();
+        auto r = game::SimulationSystem::step(s, cfg, kStep, events);
+        player.afterStep(s);
+        if (r == game::SimulationSystem::StepResult::FieldCleared) break;
+    }
+}
+
+// Estado de referência no tick `tick`: playback seguido desde o início.
+std::uint64_t checksumAt(game::ReplayPlayer& player, const GameConfig& cfg, std::uint64_t tick) {
+    GameState s;
+    game::SnapshotRing none;
+    game::SimEvents events;
+    player.begin(s, cfg);
+    none.reset(1, 0xFFFFFFFFu);
+    game::replaySeek(player, none, s, cfg, tick, kStep, events);
+    return game::replayStateChecksum(s);
+}
+
+// Saltos pseudo-aleatórios pelo replay (mesma sequência sempre). @return nº de saltos errados.
+int seekCheck(game::ReplayPlayer& player, const GameConfig& cfg, int jumps, std::uint64_t endTick) {
+    GameState s;
+    game::SnapshotRing ring;
+    game::SimEvents events;
+    ring.reset(64, 240); // keyframe a cada 1 s, até 64 s para trás
+    player.begin(s, cfg);
+    game::replayKeyframe(player, ring, s);
+
+    std::uint64_t lcg = 0x2545F4914F6CDD1DULL;
+    std::vector<std::uint64_t> targets;
+    for (int i = 0; i < jumps; ++i) {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        targets.push_back((lcg >> 33) % std::max<std::uint64_t>(1, endTick));
+    }
+
+    int bad = 0;
+    double wallMs = 0.0;
+    std::uint64_t travelled = 0, from = 0;
+    std::vector<std::uint64_t> got;
+    for (std::uint64_t t : targets) {
+        auto t0 = clock_type::now();
+        const std::uint64_t at = game::replaySeek(player, ring, s, cfg, t, kStep, events);
+        wallMs += std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+        travelled += at > from ? at - from : from - at;
+        from = at;
+        got.push_back(at == t ? game::replayStateChecksum(s) : 0);
+    }
+
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        if (got[i] != checksumAt(player, cfg, targets[i])) {
+            std::printf("seek to tick %llu: state differs from a straight playback\n", (unsigned long long)targets[i]);
+            bad++;
+        }
+    }
+    std::printf("seek: %d jumps over %.0f s of game time, mean %.2f ms per jump, ring %zu KB, %s\n",
+                jumps, (double)travelled * kStep, jumps ? wallMs / jumps : 0.0, ring.memoryBytes() / 1024,
+                bad ? "MISMATCH" : "all match");
+    return bad;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool infoOnly = false;
+    int repeat = 1;
+    int seeks = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--info")) infoOnly = true;
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seek") && i + 1 < argc) seeks = std::max(0, std::atoi(argv[++i]));
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else {
+            std::fprintf(stderr, "usage: b3dreplay <file.b3dr> [--info] [--repeat N] [--seek N]\n");
+            return 2;
+        }
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: b3dreplay <file.b3dr> [--info] [--repeat N] [--seek N]\n");
+        return 2;
+    }
+
+    game::ReplayPlayer player;
+    std::string error;
+    if (!player.loadFile(path, &error)) {
+        std::fprintf(stderr, "b3dreplay: %s\n", error.c_str());
+        return 2;
+    }
+
+    const GameConfig cfg;
+    const auto& h = player.header();
+    const bool cfgMatch = h.configHash == game::replayConfigHash(cfg);
+    std::printf("%s: %zu bytes, %s (level %d), seed %llu, checksum every %u ticks, config %s\n",
+                path, player.sizeBytes(), modeName(h.type), h.level, (unsigned long long)h.seed,
+                h.checksumEvery, cfgMatch ? "matches" : "DIFFERS (expect a desync)");
+    if (infoOnly) return 0;
+
+    GameState s;
+    auto t0 = clock_type::now();
+    for (int r = 0; r < repeat; ++r) playOnce(player, cfg, s);
+    const double wall = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    const double simSeconds = (double)player.tick() * kStep;
+    std::printf("played %llu ticks (%.1f s of game time): %d launches, %d card picks, %d pauses, %d checksums\n",
+                (unsigned long long)player.tick(), simSeconds, player.launches(), player.picks(), player.pauses(),
+                player.checksVerified());
+    std::printf("final: %s, score %d, lives %d, wave %d (recorded end: %s)\n",
+                gameModeName(s.mode), s.score + s.endlessStreakPoints, s.lives, s.wave, gameModeName(player.endMode()));
+    std::printf("speed: %d playback(s) in %.3f s wall = %.0fx real time\n",
+                repeat, wall, wall > 0.0 ? simSeconds * repeat / wall : 0.0);
+
+    if (player.desyncTick() >= 0) {
+        std::printf("DESYNC at tick %lld (%.2f s)\n", player.desyncTick(), (double)player.desyncTick() * kStep);
+        return 1;
+    }
+    if (!player.finished()) {
+        std::printf("replay ended early at tick %llu of %llu\n",
+                    (unsigned long long)player.tick(), (unsigned long long)player.endTick());
+        return 1;
+    }
+    std::printf("in sync\n");
+
+    if (seeks > 0 && seekCheck(player, cfg, seeks, player.endTick()) > 0) return 1;
+    return 0;
+}
@@ -0,0 +1,219 @@
+// ballstorm.cpp
+// -----------------------------------------------------------------------------
+// ballstorm.cpp
+//
+// Responsabilidade:
+//  - Benchmark de física + colisões com milhares de bolas (o "ball storm" do build de debug).
+//  - Compara o caminho antigo (std::vector<Ball>, moveBall por bola, erase no meio) com o
+//    BallSet SoA (kernel de voo livre escalar/SSE2 + CCD só para as bolas perto de bricks/paddle).
+//  - Verifica que um passo do kernel dá o mesmo resultado que o moveBall (o kernel só é um
+//    atalho para bolas que não tocam em nada além das paredes).
+//
+// Uso:
+//  ballstorm [--rows N] [--steps N] [--seed N]
+//    --rows   rows de 12 bricks no topo (default 8)
+//    --steps  passos de 240 Hz por medição (default 240)
+//
+// Notas:
+//  - Bricks com HP "infinito" e shield sempre ligado: o campo e o nº de bolas não mudam, todas
+//    as versões fazem o mesmo trabalho durante a medição.
+//  - Níveis SIMD que o CPU não suporta caem para o escalar (ver BrickField::detectedSimd).
+// -----------------------------------------------------------------------------
+
+#include "game/systems/CollisionSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using game::Ball;
+using game::BallSet;
+using game::Brick;
+using game::CollisionSystem;
+using game::GameConfig;
+using game::GameState;
+using game::SimdLevel;
+using clock_type = std::chrono::steady_clock;
+
+constexpr float kStep = 1.0f / 240.0f;
+
+void makeState(GameState& s, const GameConfig& cfg, int rows) {
+    s = GameState();
+    s.gameType = game::GameType::ENDLESS;
+    s.mode = game::GameMode::PLAYING;
+    s.shieldTimer = 1e9f;
+    s.bricks.configureGrid(cfg.arenaMinX, cfg.arenaMaxX, cfg.arenaMinZ, cfg.arenaMaxZ,
+                           cfg.brickGridCellX, cfg.brickGridCellZ);
+    s.paddlePos = glm::vec3(0.0f, 0.0f, cfg.arenaMaxZ - cfg.paddleSize.z * 0.5f - 0.25f);
+
+    // Mesmo layout do InitSystem (Endless): 12 colunas, topo em arenaMinZ + 0.85.
+    const glm::vec3 size(2.95f, 0.7f, 1.30f);
+    const float gapX = 0.04f, gapZ = 0.03f;
+    const float totalW = 12 * size.x + 11 * gapX;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < 12; ++c) {
+            Brick b;
+            b.size = size;
+            b.pos = glm::vec3(-totalW * 0.5f + size.x * 0.5f + c * (size.x + gapX), 0.0f,
+                              cfg.arenaMinZ + 0.85f + r * (size.z + gapZ));
+            b.hp = b.maxHp = 1 << 30;
+            b.alive = true;
+            s.bricks.add(b);
+        }
+    }
+}
+
+std::vector<Ball> makeBalls(const GameConfig& cfg, const GameState& s, int n, std::mt19937& rng) {
+    // Espalhadas pela zona livre entre os bricks e o paddle, direcções aleatórias.
+    const float zTop = s.bricks.aliveCount() ? s.bricks.deepestMaxZ() + cfg.ballRadius + 0.1f : cfg.arenaMinZ + 1.0f;
+    const float zBot = s.paddlePos.z - 2.0f;
+    std::uniform_real_distribution<float> ux(cfg.arenaMinX + 1.0f, cfg.arenaMaxX - 1.0f), uz(zTop, zBot);
+    std::uniform_real_distribution<float> ua(0.0f, 6.2831853f);
+
+    std::vector<Ball> out((std::size_t)n);
+    for (auto& b : out) {
+        float a = ua(rng);
+        b.pos = glm::vec3(ux(rng), 0.0f, uz(rng));
+        b.vel = glm::vec3(std::cos(a), 0.0f, std::sin(a)) * cfg.ballSpeed;
+        b.attached = false;
+    }
+    return out;
+}
+
+// Caminho antigo: AoS + moveBall por bola + erase das mortas (a deslocar a cauda).
+double runAoS(GameState s, std::vector<Ball> balls, const GameConfig& cfg, int steps) {
+    auto t0 = clock_type::now();
+    for (int st = 0; st < steps; ++st) {
+        for (auto& b : balls) CollisionSystem::moveBall(b, s, cfg.paddleSize, cfg, kStep);
+        for (std::size_t i = 0; i < balls.size(); ) {
+            if (!balls[i].alive || balls[i].pos.z - cfg.ballRadius > 20.0f) balls.erase(balls.begin() + (long)i);
+            else i++;
+        }
+    }
+    return std::chrono::duration<double, std::micro>(clock_type::now() - t0).count() / steps;
+}
+
+// Caminho actual: BallSet + kernel + CCD nas lentas + swap-remove.
+double runSoA(GameState s, const std::vector<Ball>& init, const GameConfig& cfg, int steps, SimdLevel level,
+              double* fastShare) {
+    s.balls.clear();
+    for (const auto& b : init) s.balls.add(b);
+
+    auto t0 = clock_type::now();
+    for (int st = 0; st < steps; ++st) {
+        CollisionSystem::moveBalls(s, cfg.paddleSize, cfg, kStep, level);
+        s.balls.removeDead();
+        for (int i = 0; i < s.balls.size(); ) {
+            if (s.balls.pos(i).z - cfg.ballRadius > 20.0f) s.balls.removeAt(i);
+            else i++;
+        }
+    }
+    const double us = std::chrono::duration<double, std::micro>(clock_type::now() - t0).count() / steps;
+
+    // fracção de bolas que vão pelo kernel (amostrada no fim, já com as bolas espalhadas)
+    if (fastShare) {
+        std::vector<int> slow;
+        BallSet::FreeBounds fb{ cfg.arenaMinX, cfg.arenaMaxX, cfg.arenaMinZ,
+                                s.bricks.aliveCount() ? s.bricks.deepestMaxZ() : -1e30f,
+                                s.paddlePos.z - cfg.paddleSize.z * 0.5f, cfg.ballRadius,
+                                0.5f * std::min(cfg.arenaMaxX - cfg.arenaMinX, cfg.arenaMaxZ - cfg.arenaMinZ) - cfg.ballRadius };
+        s.balls.advanceFree(kStep, fb, slow, level);
+        *fastShare = s.balls.empty() ? 0.0 : 1.0 - (double)slow.size() / (double)s.balls.size();
+    }
+    return us;
+}
+
+// Um passo: kernel (qualquer nível) vs moveBall bola a bola. Devolve o maior desvio de posição.
+float oneStepDeviation(const GameState& base, const std::vector<Ball>& init, const GameConfig& cfg,
+                       SimdLevel level, int& velMismatch) {
+    GameState a = base;
+    std::vector<Ball> ref = init;
+    for (auto& b : ref) CollisionSystem::moveBall(b, a, cfg.paddleSize, cfg, kStep);
+
+    GameState s = base;
+    s.balls.clear();
+    for (const auto& b : init) s.balls.add(b);
+    CollisionSystem::moveBalls(s, cfg.paddleSize, cfg, kStep, level);
+
+    float maxDev = 0.0f;
+    velMismatch = 0;
+    for (int i = 0; i < s.balls.size(); ++i) {
+        glm::vec3 d = s.balls.pos(i) - ref[(std::size_t)i].pos;
+        maxDev = std::max(maxDev, std::max(std::abs(d.x), std::abs(d.z)));
+        glm::vec3 v = s.balls.vel(i), rv = ref[(std::size_t)i].vel;
+        if ((v.x < 0.0f) != (rv.x < 0.0f) || (v.z < 0.0f) != (rv.z < 0.0f)) velMismatch++;
+    }
+    return maxDev;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rows = 8, steps = 240;
+    unsigned seed = 1234u;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--rows") && i + 1 < argc) rows = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--steps") && i + 1 < argc) steps = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: ballstorm [--rows N] [--steps N] [--seed N]\n");
+            return 2;
+        }
+    }
+
+    GameConfig cfg;
+    GameState base;
+    makeState(base, cfg, rows);
+    std::mt19937 rng(seed);
+
+    std::printf("ball storm: %d bricks, %d steps of 240 Hz per run, detected SIMD %s\n",
+                base.bricks.aliveCount(), steps,
+                game::BrickField::detectedSimd() == SimdLevel::Scalar ? "scalar" : "sse2");
+
+    // Equivalência de um passo: campo vazio, bolas por toda a arena e rápidas (muitas batem
+    // nas paredes e no tecto neste passo; as da faixa do paddle vão pelo CCD nos dois lados).
+    int failures = 0;
+    {
+        GameState empty;
+        makeState(empty, cfg, 0);
+        std::uniform_real_distribution<float> ux(cfg.arenaMinX + cfg.ballRadius, cfg.arenaMaxX - cfg.ballRadius);
+        std::uniform_real_distribution<float> uz(cfg.arenaMinZ + cfg.ballRadius, empty.paddlePos.z - 2.0f);
+        std::uniform_real_distribution<float> ua(0.0f, 6.2831853f), us(10.0f, 400.0f);
+        std::vector<Ball> init(4000);
+        for (auto& b : init) {
+            float a = ua(rng);
+            b.pos = glm::vec3(ux(rng), 0.0f, uz(rng));
+            b.vel = glm::vec3(std::cos(a), 0.0f, std::sin(a)) * us(rng);
+        }
+        for (SimdLevel lv : { SimdLevel::Scalar, SimdLevel::SSE2 }) {
+            int velMismatch = 0;
+            float dev = oneStepDeviation(empty, init, cfg, lv, velMismatch);
+            std::printf("one step vs moveBall (%s): max |dpos| %.2e, velocity sign mismatches %d\n",
+                        lv == SimdLevel::Scalar ? "scalar" : "sse2", dev, velMismatch);
+            if (dev > 1e-4f || velMismatch) failures++;
+        }
+    }
+
+    std::printf("\n%8s | %14s | %14s | %14s | %9s\n", "balls", "AoS + moveBall", "SoA scalar", "SoA SSE2", "kernel %");
+    for (int n : { 100, 1000, 5000, 10000 }) {
+        auto init = makeBalls(cfg, base, n, rng);
+        double share = 0.0;
+        double aos = runAoS(base, init, cfg, steps);
+        double sc = runSoA(base, init, cfg, steps, SimdLevel::Scalar, nullptr);
+        double ss = runSoA(base, init, cfg, steps, SimdLevel::SSE2, &share);
+        std::printf("%8d | %11.1f us | %11.1f us | %11.1f us | %8.0f%%\n", n, aos, sc, ss, share * 100.0);
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "[ballstorm] kernel disagrees with moveBall\n");
+        return 1;
+    }
+    return 0;
+}
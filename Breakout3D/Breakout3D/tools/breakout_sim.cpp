@@ -0,0 +1,257 @@
+// breakout_sim.cpp
+// -----------------------------------------------------------------------------
+// breakout_sim.cpp
+//
+// Responsabilidade:
+//  - Corre jogos completos sem janela, contexto GL nem áudio, à velocidade máxima do CPU,
+//    sobre a libbreakout_sim.a (SimulationSystem + systems + GameState/GameConfig).
+//  - Um "autopilot" simples (tools/sim_bot.hpp) joga por nós: segue a bola que vem para o
+//    paddle, lança as bolas attached com um ângulo aleatório e, no Rogue, escolhe cartas ao acaso.
+//  - No fim mostra score/duração por jogo, a contagem de SimEvents, o throughput (passos/s)
+//    e um checksum do estado final de todos os jogos.
+//
+// Uso:
+//  breakout_sim [--mode normal|endless|rogue|levels] [--level N] [--games N] [--seconds S]
+//               [--seed N] [--threads N] [--record FILE] [--quiet]
+//    --games    nº de jogos (default 10); o jogo g usa o seed `seed + g`
+//    --seconds  limite de tempo simulado por jogo (default 600)
+//    --level    nível inicial no modo levels (default 1)
+//    --threads  jogos em paralelo (default 1)
+//    --record   grava o replay (.b3dr) do 1º jogo em FILE (ver tools/b3dreplay.cpp)
+//
+// Notas:
+//  - Passo fixo de 1/240 s, igual ao jogo. Sem finisher: no Normal/Levels o jogo acaba
+//    no passo em que o campo fica vazio (SimEventType::FieldCleared).
+//  - Toda a aleatoriedade (jogo e bot) vem do seed do jogo: o checksum tem de ser igual para
+//    qualquer --threads. Se não for, há estado partilhado entre simulações.
+//  - Os bests (Endless/Rogue) são lidos no initGame mas nunca gravados: os eventos
+//    EndlessBest/RogueBest só são contados.
+// -----------------------------------------------------------------------------
+
+#include "game/systems/SimulationSystem.hpp"
+#include "game/systems/InitSystem.hpp"
+#include "game/rogue/RogueCards.hpp"
+#include "game/Replay.hpp"
+#include "sim_bot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using game::GameConfig;
+using game::GameMode;
+using game::GameState;
+using game::GameType;
+using game::SimEventType;
+using game::SimulationSystem;
+using clock_type = std::chrono::steady_clock;
+
+using simbot::kStep;
+
+const char* kEventNames[] = {
+    "wall_hit", "paddle_hit", "brick_hit", "brick_crack", "brick_break", "fireball_break",
+    "powerup_dropped", "powerup_picked", "life_lost", "run_complete", "field_cleared",
+    "endless_best", "rogue_best",
+};
+static_assert(sizeof(kEventNames) / sizeof(kEventNames[0]) == (std::size_t)SimEventType::Count,
+              "kEventNames desalinhado com SimEventType");
+
+struct GameResult {
+    const char* end = "timeout";
+    int score = 0, lives = 0, wave = 0;
+    long long steps = 0;
+    long long events[(int)SimEventType::Count] = {};
+    std::uint64_t hash = 0;
+};
+
+// FNV-1a sobre o estado final (score, vidas, bricks, bolas, paddle): bit a bit, sem tolerâncias.
+struct Fnv {
+    std::uint64_t h = 1469598103934665603ULL;
+    void bytes(const void* p, std::size_t n) {
+        const unsigned char* b = (const unsigned char*)p;
+        for (std::size_t i = 0; i < n; ++i) { h ^= b[i]; h *= 1099511628211ULL; }
+    }
+    template <class T> void add(const T& v) { bytes(&v, sizeof(v)); }
+};
+
+const char* modeName(GameType t) {
+    switch (t) {
+    case GameType::NORMAL: return "normal";
+    case GameType::ENDLESS: return "endless";
+    case GameType::ROGUE: return "rogue";
+    case GameType::LEVELS: return "levels";
+    }
+    return "?";
+}
+
+GameResult runGame(const GameConfig& cfg, GameType type, int level, std::uint64_t seed, long long maxSteps,
+                   std::vector<std::uint8_t>* replay = nullptr) {
+    GameResult res;
+    GameState s;
+    s.gameType = type;
+    s.wave = 1;
+    s.currentLevel = level;
+    game::InitSystem::initGame(s, cfg, seed);
+    game::ReplayRecorder recorder;
+    game::ReplayRecorder* rec = replay ? &recorder : nullptr;
+    if (rec) rec->begin(s, cfg);
+
+    simbot::Bot bot(seed);
+    game::SimEvents events;
+    events.reserve(64);
+
+    long long steps = 0;
+    for (; steps < maxSteps; ++steps) {
+        // Rogue: draft (início e entre waves) -> carta ao acaso
+        if (s.mode == GameMode::ROGUE_CARDS) {
+            if (s.rogueOfferCount <= 0) { res.end = "no cards"; break; }
+            int slot = (int)(bot.rng() % (unsigned)s.rogueOfferCount);
+            if (rec) rec->pick(slot, s.rogueOffer[slot]);
+            game::rogue::applyPickedCard(s, cfg, s.rogueOffer[slot]);
+            if (s.mode == GameMode::PLAYING) s.rogueRowSpawnTimer = 0.15f;
+            continue;
+        }
+        if (s.mode != GameMode::PLAYING) break;
+
+        if (bot.drive(s, cfg) > 0 && rec) rec->launch(s.launchInputDir);
+
+        events.clear();
+        if (rec) rec->beforeStep(s);
+        auto r = SimulationSystem::step(s, cfg, kStep, events);
+        if (rec) rec->afterStep(s);
+        for (const auto& e : events) {
+            res.events[(int)e.type]++;
+            bot.observe(e);
+        }
+        if (r == SimulationSystem::StepResult::FieldCleared) { ++steps; res.end = "cleared"; break; }
+    }
+    if (s.mode == GameMode::WIN) res.end = "win";
+    else if (s.mode == GameMode::GAME_OVER) res.end = "game over";
+
+    if (rec) *replay = rec->finish(s.mode);
+
+    res.score = s.score + s.endlessStreakPoints;
+    res.lives = s.lives;
+    res.wave = s.wave;
+    res.steps = steps;
+
+    Fnv f;
+    f.add(res.score); f.add(res.lives); f.add(res.wave); f.add(steps);
+    f.add(s.bricks.aliveCount()); f.add(s.endlessRowsSpawned);
+    f.add(s.paddlePos.x); f.add(s.paddlePos.z);
+    for (int i = 0; i < s.balls.size(); ++i) { f.add(s.balls.pos(i).x); f.add(s.balls.pos(i).z); }
+    res.hash = f.h;
+    return res;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GameType type = GameType::ENDLESS;
+    int games = 10, level = 1, threads = 1;
+    float maxSeconds = 600.0f;
+    std::uint64_t seed = 1234u;
+    bool quiet = false;
+    const char* recordPath = nullptr;
+    std::vector<std::uint8_t> replay;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--mode") && i + 1 < argc) {
+            std::string m = argv[++i];
+            if (m == "normal") type = GameType::NORMAL;
+            else if (m == "endless") type = GameType::ENDLESS;
+            else if (m == "rogue") type = GameType::ROGUE;
+            else if (m == "levels") type = GameType::LEVELS;
+            else { std::fprintf(stderr, "unknown mode '%s'\n", m.c_str()); return 2; }
+        }
+        else if (!std::strcmp(argv[i], "--level") && i + 1 < argc) level = std::max(1, std::min(20, std::atoi(argv[++i])));
+        else if (!std::strcmp(argv[i], "--games") && i + 1 < argc) games = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) maxSeconds = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--quiet")) quiet = true;
+        else {
+            std::fprintf(stderr, "usage: breakout_sim [--mode normal|endless|rogue|levels] [--level N] [--games N] "
+                                 "[--seconds S] [--seed N] [--threads N] [--record FILE] [--quiet]\n");
+            return 2;
+        }
+    }
+
+    const GameConfig cfg;
+    const long long maxSteps = (long long)std::ceil(maxSeconds / kStep);
+    threads = std::min(threads, games);
+
+    std::printf("breakout_sim: %d %s game(s), up to %.0f s each, seed %llu, %d thread(s)\n",
+                games, modeName(type), maxSeconds, (unsigned long long)seed, threads);
+
+    // Cada thread tira o próximo jogo de um contador; o resultado vai para o slot do jogo.
+    std::vector<GameResult> results((std::size_t)games);
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int g; (g = next.fetch_add(1)) < games; ) {
+            results[(std::size_t)g] = runGame(cfg, type, level, seed + (std::uint64_t)g, maxSteps,
+                                              (g == 0 && recordPath) ? &replay : nullptr);
+        }
+    };
+
+    auto t0 = clock_type::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    const double wall = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    if (recordPath) {
+        std::FILE* f = std::fopen(recordPath, "wb");
+        if (!f || std::fwrite(replay.data(), 1, replay.size(), f) != replay.size()) {
+            std::fprintf(stderr, "cannot write '%s'\n", recordPath);
+            if (f) std::fclose(f);
+            return 1;
+        }
+        std::fclose(f);
+        std::printf("recorded game 1: %s (%zu bytes)\n", recordPath, replay.size());
+    }
+
+    int wins = 0, losses = 0, timeouts = 0;
+    long long scoreSum = 0, totalSteps = 0;
+    long long events[(int)SimEventType::Count] = {};
+    Fnv all;
+    for (int g = 0; g < games; ++g) {
+        const GameResult& r = results[(std::size_t)g];
+        bool won = !std::strcmp(r.end, "win") || !std::strcmp(r.end, "cleared");
+        if (won) wins++;
+        else if (!std::strcmp(r.end, "timeout")) timeouts++;
+        else losses++;
+
+        totalSteps += r.steps;
+        scoreSum += r.score;
+        for (int i = 0; i < (int)SimEventType::Count; ++i) events[i] += r.events[i];
+        all.add(r.hash);
+        if (!quiet) {
+            std::printf("game %3d: %-9s score %6d  lives %d  wave %2d  %7.1f s simulated\n",
+                        g + 1, r.end, r.score, r.lives, r.wave, (double)r.steps * kStep);
+        }
+    }
+    const double simSeconds = (double)totalSteps * kStep;
+
+    std::printf("\nresults: %d won, %d lost, %d timed out, mean score %.1f\n",
+                wins, losses, timeouts, (double)scoreSum / games);
+    std::printf("events:");
+    for (int i = 0; i < (int)SimEventType::Count; ++i) {
+        if (events[i]) std::printf(" %s=%lld", kEventNames[i], events[i]);
+    }
+    std::printf("\nchecksum: %016llx\n", (unsigned long long)all.h);
+    std::printf("throughput: %lld steps (%.0f s simulated) in %.3f s wall = %.0f steps/s, %.0fx real time\n",
+                totalSteps, simSeconds, wall, wall > 0.0 ? totalSteps / wall : 0.0, wall > 0.0 ? simSeconds / wall : 0.0);
+    return 0;
+}
@@ -0,0 +1,504 @@
+// brickbench.cpp
+// -----------------------------------------------------------------------------
+// brickbench.cpp
+//
+// Responsabilidade:
+//  - Medir as colisões bola-brick: scan linear de um vector<Brick> AoS (o que o
+//    CollisionSystem fazia), scan linear dos arrays SoA do BrickField (escalar/SSE2/AVX2, kernels
+//    só deste bench) e BrickGrid + BrickField::sweptCandidates (o caminho do moveBall), sem o
+//    filtro, com o filtro escalar e com o filtro SIMD.
+//  - Cenários com 1, 10, 100 e 1000 bolas num campo Endless, com e sem o "histórico" de
+//    bricks mortos que o vector AoS acumulava numa run longa (no BrickField os vivos
+//    reciclam parte desses slots, mas o scan continua a percorrer todos).
+//  - CCD do moveBall (teste swept exacto do CollisionSystem) por tamanho do campo: todos os
+//    bricks vivos, todos com o filtro, candidatos da grelha e grelha + filtro (o caminho do jogo).
+//  - AoE da fireball: scan AoS vs BrickField::queryCircle (scan SoA em lote, escalar e SIMD), do
+//    raio base até aos raios Rogue.
+//
+// Uso:
+//  brickbench [--rows N] [--dead N] [--steps N]
+//    --rows   rows vivas de 12 bricks (default 16)
+//    --dead   bricks mortos extra no vector (default: corre 0 e 2000)
+//    --steps  passos de 240 Hz por nº de bolas = steps/bolas (default 240000)
+//
+// Notas:
+//  - As bolas só se movem e fazem bounce nas paredes (sem resposta aos bricks), para todas as
+//    versões verem exactamente as mesmas posições; o nº de hits tem de coincidir.
+//  - Os caminhos da grelha acabam no teste estático da bola na posição final (como os scans),
+//    não no swept exacto do CollisionSystem: o que se mede aqui é a grelha + o filtro.
+//  - Níveis SIMD que o CPU não suporta caem para o seguinte (ver BrickField::detectedSimd).
+//  - Mede também o custo de manutenção: push de uma row (rotação do ring) vs rebuild.
+// -----------------------------------------------------------------------------
+
+#include "game/BrickField.hpp"
+#include "game/systems/CollisionSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__SSE2__)
+#define B3D_BENCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define B3D_BENCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using game::Brick;
+using game::BrickField;
+using game::SimdLevel;
+using game::BrickGrid;
+using clock_type = std::chrono::steady_clock;
+
+// Arena e campo iguais ao GameConfig/InitSystem (Endless).
+constexpr float kArenaMinX = -18.0f, kArenaMaxX = 18.0f;
+constexpr float kArenaMinZ = -12.0f, kArenaMaxZ = 12.0f;
+constexpr float kBallRadius = 0.42f;
+constexpr float kBallSpeed = 10.5f;
+constexpr float kStep = 1.0f / 240.0f;
+constexpr int kCols = 12;
+const glm::vec3 kBrickSize(2.95f, 0.7f, 1.30f);
+constexpr float kGapX = 0.04f, kGapZ = 0.03f;
+
+struct BenchBall {
+    glm::vec3 prev;
+    glm::vec3 pos;
+    glm::vec3 vel;
+};
+
+// Mesma fórmula de CollisionSystem.cpp.
+bool sphereAabbXZ(const glm::vec3& c, float r, const glm::vec3& bpos, const glm::vec3& bsize) {
+    float hx = bsize.x * 0.5f, hz = bsize.z * 0.5f;
+    float cx = std::max(bpos.x - hx, std::min(c.x, bpos.x + hx));
+    float cz = std::max(bpos.z - hz, std::min(c.z, bpos.z + hz));
+    float dx = c.x - cx, dz = c.z - cz;
+    return (dx * dx + dz * dz) <= (r * r);
+}
+
+// ---------------------------------------------------------------------------
+// Scan de todos os slots (sem grelha): primeiro brick vivo que intersecta a esfera em XZ.
+// Saltam blocos de 64 mortos pelo bitset; o bit alive faz de máscara de lanes.
+// ---------------------------------------------------------------------------
+using Hot = BrickField::HotArrays;
+
+int scanScalar(const Hot& h, float cx, float cz, float r) {
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        while (bits) {
+            int i = w * 64 + __builtin_ctzll(bits);
+            if (BrickField::sphereAabbXZ(cx, cz, r, h.minX[i], h.maxX[i], h.minZ[i], h.maxZ[i])) return i;
+            bits &= bits - 1;
+        }
+    }
+    return -1;
+}
+
+#if B3D_BENCH_SSE2
+int scanSse2(const Hot& h, float cx, float cz, float r) {
+    const __m128 vcx = _mm_set1_ps(cx), vcz = _mm_set1_ps(cz), vr2 = _mm_set1_ps(r * r);
+    const __m128 zero = _mm_setzero_ps();
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        for (int k = 0; bits != 0; ++k, bits >>= 4) {
+            int live = (int)(bits & 0xFu);
+            if (!live) continue;
+            int i = w * 64 + k * 4;
+            __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(h.minX + i), vcx),
+                                              _mm_sub_ps(vcx, _mm_loadu_ps(h.maxX + i))), zero);
+            __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(h.minZ + i), vcz),
+                                              _mm_sub_ps(vcz, _mm_loadu_ps(h.maxZ + i))), zero);
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+            int m = _mm_movemask_ps(_mm_cmple_ps(d2, vr2)) & live;
+            if (m) return i + __builtin_ctz((unsigned)m);
+        }
+    }
+    return -1;
+}
+#endif
+
+#if B3D_BENCH_AVX2
+__attribute__((target("avx2")))
+int scanAvx2(const Hot& h, float cx, float cz, float r) {
+    const __m256 vcx = _mm256_set1_ps(cx), vcz = _mm256_set1_ps(cz), vr2 = _mm256_set1_ps(r * r);
+    const __m256 zero = _mm256_setzero_ps();
+    for (int w = 0; w < h.words; ++w) {
+        std::uint64_t bits = h.alive[w];
+        for (int k = 0; bits != 0; ++k, bits >>= 8) {
+            int live = (int)(bits & 0xFFu);
+            if (!live) continue;
+            int i = w * 64 + k * 8;
+            __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(h.minX + i), vcx),
+                                                    _mm256_sub_ps(vcx, _mm256_loadu_ps(h.maxX + i))), zero);
+            __m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(h.minZ + i), vcz),
+                                                    _mm256_sub_ps(vcz, _mm256_loadu_ps(h.maxZ + i))), zero);
+            __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz));
+            int m = _mm256_movemask_ps(_mm256_cmp_ps(d2, vr2, _CMP_LE_OQ)) & live;
+            if (m) return i + __builtin_ctz((unsigned)m);
+        }
+    }
+    return -1;
+}
+#endif
+
+// Níveis acima do que o CPU suporta caem para o detectado.
+int scanField(const BrickField& field, float cx, float cz, float r, SimdLevel level) {
+    if ((int)level > (int)BrickField::detectedSimd()) level = BrickField::detectedSimd();
+    const Hot h = field.hot();
+    cz -= field.scrollZ(); // query para Z local
+    switch (level) {
+#if B3D_BENCH_AVX2
+        case SimdLevel::AVX2: return scanAvx2(h, cx, cz, r);
+#endif
+#if B3D_BENCH_SSE2
+        case SimdLevel::SSE2: return scanSse2(h, cx, cz, r);
+#endif
+        default: return scanScalar(h, cx, cz, r);
+    }
+}
+
+std::vector<Brick> makeField(int rows, int dead, std::mt19937& rng) {
+    std::vector<Brick> bricks;
+
+    // Histórico de uma run longa: bricks mortos ficam no vector (o scan linear salta-os).
+    std::uniform_real_distribution<float> ux(kArenaMinX, kArenaMaxX), uz(kArenaMinZ, kArenaMaxZ);
+    for (int i = 0; i < dead; ++i) {
+        Brick b;
+        b.size = kBrickSize;
+        b.pos = glm::vec3(ux(rng), 0.0f, uz(rng));
+        b.alive = false;
+        bricks.push_back(b);
+    }
+
+    float totalW = kCols * kBrickSize.x + (kCols - 1) * kGapX;
+    float leftX = -totalW * 0.5f + kBrickSize.x * 0.5f;
+    float startZ = kArenaMinZ + 0.85f;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < kCols; ++c) {
+            Brick b;
+            b.size = kBrickSize;
+            b.pos = glm::vec3(leftX + c * (kBrickSize.x + kGapX), 0.0f, startZ + r * (kBrickSize.z + kGapZ));
+            b.alive = true;
+            bricks.push_back(b);
+        }
+    }
+    return bricks;
+}
+
+std::vector<BenchBall> makeBalls(int n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> ux(kArenaMinX + 1.0f, kArenaMaxX - 1.0f);
+    std::uniform_real_distribution<float> uz(kArenaMinZ + 1.0f, kArenaMaxZ - 1.0f);
+    std::uniform_real_distribution<float> ua(0.0f, 6.2831853f);
+    std::vector<BenchBall> balls((std::size_t)n);
+    for (auto& b : balls) {
+        float a = ua(rng);
+        b.pos = glm::vec3(ux(rng), 0.0f, uz(rng));
+        b.prev = b.pos;
+        b.vel = glm::vec3(std::cos(a) * kBallSpeed, 0.0f, std::sin(a) * kBallSpeed);
+    }
+    return balls;
+}
+
+void stepBalls(std::vector<BenchBall>& balls) {
+    for (auto& b : balls) {
+        b.prev = b.pos;
+        b.pos += b.vel * kStep;
+        if (b.pos.x < kArenaMinX + kBallRadius || b.pos.x > kArenaMaxX - kBallRadius) b.vel.x = -b.vel.x;
+        if (b.pos.z < kArenaMinZ + kBallRadius || b.pos.z > kArenaMaxZ - kBallRadius) b.vel.z = -b.vel.z;
+    }
+}
+
+struct RunResult {
+    double nsPerStep = 0.0;
+    std::uint64_t hits = 0;
+};
+
+template <class Fn>
+RunResult runSteps(std::vector<BenchBall> balls, int steps, Fn&& testBall) {
+    RunResult res;
+    double ns = 0.0;
+    for (int s = 0; s < steps; ++s) {
+        stepBalls(balls);
+        auto t0 = clock_type::now();
+        for (const auto& b : balls) res.hits += testBall(b);
+        ns += std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+    }
+    res.nsPerStep = ns / (double)steps;
+    return res;
+}
+
+void fillField(BrickField& field, const std::vector<Brick>& bricks) {
+    field.configureGrid(kArenaMinX, kArenaMaxX, kArenaMinZ, kArenaMaxZ,
+                        kBrickSize.x + kGapX, kBrickSize.z + kGapZ);
+    for (const auto& b : bricks) field.add(b);
+}
+
+const char* simdName(SimdLevel l) {
+    switch (l) {
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::Scalar: return "scalar";
+        default: return "auto";
+    }
+}
+
+bool runScenario(int rows, int dead, int stepBudget) {
+    std::mt19937 rng(1234u);
+    std::vector<Brick> bricks = makeField(rows, dead, rng);
+
+    BrickField field;
+    fillField(field, bricks);
+    const BrickGrid& grid = field.grid();
+
+    std::printf("\nfield: %d alive + %d dead bricks, grid %dx%d (%d entries), simd auto=%s\n",
+                rows * kCols, dead, grid.cols(), grid.rows(), grid.entryCount(),
+                simdName(BrickField::detectedSimd()));
+    std::printf("%6s %10s %10s %10s %10s %10s %12s %12s %9s %9s\n", "balls", "AoS lin", "SoA scal", "SoA sse2",
+                "SoA avx2", "grid", "grid+scal", "grid+auto", "vs AoS", "hits");
+    std::printf("%6s %10s %10s %10s %10s %10s %12s %12s\n", "", "ns/step", "ns/step", "ns/step", "ns/step",
+                "ns/step", "ns/step", "ns/step");
+
+    bool ok = true;
+    const int counts[] = {1, 10, 100, 1000};
+    for (int n : counts) {
+        int steps = std::max(240, stepBudget / n);
+        std::vector<BenchBall> balls = makeBalls(n, rng);
+
+        RunResult aos = runSteps(balls, steps, [&](const BenchBall& b) -> int {
+            for (const auto& br : bricks) {
+                if (!br.alive) continue;
+                if (sphereAabbXZ(b.pos, kBallRadius, br.pos, br.size)) return 1; // primeiro hit
+            }
+            return 0;
+        });
+
+        auto scan = [&](SimdLevel level) {
+            return runSteps(balls, steps, [&, level](const BenchBall& b) -> int {
+                return scanField(field, b.pos.x, b.pos.z, kBallRadius, level) >= 0 ? 1 : 0;
+            });
+        };
+        RunResult scal = scan(SimdLevel::Scalar);
+        RunResult sse = scan(SimdLevel::SSE2);
+        RunResult avx = scan(SimdLevel::AVX2);
+
+        // Caminho do moveBall: candidatos da grelha ao longo do passo, filtro swept, teste final.
+        std::vector<int> candidates;
+        auto firstHit = [&](const BenchBall& b) -> int {
+            for (int i : candidates) {
+                if (!field.alive(i)) continue;
+                if (BrickField::sphereAabbXZ(b.pos.x, b.pos.z, kBallRadius, field.minX(i), field.maxX(i),
+                                             field.minZ(i), field.maxZ(i)))
+                    return 1;
+            }
+            return 0;
+        };
+        RunResult grd = runSteps(balls, steps, [&](const BenchBall& b) -> int {
+            field.querySwept(b.prev, b.pos, kBallRadius, candidates);
+            return firstHit(b);
+        });
+        auto gridRun = [&](SimdLevel level) {
+            return runSteps(balls, steps, [&, level](const BenchBall& b) -> int {
+                field.querySwept(b.prev, b.pos, kBallRadius, candidates);
+                field.sweptCandidates(b.prev, b.pos - b.prev, kBallRadius, candidates, level);
+                return firstHit(b);
+            });
+        };
+        RunResult grdScal = gridRun(SimdLevel::Scalar);
+        RunResult grdSimd = gridRun(SimdLevel::Auto);
+
+        bool same = aos.hits == scal.hits && aos.hits == sse.hits && aos.hits == avx.hits &&
+                    aos.hits == grd.hits && aos.hits == grdScal.hits && aos.hits == grdSimd.hits;
+        ok = ok && same;
+        std::printf("%6d %10.0f %10.0f %10.0f %10.0f %10.0f %12.0f %12.0f %8.1fx %9llu%s\n", n, aos.nsPerStep,
+                    scal.nsPerStep, sse.nsPerStep, avx.nsPerStep, grd.nsPerStep, grdScal.nsPerStep,
+                    grdSimd.nsPerStep, grdSimd.nsPerStep > 0.0 ? aos.nsPerStep / grdSimd.nsPerStep : 0.0,
+                    (unsigned long long)aos.hits, same ? "" : "  MISMATCH");
+    }
+
+    // AoE da fireball: todos os bricks com o centro dentro do raio (raio base e com cartas Rogue).
+    {
+        const float mults[] = {0.5f, 1.0f, 1.55f, 1.55f * 1.35f, 1.55f * 1.55f * 1.35f, 1.55f * 1.55f * 1.35f * 1.35f};
+        const int queries = 20000;
+        std::uniform_real_distribution<float> ux(kArenaMinX, kArenaMaxX);
+        std::uniform_real_distribution<float> uz(kArenaMinZ, kArenaMinZ + rows * (kBrickSize.z + kGapZ));
+        std::vector<int> candidates;
+
+        std::printf("%-16s %10s %10s %10s %9s %12s\n", "fireball AoE", "AoS lin", "SoA scal", "SoA auto",
+                    "vs AoS", "bricks/blast");
+        for (float m : mults) {
+            float r = 4.2f * m, r2 = r * r;
+            std::vector<glm::vec3> centers;
+            for (int i = 0; i < queries; ++i) centers.push_back(glm::vec3(ux(rng), 0.0f, uz(rng)));
+
+            // melhor de 5 (os hits contam só na primeira)
+            auto timeQueries = [&](auto&& query, std::uint64_t& hits) {
+                double best = 0.0;
+                for (int rep = 0; rep < 5; ++rep) {
+                    std::uint64_t n = 0;
+                    auto t0 = clock_type::now();
+                    for (const auto& c : centers) n += query(c);
+                    double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count() / queries;
+                    if (rep == 0) hits = n;
+                    if (rep == 0 || ns < best) best = ns;
+                }
+                return best;
+            };
+
+            std::uint64_t linHits = 0, scalHits = 0, autoHits = 0;
+            // todos produzem a lista de índices dos atingidos (o que o jogo percorre a seguir)
+            double linNs = timeQueries([&](const glm::vec3& c) {
+                candidates.clear();
+                for (std::size_t i = 0; i < bricks.size(); ++i) {
+                    const Brick& br = bricks[i];
+                    if (!br.alive) continue;
+                    float dx = br.pos.x - c.x, dz = br.pos.z - c.z;
+                    if (dx * dx + dz * dz <= r2) candidates.push_back((int)i);
+                }
+                return (int)candidates.size();
+            }, linHits);
+            double scalNs = timeQueries([&](const glm::vec3& c) {
+                field.queryCircle(c.x, c.z, r, candidates, SimdLevel::Scalar);
+                return (int)candidates.size();
+            }, scalHits);
+            double autoNs = timeQueries([&](const glm::vec3& c) {
+                field.queryCircle(c.x, c.z, r, candidates);
+                return (int)candidates.size();
+            }, autoHits);
+
+            bool same = linHits == scalHits && linHits == autoHits;
+            ok = ok && same;
+            char label[32];
+            std::snprintf(label, sizeof(label), "r=%.1f", r);
+            std::printf("%-16s %10.0f %10.0f %10.0f %8.2fx %12.1f%s\n", label, linNs, scalNs, autoNs,
+                        autoNs > 0.0 ? linNs / autoNs : 0.0, (double)autoHits / queries, same ? "" : "  MISMATCH");
+        }
+    }
+
+    // Manutenção: push de 1 row (como spawnIncrementalBricks) com rotação do ring vs rebuild.
+    {
+        const int reps = 2000;
+        float stepZ = kBrickSize.z + kGapZ;
+        BrickField work;
+        fillField(work, makeField(std::min(rows, grid.rows() - 3), dead, rng));
+
+        double ringNs = 0.0, rebuildNs = 0.0;
+        for (int i = 0; i < reps; ++i) {
+            // vai e volta para o campo ficar dentro da arena; o ring só roda para a frente
+            // (push em direcção ao paddle), o regresso faz rebuild da grelha
+            float dz = (i & 1) ? -stepZ : stepZ;
+            auto t0 = clock_type::now();
+            work.shiftZ(dz);
+            double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+            if (dz > 0.0f) ringNs += ns; else rebuildNs += ns;
+        }
+        std::printf("row push: ring %.0f ns, rebuild %.0f ns\n", ringNs / (reps / 2), rebuildNs / (reps / 2));
+    }
+
+    return ok;
+}
+
+// CCD do moveBall por nº de bricks: 100 bolas, o passo de cada bola é o segmento prev -> pos.
+bool runSweptScaling(int maxRows, int stepBudget) {
+    std::mt19937 rng(4321u);
+    const int n = 100, steps = std::max(240, stepBudget / n);
+    std::vector<BenchBall> balls = makeBalls(n, rng);
+
+    std::printf("\nswept CCD (moveBall brick loop), %d balls, simd auto=%s\n", n,
+                simdName(BrickField::detectedSimd()));
+    std::printf("%6s %12s %12s %12s %12s %10s\n", "bricks", "exact all", "filter all", "grid", "grid+filter",
+                "survivors");
+    std::printf("%6s %12s %12s %12s %12s %10s\n", "", "ns/ball", "ns/ball", "ns/ball", "ns/ball", "per ball");
+
+    bool ok = true;
+    std::vector<int> all, candidates;
+    for (int rows = 1;; rows = std::min(rows * 2, maxRows)) {
+        BrickField field;
+        fillField(field, makeField(rows, 0, rng));
+        all.clear();
+        field.forEachAlive([&](int i) { all.push_back(i); });
+
+        std::uint64_t survivors = 0;
+        auto exact = [&](const BenchBall& b) -> int {
+            int hits = 0;
+            for (int i : candidates) {
+                if (!field.alive(i)) continue;
+                float t;
+                glm::vec2 nrm;
+                hits += game::CollisionSystem::sweepSphereAabbXZ(b.prev, b.pos - b.prev, kBallRadius, field.minX(i),
+                                                                 field.maxX(i), field.minZ(i), field.maxZ(i), t, nrm);
+            }
+            return hits;
+        };
+        RunResult exAll = runSteps(balls, steps, [&](const BenchBall& b) {
+            candidates = all;
+            return exact(b);
+        });
+        RunResult fltAll = runSteps(balls, steps, [&](const BenchBall& b) {
+            candidates = all;
+            field.sweptCandidates(b.prev, b.pos - b.prev, kBallRadius, candidates);
+            return exact(b);
+        });
+        RunResult grd = runSteps(balls, steps, [&](const BenchBall& b) {
+            field.querySwept(b.prev, b.pos, kBallRadius, candidates);
+            return exact(b);
+        });
+        RunResult grdFlt = runSteps(balls, steps, [&](const BenchBall& b) {
+            field.querySwept(b.prev, b.pos, kBallRadius, candidates);
+            field.sweptCandidates(b.prev, b.pos - b.prev, kBallRadius, candidates);
+            survivors += candidates.size();
+            return exact(b);
+        });
+
+        bool same = exAll.hits == fltAll.hits && exAll.hits == grd.hits && exAll.hits == grdFlt.hits;
+        ok = ok && same;
+        std::printf("%6d %12.1f %12.1f %12.1f %12.1f %10.2f%s\n", rows * kCols, exAll.nsPerStep / n,
+                    fltAll.nsPerStep / n, grd.nsPerStep / n, grdFlt.nsPerStep / n,
+                    (double)survivors / ((double)steps * n), same ? "" : "  MISMATCH");
+        if (rows == maxRows) break;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rows = 16;
+    int dead = -1;
+    int steps = 240000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--rows") && i + 1 < argc) rows = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--dead") && i + 1 < argc) dead = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--steps") && i + 1 < argc) steps = std::max(240, std::atoi(argv[++i]));
+        else {
+            std::fprintf(stderr, "usage: brickbench [--rows N] [--dead N] [--steps N]\n");
+            return 2;
+        }
+    }
+
+    bool ok = true;
+    if (dead >= 0) {
+        ok = runScenario(rows, dead, steps);
+    } else {
+        ok = runScenario(rows, 0, steps) && ok;
+        ok = runScenario(rows, 2000, steps) && ok;
+    }
+
+    ok = runSweptScaling(rows, steps) && ok;
+
+    if (!ok) {
+        std::fprintf(stderr, "[brickbench] hit counts disagree between paths\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,332 @@
+// bricksoak.cpp
+// -----------------------------------------------------------------------------
+// bricksoak.cpp
+//
+// Responsabilidade:
+//  - Soak de uma run Endless longa (default 1 hora simulada a 240 Hz) sobre o BrickField:
+//    spawn incremental (quota de kills + pressão por tempo, como GameUpdatePlaying), push
+//    das rows, bolas a partir bricks, scan da danger line e passagem de render.
+//  - Por minuto simulado: bricks vivos, slots, total spawnado (o que o vector antigo teria),
+//    bytes do campo+grelha e custo médio/máximo por frame.
+//  - Verifica os handles: um handle de um brick morto nunca resolve, mesmo depois de o slot
+//    ser reciclado; um handle de um brick vivo resolve sempre para o mesmo slot.
+//  - Verifica as FieldStats (vivos, histograma/soma de HP, Z mais fundo) contra um scan
+//    completo, uma vez por segundo simulado.
+//
+// Uso:
+//  bricksoak [--minutes N] [--balls N] [--seed N]
+//
+// Notas:
+//  - Não é o jogo inteiro (sem paddle/powerups): é a carga que o campo de bricks vê.
+//  - Bricks que passam a danger line morrem em vez de dar game over, para a run não acabar.
+//  - Falha (exit 1) se os slots passarem o pico de bricks vivos (= a reciclagem falhou), se a
+//    memória crescer mais de 25% depois de o campo assentar (minuto 15, ou o 1º quarto
+//    em runs mais longas), se um handle resolver para o
+//    brick errado, ou se as stats incrementais divergirem do scan. O custo por frame segue os bricks vivos, não o tempo de run.
+// -----------------------------------------------------------------------------
+
+#include "game/BrickField.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using game::Brick;
+using game::BrickField;
+using game::BrickHandle;
+using clock_type = std::chrono::steady_clock;
+
+// Arena e campo iguais ao GameConfig/InitSystem (Endless).
+constexpr float kArenaMinX = -18.0f, kArenaMaxX = 18.0f;
+constexpr float kArenaMinZ = -12.0f, kArenaMaxZ = 12.0f;
+constexpr float kBallRadius = 0.42f;
+constexpr float kBallSpeed = 10.5f;
+constexpr float kStep = 1.0f / 240.0f;
+constexpr int kStepsPerMinute = 240 * 60;
+constexpr int kCols = 12;
+const glm::vec3 kBrickSize(2.95f, 0.7f, 1.30f);
+constexpr float kGapX = 0.04f, kGapZ = 0.03f;
+constexpr float kLimitZ = kArenaMaxZ - 1.5f; // ~paddlePos.z - 0.5
+
+struct SoakBall {
+    glm::vec3 prev;
+    glm::vec3 pos;
+    glm::vec3 vel;
+};
+
+struct Soak {
+    BrickField field;
+    std::vector<SoakBall> balls;
+    std::mt19937 rng;
+
+    float elapsed = 0.0f;
+    float autoTimer = 0.0f;
+    int destroyedThisWave = 0;
+    int pendingSpawn = 0;
+    std::uint64_t spawned = 0;
+    std::uint64_t killed = 0;
+    std::uint64_t lost = 0;
+    int peakAlive = 0;
+
+    // verificação de handles
+    BrickHandle deadHandle;       // brick já morto: nunca pode voltar a resolver
+    BrickHandle liveHandle;       // brick vivo seguido até morrer
+    int liveSlot = -1;
+    bool handlesOk = true;
+    std::uint64_t recycledDeadSlot = 0;
+};
+
+int pickHp(std::mt19937& rng) {
+    int r = (int)(rng() % 100u);
+    if (r < 30) return 1;
+    if (r < 55) return 2;
+    if (r < 80) return 3;
+    return 4;
+}
+
+void spawnBricks(Soak& s, int count) {
+    // Igual a InitSystem::spawnIncrementalBricks: empurra tudo e cria as rows novas no topo.
+    float totalW = kCols * kBrickSize.x + (kCols - 1) * kGapX;
+    float leftX = -totalW * 0.5f + kBrickSize.x * 0.5f;
+    float stepZ = kBrickSize.z + kGapZ;
+    float topZ = kArenaMinZ + 0.85f;
+
+    int rows = (count + kCols - 1) / kCols;
+    s.field.shiftZ(rows * stepZ);
+
+    for (int i = 0; i < count; ++i) {
+        Brick b;
+        b.size = kBrickSize;
+        b.alive = true;
+        b.pos = glm::vec3(leftX + (i % kCols) * (kBrickSize.x + kGapX), 0.0f, topZ + (i / kCols) * stepZ);
+        b.hp = b.maxHp = pickHp(s.rng);
+        int slot = s.field.add(b);
+        s.spawned++;
+        s.peakAlive = std::max(s.peakAlive, s.field.aliveCount());
+        if (s.deadHandle.index == slot) s.recycledDeadSlot++;
+    }
+}
+
+void killBrick(Soak& s, int bi) {
+    if (s.liveSlot == bi) {
+        s.liveSlot = -1;
+        s.deadHandle = s.liveHandle; // passa a ser o handle "morto" a vigiar
+    }
+    s.field.kill(bi);
+}
+
+// Recalcula as stats por força bruta e compara com as incrementais.
+bool statsMatch(const BrickField& f) {
+    const game::FieldStats& st = f.stats();
+    int alive = 0, total = 0;
+    int hist[game::FieldStats::kHpBuckets] = {};
+    float deepest = -1e30f;
+    f.forEachAlive([&](int i) {
+        alive++;
+        total += std::max(0, f.hp(i));
+        hist[std::min(std::max(f.hp(i), 0), game::FieldStats::kHpBuckets - 1)]++;
+        deepest = std::max(deepest, f.maxZ(i));
+    });
+    if (alive != st.alive() || total != st.totalHp()) return false;
+    for (int h = 0; h < game::FieldStats::kHpBuckets; ++h) {
+        if (hist[h] != st.hpCount(h)) return false;
+    }
+    return alive == 0 || std::abs(deepest - f.deepestMaxZ()) <= 1e-3f;
+}
+
+void trackHandles(Soak& s) {
+    if (s.field.valid(s.deadHandle)) s.handlesOk = false;
+
+    if (s.liveSlot >= 0) {
+        if (s.field.resolve(s.liveHandle) != s.liveSlot) s.handlesOk = false;
+    } else if (s.field.aliveCount() > 0) {
+        // escolhe um brick vivo qualquer para seguir
+        s.field.forEachAlive([&](int i) { if (s.liveSlot < 0) s.liveSlot = i; });
+        s.liveHandle = s.field.handle(s.liveSlot);
+    }
+}
+
+// Um passo de 240 Hz. Devolve ns gastos no trabalho por frame do campo.
+double step(Soak& s, std::vector<int>& candidates) {
+    // pressão por tempo (GameUpdatePlaying): intervalo 26 s -> 12 s após 1 min de grace
+    s.elapsed += kStep;
+    if (s.elapsed >= 60.0f) {
+        s.autoTimer += kStep;
+        float u = std::min(1.0f, (s.elapsed - 60.0f) / 540.0f);
+        float interval = std::max(12.0f, 26.0f - 14.0f * u);
+        if (s.pendingSpawn < kCols && s.autoTimer >= interval) {
+            s.pendingSpawn += kCols;
+            s.autoTimer = 0.0f;
+        }
+    }
+
+    auto t0 = clock_type::now();
+
+    if (s.pendingSpawn > 0) {
+        spawnBricks(s, s.pendingSpawn);
+        s.pendingSpawn = 0;
+    }
+
+    // colisões (grelha + filtro swept como o CollisionSystem::moveBall; teste estático no fim)
+    for (auto& b : s.balls) {
+        b.prev = b.pos;
+        b.pos += b.vel * kStep;
+        if (b.pos.x < kArenaMinX + kBallRadius || b.pos.x > kArenaMaxX - kBallRadius) b.vel.x = -b.vel.x;
+        if (b.pos.z < kArenaMinZ + kBallRadius || b.pos.z > kLimitZ) b.vel.z = -b.vel.z;
+
+        s.field.querySwept(b.prev, b.pos, kBallRadius, candidates);
+        s.field.sweptCandidates(b.prev, b.pos - b.prev, kBallRadius, candidates);
+        int bi = -1;
+        for (int i : candidates) {
+            if (BrickField::sphereAabbXZ(b.pos.x, b.pos.z, kBallRadius, s.field.minX(i), s.field.maxX(i),
+                                         s.field.minZ(i), s.field.maxZ(i))) {
+                bi = i;
+                break;
+            }
+        }
+        if (bi < 0) continue;
+
+        b.vel.z = -b.vel.z;
+        b.pos = b.prev;
+        int hp = s.field.hp(bi) - 1;
+        s.field.setHp(bi, hp);
+        if (hp <= 0) {
+            killBrick(s, bi);
+            s.killed++;
+
+            // quota de kills do Endless (22 -> 15 entre os 2 e os 10 min)
+            s.destroyedThisWave++;
+            float u = (s.elapsed <= 120.0f) ? 0.0f : std::min(1.0f, (s.elapsed - 120.0f) / 480.0f);
+            int required = std::max(15, std::min(22, (int)std::round(22.0f - 7.0f * u)));
+            if (s.destroyedThisWave >= required) {
+                s.pendingSpawn += kCols;
+                s.destroyedThisWave -= required;
+            }
+        }
+    }
+
+    // danger line (GameUpdatePlaying, O(1) pela row mais funda): aqui os bricks que a passam
+    // morrem em vez de acabar a run (só então se percorre o campo)
+    if (s.field.aliveCount() > 0 && s.field.deepestMaxZ() >= kLimitZ) {
+        for (int bi = 0; bi < s.field.size(); ++bi) {
+            if (!s.field.alive(bi)) continue;
+            if (s.field.maxZ(bi) >= kLimitZ) {
+                killBrick(s, bi);
+                s.lost++;
+            }
+        }
+    }
+
+    // passagem de render (WorldRender): lê centro/tamanho/hp de cada vivo
+    float sink = 0.0f;
+    s.field.forEachAlive([&](int i) { sink += s.field.center(i).x + (float)s.field.hp(i); });
+
+    double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+    if (sink == 12345.678f) std::printf(" ");
+    return ns;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int minutes = 60;
+    int ballCount = 3;
+    unsigned seed = 1234u;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--minutes") && i + 1 < argc) minutes = std::max(4, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--balls") && i + 1 < argc) ballCount = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: bricksoak [--minutes N] [--balls N] [--seed N]\n");
+            return 2;
+        }
+    }
+
+    Soak s;
+    s.rng.seed(seed);
+    s.field.configureGrid(kArenaMinX, kArenaMaxX, kArenaMinZ, kArenaMaxZ,
+                          kBrickSize.x + kGapX, kBrickSize.z + kGapZ);
+    spawnBricks(s, 8 * kCols); // campo inicial do Endless
+
+    std::uniform_real_distribution<float> ua(0.6f, 2.5f);
+    for (int i = 0; i < ballCount; ++i) {
+        float a = ua(s.rng);
+        SoakBall b;
+        b.pos = glm::vec3(-10.0f + 10.0f * (float)i / (float)ballCount, 0.0f, kLimitZ - 1.0f);
+        b.prev = b.pos;
+        b.vel = glm::vec3(std::cos(a) * kBallSpeed, 0.0f, -std::abs(std::sin(a)) * kBallSpeed);
+        s.balls.push_back(b);
+    }
+
+    std::printf("%6s %6s %6s %10s %10s %12s %12s\n", "min", "alive", "slots", "spawned", "bytes",
+                "avg ns/frame", "max ns/frame");
+
+    std::vector<int> candidates;
+    int settle = std::max(15, minutes / 4); // Endless só atinge o intervalo mínimo aos 10 min
+    std::size_t bytesAtSettle = 0;
+    bool grew = false;
+    bool leaked = false;
+    bool statsOk = true;
+    double firstAvg = 0.0, lastAvg = 0.0;
+
+    for (int m = 1; m <= minutes; ++m) {
+        double sum = 0.0, worst = 0.0;
+        for (int k = 0; k < kStepsPerMinute; ++k) {
+            double ns = step(s, candidates);
+            sum += ns;
+            worst = std::max(worst, ns);
+            if ((k & 255) == 0) trackHandles(s);
+            if (k % 240 == 0 && !statsMatch(s.field)) statsOk = false;
+        }
+        double avg = sum / kStepsPerMinute;
+        if (m == 1) firstAvg = avg;
+        lastAvg = avg;
+
+        // sem slots mortos "presos": só se cria um slot novo quando todos estão vivos
+        if (s.field.size() > s.peakAlive) leaked = true;
+
+        std::size_t bytes = s.field.memoryBytes();
+        if (m == settle) bytesAtSettle = bytes;
+        else if (m > settle && bytes * 4 > bytesAtSettle * 5) grew = true;
+
+        if (m <= 5 || m % 5 == 0 || m == minutes) {
+            std::printf("%6d %6d %6d %10llu %10zu %12.0f %12.0f\n", m, s.field.aliveCount(), s.field.size(),
+                        (unsigned long long)s.spawned, bytes, avg, worst);
+        }
+    }
+
+    std::printf("\nkilled %llu, lost at danger line %llu, dead-handle slot recycled %llu times\n",
+                (unsigned long long)s.killed, (unsigned long long)s.lost,
+                (unsigned long long)s.recycledDeadSlot);
+    std::printf("peak alive %d, slots %d (append-only would be %llu)\n", s.peakAlive, s.field.size(),
+                (unsigned long long)s.spawned);
+    std::printf("per-frame cost: minute 1 %.0f ns, minute %d %.0f ns\n", firstAvg, minutes, lastAvg);
+
+    bool ok = true;
+    if (leaked) {
+        std::fprintf(stderr, "[bricksoak] slots exceed peak alive bricks (dead slots not recycled)\n");
+        ok = false;
+    }
+    if (grew) {
+        std::fprintf(stderr, "[bricksoak] memory grew after minute %d\n", settle);
+        ok = false;
+    }
+    if (!statsOk) {
+        std::fprintf(stderr, "[bricksoak] FieldStats diverged from a full scan\n");
+        ok = false;
+    }
+    if (!s.handlesOk) {
+        std::fprintf(stderr, "[bricksoak] a stale handle resolved to a live brick\n");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+// ccdcheck.cpp
+// -----------------------------------------------------------------------------
+// ccdcheck.cpp
+//
+// Responsabilidade:
+//  - Regressão de túneis da bola: corre o CollisionSystem::moveBall real (CCD) em cenários
+//    com velocidades e dt muito acima do jogo normal e falha se a bola atravessar um brick,
+//    o paddle ou uma parede.
+//  - Para referência, mede quantas vezes a integração discreta antiga (pos += vel*dt e teste
+//    de sobreposição só no fim do passo) teria atravessado o mesmo brick.
+//
+// Uso:
+//  ccdcheck [--seed N]
+//
+// Cenários:
+//  1) bola contra um brick (hp alto, não parte) a 10.5..400 u/s com dt 1/240..1/15
+//  2) bola contra o paddle, mesmas velocidades
+//  3) corredor entre dois bricks: vários bounces num só passo
+//  4) bolas aleatórias num campo de bricks: o centro nunca acaba dentro de um brick nem fora
+//     da arena
+// -----------------------------------------------------------------------------
+
+#include "game/systems/CollisionSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+
+using game::Ball;
+using game::Brick;
+using game::CollisionSystem;
+using game::GameConfig;
+using game::GameState;
+
+const float kSpeeds[] = {10.5f, 40.0f, 120.0f, 400.0f};
+const float kDts[] = {1.0f / 240.0f, 1.0f / 60.0f, 1.0f / 15.0f};
+
+int g_failures = 0;
+
+void fail(const char* what, float speed, float dt) {
+    std::fprintf(stderr, "  FAIL %s (speed %.1f, dt 1/%.0f)\n", what, speed, 1.0f / dt);
+    g_failures++;
+}
+
+// `withPaddle=false` tira o paddle da arena (cenários só de bricks).
+void resetState(GameState& s, const GameConfig& cfg, bool withPaddle = true) {
+    s = GameState();
+    s.gameType = game::GameType::ENDLESS; // sem win finisher quando o campo esvazia
+    s.mode = game::GameMode::PLAYING;
+    s.bricks.configureGrid(cfg.arenaMinX, cfg.arenaMaxX, cfg.arenaMinZ, cfg.arenaMaxZ,
+                           cfg.brickGridCellX, cfg.brickGridCellZ);
+    s.paddlePos = glm::vec3(withPaddle ? 0.0f : 1000.0f, 0.0f, cfg.arenaMaxZ - cfg.paddleSize.z * 0.5f - 0.25f);
+}
+
+int addBrick(GameState& s, float x, float z, int hp = 1000000) {
+    Brick b;
+    b.pos = glm::vec3(x, 0.0f, z);
+    b.size = glm::vec3(2.95f, 0.7f, 1.30f);
+    b.hp = b.maxHp = hp;
+    b.alive = true;
+    return s.bricks.add(b);
+}
+
+// Passos suficientes para percorrer `dist` (mais folga).
+int stepsFor(float dist, float speed, float dt) {
+    return (int)std::ceil(dist / (speed * dt)) + 4;
+}
+
+// Integração antiga: move e testa sobreposição só no fim (devolve true se atravessou sem tocar).
+bool discreteTunnels(float speed, float dt, float r, float brickMinZ, float brickMaxZ, float startZ) {
+    float z = startZ;
+    for (int i = 0; i < 100000 && z > brickMinZ - r - 1.0f; ++i) {
+        z -= speed * dt;
+        if (z - r <= brickMaxZ && z + r >= brickMinZ) return false; // apanhou a sobreposição
+    }
+    return true;
+}
+
+// 1) brick frontal
+void brickScenario(const GameConfig& cfg, int& discreteTunnelCount) {
+    int before = g_failures;
+    std::printf("brick:    ");
+    for (float speed : kSpeeds) {
+        for (float dt : kDts) {
+            GameState s;
+            resetState(s, cfg, false);
+            int bi = addBrick(s, 0.0f, 0.0f);
+            float maxZ = s.bricks.maxZ(bi), minZ = s.bricks.minZ(bi);
+
+            Ball b;
+            b.pos = glm::vec3(0.3f, 0.0f, 6.0f);
+            b.vel = glm::vec3(0.0f, 0.0f, -speed);
+
+            bool hit = false;
+            const int steps = stepsFor(6.0f, speed, dt);
+            for (int step = 0; step < steps && !hit; ++step) {
+                auto mv = CollisionSystem::moveBall(b, s, cfg.paddleSize, cfg, dt);
+                hit = mv.brick.hit;
+                if (b.pos.z < maxZ + cfg.ballRadius - 1e-3f) {
+                    fail("ball crossed brick face", speed, dt);
+                    break;
+                }
+            }
+            if (!hit) fail("no brick hit", speed, dt);
+            else if (b.vel.z <= 0.0f) fail("ball did not bounce off brick", speed, dt);
+
+            if (discreteTunnels(speed, dt, cfg.ballRadius, minZ, maxZ, 6.0f)) discreteTunnelCount++;
+        }
+    }
+    std::printf("%s\n", g_failures == before ? "ok" : "failures");
+}
+
+// 2) paddle
+void paddleScenario(const GameConfig& cfg) {
+    int before = g_failures;
+    std::printf("paddle:   ");
+    for (float speed : kSpeeds) {
+        for (float dt : kDts) {
+            GameState s;
+            resetState(s, cfg);
+
+            Ball b;
+            b.pos = glm::vec3(0.5f, 0.0f, s.paddlePos.z - 8.0f);
+            b.vel = glm::vec3(0.0f, 0.0f, speed);
+
+            bool hit = false;
+            float front = s.paddlePos.z - cfg.paddleSize.z * 0.5f;
+            const int steps = stepsFor(8.0f, speed, dt);
+            for (int step = 0; step < steps && !hit; ++step) {
+                auto mv = CollisionSystem::moveBall(b, s, cfg.paddleSize, cfg, dt);
+                hit = mv.paddle;
+                if (b.pos.z > front - cfg.ballRadius + 1e-3f) {
+                    fail("ball crossed paddle", speed, dt);
+                    break;
+                }
+            }
+            if (!hit) fail("no paddle hit", speed, dt);
+            else if (b.vel.z >= 0.0f) fail("ball did not bounce off paddle", speed, dt);
+        }
+    }
+    std::printf("%s\n", g_failures == before ? "ok" : "failures");
+}
+
+// 3) corredor: bounces múltiplos num passo, a bola fica entre os dois bricks
+void corridorScenario(const GameConfig& cfg) {
+    int before = g_failures;
+    int maxContacts = 0;
+    std::printf("corridor: ");
+    for (float speed : kSpeeds) {
+        for (float dt : kDts) {
+            GameState s;
+            resetState(s, cfg, false);
+            int top = addBrick(s, 0.0f, -2.0f);
+            int bot = addBrick(s, 0.0f, 2.0f);
+            float lo = s.bricks.maxZ(top) + cfg.ballRadius - 1e-3f;
+            float hi = s.bricks.minZ(bot) - cfg.ballRadius + 1e-3f;
+
+            Ball b;
+            b.pos = glm::vec3(0.0f, 0.0f, 0.0f);
+            b.vel = glm::vec3(0.0f, 0.0f, -speed);
+            for (int step = 0; step < 32; ++step) {
+                auto mv = CollisionSystem::moveBall(b, s, cfg.paddleSize, cfg, dt);
+                maxContacts = std::max(maxContacts, mv.contacts);
+                if (b.pos.z < lo || b.pos.z > hi) {
+                    fail("ball left the corridor", speed, dt);
+                    break;
+                }
+            }
+        }
+    }
+    std::printf("%s (up to %d contacts in one step)\n", g_failures == before ? "ok" : "failures", maxContacts);
+    if (maxContacts < 2) {
+        std::fprintf(stderr, "  FAIL expected several bounces per step in the corridor\n");
+        g_failures++;
+    }
+}
+
+// 4) campo aleatório
+void fieldScenario(const GameConfig& cfg, unsigned seed) {
+    int before = g_failures;
+    std::printf("field:    ");
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> ua(0.0f, 6.2831853f);
+
+    for (float dt : kDts) {
+        GameState s;
+        resetState(s, cfg);
+        s.rng.reseed(seed); // drops de powerups dos bricks que partem
+        for (int r = 0; r < 6; ++r)
+            for (int c = 0; c < 12; ++c)
+                if ((r + c) % 3 != 0) addBrick(s, -16.39f + c * 2.99f, -10.5f + r * 2.4f);
+
+        std::vector<Ball> balls(32);
+        for (auto& b : balls) {
+            float a = ua(rng);
+            b.pos = glm::vec3(-15.0f + 30.0f * (float)(rng() % 1000) / 1000.0f, 0.0f, 9.0f);
+            b.vel = glm::vec3(std::cos(a), 0.0f, -std::abs(std::sin(a)) - 0.2f) * 120.0f;
+        }
+
+        bool bad = false;
+        for (int step = 0; step < 2000 && !bad; ++step) {
+            for (auto& b : balls) {
+                CollisionSystem::moveBall(b, s, cfg.paddleSize, cfg, dt);
+                if (b.pos.z > s.paddlePos.z) { b.pos.z = 9.0f; b.vel.z = -std::abs(b.vel.z); } // "perdida"
+                if (b.pos.x < cfg.arenaMinX + cfg.ballRadius - 1e-3f || b.pos.x > cfg.arenaMaxX - cfg.ballRadius + 1e-3f ||
+                    b.pos.z < cfg.arenaMinZ + cfg.ballRadius - 1e-3f) {
+                    fail("ball left the arena", 120.0f, dt);
+                    bad = true;
+                    break;
+                }
+                for (int i = 0; i < s.bricks.size() && !bad; ++i) {
+                    if (!s.bricks.alive(i)) continue;
+                    // centro dentro do brick encolhido pela folga = atravessou
+                    if (b.pos.x > s.bricks.minX(i) + 1e-3f && b.pos.x < s.bricks.maxX(i) - 1e-3f &&
+                        b.pos.z > s.bricks.minZ(i) + 1e-3f && b.pos.z < s.bricks.maxZ(i) - 1e-3f) {
+                        fail("ball center inside a brick", 120.0f, dt);
+                        bad = true;
+                    }
+                }
+            }
+        }
+    }
+    std::printf("%s\n", g_failures == before ? "ok" : "failures");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned seed = 1234u;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: ccdcheck [--seed N]\n");
+            return 2;
+        }
+    }
+
+    GameConfig cfg;
+    int discreteTunnels = 0;
+
+    brickScenario(cfg, discreteTunnels);
+    paddleScenario(cfg);
+    corridorScenario(cfg);
+    fieldScenario(cfg, seed);
+
+    const int cases = (int)(sizeof(kSpeeds) / sizeof(kSpeeds[0]) * sizeof(kDts) / sizeof(kDts[0]));
+    std::printf("discrete end-of-step test would tunnel through the brick in %d/%d speed/dt cases\n",
+                discreteTunnels, cases);
+
+    if (g_failures) {
+        std::fprintf(stderr, "[ccdcheck] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
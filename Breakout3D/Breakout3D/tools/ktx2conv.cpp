@@ -0,0 +1,409 @@
+// ktx2conv.cpp
+// -----------------------------------------------------------------------------
+// ktx2conv.cpp
+//
+// Responsabilidade:
+//  - Converter imagens (PNG/JPG) para KTX2 com a cadeia de mips pré-calculada.
+//  - Comprimir em BC1 (opaco) / BC3 (com alpha) ou guardar RGBA8 (fallback universal).
+//  - Reportar, por ficheiro, o custo de decode do original e a VRAM antes/depois.
+//
+// Uso:
+//  ktx2conv [--format auto|bc1|bc3|rgba8] [--no-flip] <in.png> <out.ktx2>
+//  ktx2conv [--format ...] [--no-flip] --dir <pasta>     (converte *.png para <nome>.ktx2)
+//
+// Notas:
+//  - Por omissão aplica flipY (igual a Texture2D::loadFromFile) e marca KTXorientation "ru".
+//  - O encoder BC é o clássico bounding-box com inset (rápido, qualidade razoável).
+//    BC7 é suportado no load, mas tem de vir de um encoder externo (toktx, compressonator).
+// -----------------------------------------------------------------------------
+
+#include "engine/Ktx2Format.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace ktx2 = engine::ktx2;
+
+namespace {
+
+enum class Format { Auto, BC1, BC3, RGBA8 };
+
+struct Options {
+    Format format = Format::Auto;
+    bool flipY = true;
+};
+
+struct Report {
+    int files = 0;
+    double decodeMs = 0.0;
+    std::uint64_t vramBefore = 0; // RGBA8 + glGenerateMipmap (caminho PNG)
+    std::uint64_t vramAfter = 0;  // bytes dos níveis no KTX2
+};
+
+struct Image {
+    int w = 0, h = 0;
+    std::vector<unsigned char> rgba;
+};
+
+// ---------- Mips ----------
+// Box filter 2x2 (dimensões ímpares repetem a última linha/coluna).
+Image downsample(const Image& src) {
+    Image dst;
+    dst.w = std::max(1, src.w / 2);
+    dst.h = std::max(1, src.h / 2);
+    dst.rgba.resize((size_t)dst.w * dst.h * 4);
+
+    for (int y = 0; y < dst.h; ++y) {
+        for (int x = 0; x < dst.w; ++x) {
+            int x0 = std::min(src.w - 1, x * 2), x1 = std::min(src.w - 1, x * 2 + 1);
+            int y0 = std::min(src.h - 1, y * 2), y1 = std::min(src.h - 1, y * 2 + 1);
+            for (int c = 0; c < 4; ++c) {
+                int sum = src.rgba[((size_t)y0 * src.w + x0) * 4 + c] + src.rgba[((size_t)y0 * src.w + x1) * 4 + c] +
+                          src.rgba[((size_t)y1 * src.w + x0) * 4 + c] + src.rgba[((size_t)y1 * src.w + x1) * 4 + c];
+                dst.rgba[((size_t)y * dst.w + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+// ---------- BC1 / BC3 ----------
+std::uint16_t to565(const int c[3]) {
+    return (std::uint16_t)(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+}
+
+void from565(std::uint16_t v, int out[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Bloco de cor BC1 em modo 4 cores (c0 > c1). `block` = 16 texels RGBA.
+void encodeColorBlock(const unsigned char* block, unsigned char out[8]) {
+    int mn[3] = {255, 255, 255}, mx[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            mn[c] = std::min(mn[c], (int)block[i * 4 + c]);
+            mx[c] = std::max(mx[c], (int)block[i * 4 + c]);
+        }
+    }
+    // Inset de 1/16 da caixa: reduz o erro médio dos extremos.
+    for (int c = 0; c < 3; ++c) {
+        int inset = (mx[c] - mn[c]) >> 4;
+        mn[c] = std::min(255, mn[c] + inset);
+        mx[c] = std::max(0, mx[c] - inset);
+    }
+
+    std::uint16_t c0 = to565(mx), c1 = to565(mn);
+    if (c0 < c1) std::swap(c0, c1);
+
+    int pal[4][3];
+    from565(c0, pal[0]);
+    from565(c1, pal[1]);
+    for (int c = 0; c < 3; ++c) {
+        pal[2][c] = (2 * pal[0][c] + pal[1][c]) / 3;
+        pal[3][c] = (pal[0][c] + 2 * pal[1][c]) / 3;
+    }
+
+    std::uint32_t indices = 0;
+    if (c0 != c1) {
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestD = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int d = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int e = (int)block[i * 4 + c] - pal[p][c];
+                    d += e * e;
+                }
+                if (d < bestD) { bestD = d; best = p; }
+            }
+            indices |= (std::uint32_t)best << (i * 2);
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF); out[3] = (unsigned char)(c1 >> 8);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+// Bloco de alpha BC3 em modo 8 valores (a0 > a1).
+void encodeAlphaBlock(const unsigned char* block, unsigned char out[8]) {
+    int mn = 255, mx = 0;
+    for (int i = 0; i < 16; ++i) {
+        mn = std::min(mn, (int)block[i * 4 + 3]);
+        mx = std::max(mx, (int)block[i * 4 + 3]);
+    }
+
+    out[0] = (unsigned char)mx;
+    out[1] = (unsigned char)mn;
+    std::uint64_t bits = 0;
+    if (mx != mn) {
+        int pal[8];
+        pal[0] = mx;
+        pal[1] = mn;
+        for (int k = 1; k <= 6; ++k) pal[k + 1] = ((7 - k) * mx + k * mn) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int a = block[i * 4 + 3], best = 0, bestD = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                int d = std::abs(a - pal[p]);
+                if (d < bestD) { bestD = d; best = p; }
+            }
+            bits |= (std::uint64_t)best << (i * 3);
+        }
+    }
+    for (int b = 0; b < 6; ++b) out[2 + b] = (unsigned char)((bits >> (b * 8)) & 0xFF);
+}
+
+std::vector<unsigned char> encodeLevel(const Image& img, std::uint32_t vkFormat) {
+    if (vkFormat == ktx2::kVkR8G8B8A8Unorm) return img.rgba;
+
+    const int bw = (img.w + 3) / 4, bh = (img.h + 3) / 4;
+    const std::uint32_t bb = ktx2::blockBytes(vkFormat);
+    std::vector<unsigned char> out((size_t)bw * bh * bb);
+    unsigned char block[16 * 4];
+
+    for (int by = 0; by < bh; ++by) {
+        for (int bx = 0; bx < bw; ++bx) {
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(img.w - 1, bx * 4 + x), sy = std::min(img.h - 1, by * 4 + y);
+                    std::memcpy(block + (y * 4 + x) * 4, img.rgba.data() + ((size_t)sy * img.w + sx) * 4, 4);
+                }
+            }
+            unsigned char* dst = out.data() + ((size_t)by * bw + bx) * bb;
+            if (vkFormat == ktx2::kVkBc3Unorm) {
+                encodeAlphaBlock(block, dst);
+                encodeColorBlock(block, dst + 8);
+            } else {
+                encodeColorBlock(block, dst);
+            }
+        }
+    }
+    return out;
+}
+
+// ---------- KTX2 writer ----------
+void put32(std::vector<unsigned char>& v, std::uint32_t x) {
+    for (int i = 0; i < 4; ++i) v.push_back((unsigned char)(x >> (i * 8)));
+}
+
+// Data Format Descriptor "basic" (Khronos DFD 1.3) para os formatos suportados.
+std::vector<unsigned char> buildDfd(std::uint32_t vkFormat) {
+    struct Sample { std::uint32_t bitOffset, bitLength, channel, upper; };
+    static const Sample kBc1[] = {{0, 64, 0, 0xFFFFFFFFu}};
+    static const Sample kBc3[] = {{0, 64, 15, 0xFFFFFFFFu}, {64, 64, 0, 0xFFFFFFFFu}};
+    static const Sample kRgba8[] = {{0, 8, 0, 255}, {8, 8, 1, 255}, {16, 8, 2, 255}, {24, 8, 15, 255}};
+
+    const Sample* samples = kRgba8;
+    std::uint32_t sampleCount = 4;
+    std::uint32_t model = 1, blockDim = 0, bytesPlane0 = 4;
+
+    if (vkFormat == ktx2::kVkBc1RgbUnorm) {
+        model = 128; blockDim = 3 | (3 << 8); bytesPlane0 = 8;
+        samples = kBc1; sampleCount = 1;
+    } else if (vkFormat == ktx2::kVkBc3Unorm) {
+        model = 130; blockDim = 3 | (3 << 8); bytesPlane0 = 16;
+        samples = kBc3; sampleCount = 2;
+    }
+
+    std::vector<unsigned char> d;
+    const std::uint32_t blockSize = 24 + 16 * sampleCount;
+    put32(d, 4 + blockSize);                    // dfdTotalSize
+    put32(d, 0);                                // vendorId=0 | descriptorType=0
+    put32(d, 2 | (blockSize << 16));            // versionNumber=2 | descriptorBlockSize
+    put32(d, model | (1u << 8) | (1u << 16));   // model | primaries BT709 | transfer linear | flags 0
+    put32(d, blockDim);                         // texelBlockDimension0..3
+    put32(d, bytesPlane0);                      // bytesPlane0..3
+    put32(d, 0);                                // bytesPlane4..7
+    for (std::uint32_t i = 0; i < sampleCount; ++i) {
+        const Sample& s = samples[i];
+        put32(d, s.bitOffset | ((s.bitLength - 1) << 16) | (s.channel << 24));
+        put32(d, 0);                            // samplePosition0..3
+        put32(d, 0);                            // sampleLower
+        put32(d, s.upper);                      // sampleUpper
+    }
+    return d;
+}
+
+std::vector<unsigned char> buildKvd(bool flipY) {
+    std::vector<unsigned char> kvd;
+    auto add = [&](const std::string& key, const std::string& value) {
+        std::string kv = key + '\0' + value + '\0';
+        put32(kvd, (std::uint32_t)kv.size());
+        kvd.insert(kvd.end(), kv.begin(), kv.end());
+        while (kvd.size() % 4) kvd.push_back(0);
+    };
+    add("KTXorientation", flipY ? "ru" : "rd");
+    add("KTXwriter", "Breakout3D ktx2conv");
+    return kvd;
+}
+
+bool writeKtx2(const std::string& outPath, const std::vector<Image>& mips, std::uint32_t vkFormat, bool flipY,
+               std::uint64_t& outLevelBytes) {
+    const std::uint32_t levels = (std::uint32_t)mips.size();
+    std::vector<std::vector<unsigned char>> data(levels);
+    for (std::uint32_t i = 0; i < levels; ++i) data[i] = encodeLevel(mips[i], vkFormat);
+
+    const std::vector<unsigned char> dfd = buildDfd(vkFormat);
+    const std::vector<unsigned char> kvd = buildKvd(flipY);
+
+    ktx2::Header hdr{};
+    hdr.vkFormat = vkFormat;
+    hdr.typeSize = 1;
+    hdr.pixelWidth = (std::uint32_t)mips[0].w;
+    hdr.pixelHeight = (std::uint32_t)mips[0].h;
+    hdr.faceCount = 1;
+    hdr.levelCount = levels;
+
+    ktx2::Index idx{};
+    idx.dfdByteOffset = ktx2::kLevelIndexOffset + levels * (std::uint32_t)sizeof(ktx2::LevelIndex);
+    idx.dfdByteLength = (std::uint32_t)dfd.size();
+    idx.kvdByteOffset = idx.dfdByteOffset + idx.dfdByteLength;
+    idx.kvdByteLength = (std::uint32_t)kvd.size();
+
+    // Dados dos níveis: do mais pequeno para o maior, cada um alinhado ao bloco (e a 4).
+    const std::uint64_t align = std::max<std::uint32_t>(4, ktx2::blockBytes(vkFormat));
+    std::vector<ktx2::LevelIndex> lidx(levels);
+    std::uint64_t pos = idx.kvdByteOffset + idx.kvdByteLength;
+    outLevelBytes = 0;
+    for (int i = (int)levels - 1; i >= 0; --i) {
+        pos = (pos + align - 1) / align * align;
+        lidx[i].byteOffset = pos;
+        lidx[i].byteLength = data[i].size();
+        lidx[i].uncompressedByteLength = data[i].size();
+        pos += data[i].size();
+        outLevelBytes += data[i].size();
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(ktx2::kIdentifier), sizeof(ktx2::kIdentifier));
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char*>(&idx), sizeof(idx));
+    out.write(reinterpret_cast<const char*>(lidx.data()), (std::streamsize)(lidx.size() * sizeof(ktx2::LevelIndex)));
+    out.write(reinterpret_cast<const char*>(dfd.data()), (std::streamsize)dfd.size());
+    out.write(reinterpret_cast<const char*>(kvd.data()), (std::streamsize)kvd.size());
+
+    std::uint64_t cur = idx.kvdByteOffset + idx.kvdByteLength;
+    for (int i = (int)levels - 1; i >= 0; --i) {
+        while (cur < lidx[i].byteOffset) { out.put('\0'); ++cur; }
+        out.write(reinterpret_cast<const char*>(data[i].data()), (std::streamsize)data[i].size());
+        cur += data[i].size();
+    }
+    return (bool)out;
+}
+
+// ---------- Conversão ----------
+int convertFile(const std::string& inPath, const std::string& outPath, const Options& opt, Report& rep) {
+    const auto t0 = std::chrono::steady_clock::now();
+    stbi_set_flip_vertically_on_load(opt.flipY ? 1 : 0);
+    Image base;
+    int comp = 0;
+    unsigned char* px = stbi_load(inPath.c_str(), &base.w, &base.h, &comp, 4);
+    const double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (!px) {
+        std::cerr << "[ktx2conv] can't decode: " << inPath << "\n";
+        return 1;
+    }
+    base.rgba.assign(px, px + (size_t)base.w * base.h * 4);
+    stbi_image_free(px);
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < base.rgba.size() && !hasAlpha; i += 4) hasAlpha = base.rgba[i] != 255;
+
+    std::uint32_t vk = ktx2::kVkR8G8B8A8Unorm;
+    switch (opt.format) {
+        case Format::Auto:  vk = hasAlpha ? ktx2::kVkBc3Unorm : ktx2::kVkBc1RgbUnorm; break;
+        case Format::BC1:   vk = ktx2::kVkBc1RgbUnorm; break;
+        case Format::BC3:   vk = ktx2::kVkBc3Unorm; break;
+        case Format::RGBA8: vk = ktx2::kVkR8G8B8A8Unorm; break;
+    }
+
+    std::vector<Image> mips;
+    mips.push_back(std::move(base));
+    while (mips.back().w > 1 || mips.back().h > 1) mips.push_back(downsample(mips.back()));
+
+    std::uint64_t after = 0;
+    if (!writeKtx2(outPath, mips, vk, opt.flipY, after)) {
+        std::cerr << "[ktx2conv] can't write: " << outPath << "\n";
+        return 1;
+    }
+
+    // "Antes": o que o caminho PNG ocupa (RGB/RGBA -> RGBA8 na GPU, + ~1/3 de mips).
+    const std::uint64_t level0 = (std::uint64_t)mips[0].w * mips[0].h * 4;
+    const std::uint64_t before = level0 + level0 / 3;
+
+    const char* fmtName = vk == ktx2::kVkBc3Unorm ? "BC3" : vk == ktx2::kVkBc1RgbUnorm ? "BC1" : "RGBA8";
+    std::printf("%-48s %5dx%-5d %-5s %2zu mips  decode %7.1f ms  VRAM %6.2f -> %6.2f MB\n",
+                outPath.c_str(), mips[0].w, mips[0].h, fmtName, mips.size(), decodeMs,
+                before / (1024.0 * 1024.0), after / (1024.0 * 1024.0));
+
+    rep.files++;
+    rep.decodeMs += decodeMs;
+    rep.vramBefore += before;
+    rep.vramAfter += after;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::vector<std::string> args;
+    std::string dir;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--no-flip") {
+            opt.flipY = false;
+        } else if (a == "--format" && i + 1 < argc) {
+            std::string f = argv[++i];
+            if (f == "auto") opt.format = Format::Auto;
+            else if (f == "bc1") opt.format = Format::BC1;
+            else if (f == "bc3") opt.format = Format::BC3;
+            else if (f == "rgba8") opt.format = Format::RGBA8;
+            else { std::cerr << "[ktx2conv] unknown format: " << f << "\n"; return 2; }
+        } else if (a == "--dir" && i + 1 < argc) {
+            dir = argv[++i];
+        } else {
+            args.push_back(a);
+        }
+    }
+
+    Report rep;
+    int rc = 0;
+    if (!dir.empty()) {
+        std::vector<fs::path> inputs;
+        for (auto const& e : fs::directory_iterator(dir)) {
+            if (e.is_regular_file() && e.path().extension() == ".png") inputs.push_back(e.path());
+        }
+        std::sort(inputs.begin(), inputs.end());
+        for (const auto& p : inputs) {
+            rc |= convertFile(p.string(), fs::path(p).replace_extension(".ktx2").string(), opt, rep);
+        }
+    } else if (args.size() == 2) {
+        rc = convertFile(args[0], args[1], opt, rep);
+    } else {
+        std::cerr << "usage: ktx2conv [--format auto|bc1|bc3|rgba8] [--no-flip] <in.png> <out.ktx2>\n"
+                  << "       ktx2conv [--format ...] [--no-flip] --dir <folder>\n";
+        return 2;
+    }
+
+    if (rep.files > 1) {
+        std::printf("[ktx2conv] %d files: PNG decode %.1f ms total, VRAM %.2f MB -> %.2f MB\n",
+                    rep.files, rep.decodeMs, rep.vramBefore / (1024.0 * 1024.0), rep.vramAfter / (1024.0 * 1024.0));
+    }
+    return rc;
+}
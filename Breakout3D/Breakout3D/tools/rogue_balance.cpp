@@ -0,0 +1,568 @@
+// rogue_balance.cpp
+// -----------------------------------------------------------------------------
+// rogue_balance.cpp
+//
+// Responsabilidade:
+//  - Monte Carlo de balanceamento: corre milhares de runs completas de Rogue e Endless em
+//    paralelo (libbreakout_sim.a + o bot do tools/sim_bot.hpp), com políticas de escolha de
+//    cartas configuráveis, em vez de afinar RogueSystem/RogueCards à mão a jogar.
+//  - Agrega por (modo, política): curva de sobrevivência, distribuição de score e, no Rogue,
+//    o delta de win rate (e de wave/score médios) de cada carta: runs que a escolheram vs
+//    runs da mesma política que não a escolheram.
+//  - Escreve CSV (runs, survival, scores, cards) e um JSON com tudo, e reporta runs/s/core.
+//
+// Uso:
+//  rogue_balance [--mode rogue|endless|both] [--runs N] [--policy P[,P...]] [--seconds S]
+//                [--seed N] [--threads N] [--out PREFIX] [--list-cards]
+//    --runs     runs por política (default 1000); a run i usa o seed `seed + i` em todas as
+//               políticas, por isso as políticas são comparadas sobre as mesmas runs
+//    --policy   random (default), op, safe, prefer:CARD, avoid:CARD
+//               CARD = id numérico ou abreviatura única (ver --list-cards)
+//    --seconds  limite de tempo simulado por run (default 1800)
+//    --threads  default = nº de cores
+//    --out      prefixo dos ficheiros (default rogue_balance): PREFIX_runs.csv,
+//               PREFIX_survival.csv, PREFIX_scores.csv, PREFIX_cards.csv, PREFIX.json
+//
+// Notas:
+//  - Rogue: "win" = mode WIN (limpou a última wave). Endless não tem vitória: conta como
+//    "win" sobreviver até --seconds. Os fins de run distinguem "lives" (sem vidas) de
+//    "overrun" (bricks chegaram ao paddle).
+//  - Survival: no Rogue, fracção das runs que chegaram à wave w (a última linha, w = max+1,
+//    é a fracção que ganhou); no Endless, fracção ainda viva ao minuto m.
+//  - Os deltas por carta têm viés de sobrevivência: quem chega mais longe vê mais offers e
+//    escolhe mais cartas. Para medir uma carta, comparar prefer:CARD/avoid:CARD com random
+//    (mesmos seeds) em vez de confiar só no win_delta.
+//  - O Endless não tem cartas: corre uma vez com a política "-" (só o bot).
+//  - Determinístico: os agregados só dependem de --seed/--runs/--policy, não de --threads.
+// -----------------------------------------------------------------------------
+
+#include "game/systems/SimulationSystem.hpp"
+#include "game/systems/InitSystem.hpp"
+#include "game/rogue/RogueCards.hpp"
+#include "sim_bot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using game::GameConfig;
+using game::GameMode;
+using game::GameState;
+using game::GameType;
+using game::SimEventType;
+using game::SimulationSystem;
+using game::rogue::RogueCardId;
+using simbot::kStep;
+using clock_type = std::chrono::steady_clock;
+
+// ---------------------------------------------------------------------------
+// Cartas
+// ---------------------------------------------------------------------------
+const std::vector<RogueCardId>& cards() { return game::rogue::allCardIds(); }
+
+int cardIndex(RogueCardId id) {
+    const auto& all = cards();
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        if (all[i] == id) return (int)i;
+    }
+    return -1;
+}
+
+bool parseCard(const std::string& key, RogueCardId& out) {
+    std::string up;
+    for (char c : key) up += (char)std::toupper((unsigned char)c);
+    // Id numérico, ou abreviatura se for única (várias cartas partilham "MOD"/"ROW").
+    int matches = 0;
+    for (RogueCardId id : cards()) {
+        if (up == std::to_string((int)id)) { out = id; return true; }
+        if (up == game::rogue::cardAbbrev(id)) { out = id; matches++; }
+    }
+    return matches == 1;
+}
+
+// Curses e cartas que tiram vida/controlo: o que a política "safe" evita.
+bool isRisky(RogueCardId id) {
+    switch (id) {
+    case RogueCardId::PU_REVERSE:
+    case RogueCardId::PU_TINY:
+    case RogueCardId::MOD_LUCKY_DROPS_BRITTLE:
+    case RogueCardId::MOD_GLASS_CANNON:
+    case RogueCardId::MOD_CURSE_ENGINE:
+    case RogueCardId::MOD_RUSH_MODE:
+    case RogueCardId::MOD_FRAIL_PADDLE:
+    case RogueCardId::MOD_FAST_PADDLE_TINY_PADDLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Vidas, paddle maior, shield e menos rows: o que a política "safe" procura.
+bool isSurvival(RogueCardId id) {
+    switch (id) {
+    case RogueCardId::PU_EXTRA_LIFE:
+    case RogueCardId::PU_SHIELD:
+    case RogueCardId::PU_EXPAND:
+    case RogueCardId::MOD_BONUS_LIFE_TAX:
+    case RogueCardId::MOD_WIDE_PADDLE_SLOW:
+    case RogueCardId::MOD_ROW_BARGAIN:
+    case RogueCardId::OP_HEART_STOCKPILE:
+    case RogueCardId::OP_TITAN_PADDLE:
+    case RogueCardId::OP_SHIELD_GENERATOR:
+    case RogueCardId::OP_ROW_CONTROL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Políticas: cada carta da offer leva uma nota; ganha a maior, empates ao acaso (rng do bot).
+// ---------------------------------------------------------------------------
+struct Policy {
+    enum Kind { NONE, RANDOM, OP, SAFE, PREFER, AVOID };
+    Kind kind = RANDOM;
+    RogueCardId card = RogueCardId::PU_EXPAND;
+    std::string name;
+
+    int score(RogueCardId id) const {
+        switch (kind) {
+        case OP:     return game::rogue::cardDef(id).isOp ? 2 : (game::rogue::isPowerupCard(id) && !isRisky(id) ? 1 : 0);
+        case SAFE:   return isSurvival(id) ? 1 : (isRisky(id) ? -1 : 0);
+        case PREFER: return id == card ? 1 : 0;
+        case AVOID:  return id == card ? -1 : 0;
+        default:     return 0;
+        }
+    }
+
+    int pick(const GameState& s, std::mt19937& rng) const {
+        int best = -1000, ties = 0, chosen = 0;
+        for (int i = 0; i < s.rogueOfferCount; ++i) {
+            int sc = score(s.rogueOffer[i]);
+            if (sc > best) { best = sc; ties = 1; chosen = i; }
+            else if (sc == best && rng() % (unsigned)++ties == 0u) chosen = i; // reservoir: empate uniforme
+        }
+        return chosen;
+    }
+};
+
+bool parsePolicy(const std::string& text, Policy& p) {
+    p = Policy{};
+    p.name = text;
+    if (text == "random") { p.kind = Policy::RANDOM; return true; }
+    if (text == "op") { p.kind = Policy::OP; return true; }
+    if (text == "safe") { p.kind = Policy::SAFE; return true; }
+    auto colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    std::string head = text.substr(0, colon);
+    if (head == "prefer") p.kind = Policy::PREFER;
+    else if (head == "avoid") p.kind = Policy::AVOID;
+    else return false;
+    return parseCard(text.substr(colon + 1), p.card);
+}
+
+// ---------------------------------------------------------------------------
+// Uma run
+// ---------------------------------------------------------------------------
+enum class End { WIN, LIVES, OVERRUN, TIMEOUT, NO_CARDS };
+
+const char* endName(End e) {
+    switch (e) {
+    case End::WIN: return "win";
+    case End::LIVES: return "lives";
+    case End::OVERRUN: return "overrun";
+    case End::TIMEOUT: return "timeout";
+    case End::NO_CARDS: return "no_cards";
+    }
+    return "?";
+}
+
+struct Run {
+    End end = End::TIMEOUT;
+    bool won = false;
+    int score = 0, wave = 0, lives = 0, maxWaves = 0;
+    long long steps = 0;
+    std::vector<RogueCardId> picks;
+    std::vector<char> offered; // por índice em cards()
+};
+
+Run runOne(const GameConfig& cfg, GameType type, const Policy& policy, std::uint64_t seed, long long maxSteps) {
+    Run run;
+    run.offered.assign(cards().size(), 0);
+
+    GameState s;
+    s.gameType = type;
+    s.wave = 1;
+    game::InitSystem::initGame(s, cfg, seed);
+
+    simbot::Bot bot(seed);
+    game::SimEvents events;
+    events.reserve(64);
+
+    long long steps = 0;
+    for (; steps < maxSteps; ++steps) {
+        if (s.mode == GameMode::ROGUE_CARDS) {
+            if (s.rogueOfferCount <= 0) { run.end = End::NO_CARDS; break; }
+            for (int i = 0; i < s.rogueOfferCount; ++i) {
+                int ci = cardIndex(s.rogueOffer[i]);
+                if (ci >= 0) run.offered[(std::size_t)ci] = 1;
+            }
+            RogueCardId picked = s.rogueOffer[policy.pick(s, bot.rng)];
+            run.picks.push_back(picked);
+            game::rogue::applyPickedCard(s, cfg, picked);
+            if (s.mode == GameMode::PLAYING) s.rogueRowSpawnTimer = 0.15f;
+            continue;
+        }
+        if (s.mode != GameMode::PLAYING) break;
+
+        bot.drive(s, cfg);
+        events.clear();
+        SimulationSystem::step(s, cfg, kStep, events);
+        for (const auto& e : events) bot.observe(e);
+    }
+
+    if (s.mode == GameMode::WIN) run.end = End::WIN;
+    else if (s.mode == GameMode::GAME_OVER) run.end = s.lives > 0 ? End::OVERRUN : End::LIVES;
+
+    run.won = run.end == End::WIN || (type == GameType::ENDLESS && run.end == End::TIMEOUT);
+    run.score = s.score + s.endlessStreakPoints;
+    run.wave = s.wave;
+    run.lives = s.lives;
+    run.maxWaves = s.rogueMaxWaves;
+    run.steps = steps;
+    return run;
+}
+
+// ---------------------------------------------------------------------------
+// Agregados por grupo (modo + política)
+// ---------------------------------------------------------------------------
+struct Group {
+    GameType type;
+    Policy policy;
+    std::vector<Run> runs;
+};
+
+struct CardStat {
+    int offered = 0, picked = 0;
+    int winsWith = 0, winsWithout = 0;
+    long long waveWith = 0, waveWithout = 0;
+    long long scoreWith = 0, scoreWithout = 0;
+};
+
+double ratio(double a, double b) { return b > 0.0 ? a / b : 0.0; }
+
+int percentile(std::vector<int> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    std::size_t k = (std::size_t)std::lround(p * (double)(v.size() - 1));
+    return v[k];
+}
+
+// Largura de bin "redonda" (1/2/5 x 10^k) para ~20 bins até ao score máximo.
+int niceBin(int maxScore) {
+    double raw = std::max(1.0, (double)maxScore / 20.0);
+    double p = std::pow(10.0, std::floor(std::log10(raw)));
+    for (double m : {1.0, 2.0, 5.0, 10.0}) {
+        if (m * p >= raw) return std::max(1, (int)(m * p));
+    }
+    return (int)(10.0 * p);
+}
+
+// Pontos da curva de sobrevivência: (x, fracção viva).
+std::vector<std::pair<int, double>> survival(const Group& g, float maxSeconds) {
+    std::vector<std::pair<int, double>> out;
+    const double n = (double)g.runs.size();
+    if (g.type == GameType::ROGUE) {
+        int maxWaves = g.runs.empty() ? 0 : g.runs.front().maxWaves;
+        for (int w = 1; w <= maxWaves + 1; ++w) {
+            int alive = 0;
+            for (const Run& r : g.runs) alive += w <= maxWaves ? (r.won || r.wave >= w) : r.won;
+            out.push_back({w, ratio(alive, n)});
+        }
+    } else {
+        int minutes = (int)std::ceil(maxSeconds / 60.0f);
+        for (int m = 0; m <= minutes; ++m) {
+            int alive = 0;
+            for (const Run& r : g.runs) alive += (double)r.steps * kStep >= m * 60.0 || r.won;
+            out.push_back({m, ratio(alive, n)});
+        }
+    }
+    return out;
+}
+
+std::vector<CardStat> cardStats(const Group& g) {
+    std::vector<CardStat> st(cards().size());
+    for (const Run& r : g.runs) {
+        std::vector<char> has(cards().size(), 0);
+        for (RogueCardId id : r.picks) {
+            int ci = cardIndex(id);
+            if (ci >= 0) has[(std::size_t)ci] = 1;
+        }
+        for (std::size_t c = 0; c < st.size(); ++c) {
+            CardStat& cs = st[c];
+            cs.offered += r.offered[c];
+            if (has[c]) {
+                cs.picked++;
+                cs.winsWith += r.won;
+                cs.waveWith += r.wave;
+                cs.scoreWith += r.score;
+            } else {
+                cs.winsWithout += r.won;
+                cs.waveWithout += r.wave;
+                cs.scoreWithout += r.score;
+            }
+        }
+    }
+    return st;
+}
+
+const char* modeName(GameType t) { return t == GameType::ROGUE ? "rogue" : "endless"; }
+
+std::string csvQuote(const char* s) { return std::string("\"") + s + "\""; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool doRogue = true, doEndless = true;
+    int runsPerPolicy = 1000;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    float maxSeconds = 1800.0f;
+    std::uint64_t seed = 1u;
+    std::string out = "rogue_balance";
+    std::vector<Policy> policies;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--mode") && i + 1 < argc) {
+            std::string m = argv[++i];
+            doRogue = (m == "rogue" || m == "both");
+            doEndless = (m == "endless" || m == "both");
+            if (!doRogue && !doEndless) { std::fprintf(stderr, "unknown mode '%s'\n", m.c_str()); return 2; }
+        }
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) runsPerPolicy = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--policy") && i + 1 < argc) {
+            std::string list = argv[++i];
+            for (std::size_t a = 0; a <= list.size(); ) {
+                std::size_t b = list.find(',', a);
+                if (b == std::string::npos) b = list.size();
+                Policy p;
+                if (!parsePolicy(list.substr(a, b - a), p)) {
+                    std::fprintf(stderr, "unknown policy '%s'\n", list.substr(a, b - a).c_str());
+                    return 2;
+                }
+                policies.push_back(p);
+                a = b + 1;
+            }
+        }
+        else if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) maxSeconds = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else if (!std::strcmp(argv[i], "--list-cards")) {
+            for (RogueCardId id : cards()) {
+                std::printf("%3d  %-3s %s%s\n", (int)id, game::rogue::cardAbbrev(id).c_str(),
+                            game::rogue::cardDef(id).name, game::rogue::cardDef(id).isOp ? " (OP)" : "");
+            }
+            return 0;
+        }
+        else {
+            std::fprintf(stderr, "usage: rogue_balance [--mode rogue|endless|both] [--runs N] [--policy P[,P...]] "
+                                 "[--seconds S] [--seed N] [--threads N] [--out PREFIX] [--list-cards]\n"
+                                 "  policies: random, op, safe, prefer:CARD, avoid:CARD\n");
+            return 2;
+        }
+    }
+    if (policies.empty()) {
+        Policy p;
+        parsePolicy("random", p);
+        policies.push_back(p);
+    }
+
+    // Grupos e jobs: (grupo, índice da run). O seed só depende do índice da run.
+    std::vector<Group> groups;
+    if (doRogue) {
+        for (const Policy& p : policies) groups.push_back({GameType::ROGUE, p, {}});
+    }
+    if (doEndless) {
+        Policy none;
+        none.kind = Policy::NONE;
+        none.name = "-";
+        groups.push_back({GameType::ENDLESS, none, {}});
+    }
+    for (Group& g : groups) g.runs.resize((std::size_t)runsPerPolicy);
+
+    const GameConfig cfg;
+    const long long maxSteps = (long long)std::ceil(maxSeconds / kStep);
+    const int jobs = (int)groups.size() * runsPerPolicy;
+    threads = std::min(threads, jobs);
+
+    std::printf("rogue_balance: %d run(s) x %zu group(s), up to %.0f s each, seed %llu, %d thread(s)\n",
+                runsPerPolicy, groups.size(), maxSeconds, (unsigned long long)seed, threads);
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int j; (j = next.fetch_add(1)) < jobs; ) {
+            Group& g = groups[(std::size_t)(j / runsPerPolicy)];
+            int r = j % runsPerPolicy;
+            g.runs[(std::size_t)r] = runOne(cfg, g.type, g.policy, seed + (std::uint64_t)r, maxSteps);
+        }
+    };
+
+    auto t0 = clock_type::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    const double wall = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    long long totalSteps = 0;
+    for (const Group& g : groups) {
+        for (const Run& r : g.runs) totalSteps += r.steps;
+    }
+    const double runsPerSec = ratio(jobs, wall);
+    const double runsPerSecCore = runsPerSec / threads;
+
+    // ---------------- CSV ----------------
+    const std::string runsPath = out + "_runs.csv", survPath = out + "_survival.csv";
+    const std::string scoresPath = out + "_scores.csv", cardsPath = out + "_cards.csv", jsonPath = out + ".json";
+    FILE* fRuns = std::fopen(runsPath.c_str(), "w");
+    FILE* fSurv = std::fopen(survPath.c_str(), "w");
+    FILE* fScores = std::fopen(scoresPath.c_str(), "w");
+    FILE* fCards = std::fopen(cardsPath.c_str(), "w");
+    FILE* fJson = std::fopen(jsonPath.c_str(), "w");
+    if (!fRuns || !fSurv || !fScores || !fCards || !fJson) {
+        std::fprintf(stderr, "cannot write '%s_*'\n", out.c_str());
+        return 1;
+    }
+
+    std::fprintf(fRuns, "mode,policy,seed,end,won,score,wave,lives,seconds,picks\n");
+    std::fprintf(fSurv, "mode,policy,x,alive\n");
+    std::fprintf(fScores, "mode,policy,bin_lo,bin_hi,count\n");
+    std::fprintf(fCards, "policy,card_id,card,offered,picked,pick_rate,win_with,win_without,win_delta,"
+                         "wave_with,wave_without,wave_delta,score_with,score_without,score_delta\n");
+
+    std::fprintf(fJson, "{\n  \"seed\": %llu,\n  \"runs_per_group\": %d,\n  \"max_seconds\": %.1f,\n",
+                 (unsigned long long)seed, runsPerPolicy, maxSeconds);
+    std::fprintf(fJson, "  \"throughput\": {\"runs\": %d, \"threads\": %d, \"wall_s\": %.3f, \"runs_per_s\": %.2f, "
+                        "\"runs_per_s_per_core\": %.2f, \"steps_per_s\": %.0f},\n",
+                 jobs, threads, wall, runsPerSec, runsPerSecCore, ratio((double)totalSteps, wall));
+    std::fprintf(fJson, "  \"groups\": [\n");
+
+    std::printf("\n%-8s %-18s %6s %7s %9s %7s %7s %7s %7s\n",
+                "mode", "policy", "runs", "win%", "mean", "p10", "p50", "p90", "wave");
+
+    for (std::size_t gi = 0; gi < groups.size(); ++gi) {
+        const Group& g = groups[gi];
+        const char* mode = modeName(g.type);
+        const char* pol = g.policy.name.c_str();
+        const int n = (int)g.runs.size();
+
+        std::vector<int> scores;
+        int wins = 0, maxScore = 0;
+        long long scoreSum = 0, waveSum = 0;
+        double secSum = 0.0;
+        int ends[5] = {};
+        for (int r = 0; r < n; ++r) {
+            const Run& run = g.runs[(std::size_t)r];
+            scores.push_back(run.score);
+            wins += run.won;
+            scoreSum += run.score;
+            waveSum += run.wave;
+            secSum += (double)run.steps * kStep;
+            maxScore = std::max(maxScore, run.score);
+            ends[(int)run.end]++;
+
+            std::string picks;
+            for (RogueCardId id : run.picks) {
+                if (!picks.empty()) picks += ';';
+                picks += std::to_string((int)id);
+            }
+            std::fprintf(fRuns, "%s,%s,%llu,%s,%d,%d,%d,%d,%.2f,%s\n", mode, pol,
+                         (unsigned long long)(seed + (std::uint64_t)r), endName(run.end), run.won ? 1 : 0,
+                         run.score, run.wave, run.lives, (double)run.steps * kStep, picks.c_str());
+        }
+
+        const int p10 = percentile(scores, 0.10), p25 = percentile(scores, 0.25), p50 = percentile(scores, 0.50);
+        const int p75 = percentile(scores, 0.75), p90 = percentile(scores, 0.90);
+        std::printf("%-8s %-18s %6d %6.1f%% %9.1f %7d %7d %7d %7.2f\n", mode, pol, n, 100.0 * ratio(wins, n),
+                    ratio((double)scoreSum, n), p10, p50, p90, ratio((double)waveSum, n));
+
+        std::fprintf(fJson, "    {\"mode\": \"%s\", \"policy\": \"%s\", \"runs\": %d, \"win_rate\": %.4f, "
+                            "\"mean_score\": %.1f, \"mean_wave\": %.3f, \"mean_seconds\": %.1f,\n",
+                     mode, pol, n, ratio(wins, n), ratio((double)scoreSum, n), ratio((double)waveSum, n), ratio(secSum, n));
+        std::fprintf(fJson, "     \"ends\": {");
+        for (int e = 0; e < 5; ++e) std::fprintf(fJson, "%s\"%s\": %d", e ? ", " : "", endName((End)e), ends[e]);
+        std::fprintf(fJson, "},\n     \"score_percentiles\": {\"p10\": %d, \"p25\": %d, \"p50\": %d, \"p75\": %d, "
+                            "\"p90\": %d, \"max\": %d},\n", p10, p25, p50, p75, p90, maxScore);
+
+        // Survival
+        std::fprintf(fJson, "     \"survival\": {\"x\": \"%s\", \"points\": [", g.type == GameType::ROGUE ? "wave" : "minute");
+        auto surv = survival(g, maxSeconds);
+        for (std::size_t k = 0; k < surv.size(); ++k) {
+            std::fprintf(fSurv, "%s,%s,%d,%.4f\n", mode, pol, surv[k].first, surv[k].second);
+            std::fprintf(fJson, "%s[%d, %.4f]", k ? ", " : "", surv[k].first, surv[k].second);
+        }
+        std::fprintf(fJson, "]},\n");
+
+        // Histograma de score
+        const int bin = niceBin(maxScore);
+        std::vector<int> hist((std::size_t)(maxScore / bin + 1), 0);
+        for (int sc : scores) hist[(std::size_t)(sc / bin)]++;
+        std::fprintf(fJson, "     \"score_histogram\": {\"bin\": %d, \"counts\": [", bin);
+        for (std::size_t k = 0; k < hist.size(); ++k) {
+            std::fprintf(fScores, "%s,%s,%d,%d,%d\n", mode, pol, (int)k * bin, (int)(k + 1) * bin, hist[k]);
+            std::fprintf(fJson, "%s%d", k ? ", " : "", hist[k]);
+        }
+        std::fprintf(fJson, "]},\n");
+
+        // Cartas (só Rogue)
+        std::fprintf(fJson, "     \"cards\": [");
+        if (g.type == GameType::ROGUE) {
+            auto st = cardStats(g);
+            bool first = true;
+            for (std::size_t c = 0; c < st.size(); ++c) {
+                const CardStat& cs = st[c];
+                if (cs.offered == 0) continue;
+                const int without = n - cs.picked;
+                const double winW = ratio(cs.winsWith, cs.picked), winWo = ratio(cs.winsWithout, without);
+                const double waveW = ratio((double)cs.waveWith, cs.picked), waveWo = ratio((double)cs.waveWithout, without);
+                const double scW = ratio((double)cs.scoreWith, cs.picked), scWo = ratio((double)cs.scoreWithout, without);
+                const RogueCardId id = cards()[c];
+                const char* name = game::rogue::cardDef(id).name;
+
+                std::fprintf(fCards, "%s,%d,%s,%d,%d,%.4f,%.4f,%.4f,%+.4f,%.3f,%.3f,%+.3f,%.1f,%.1f,%+.1f\n",
+                             pol, (int)id, csvQuote(name).c_str(), cs.offered, cs.picked, ratio(cs.picked, cs.offered),
+                             winW, winWo, winW - winWo, waveW, waveWo, waveW - waveWo, scW, scWo, scW - scWo);
+                std::fprintf(fJson, "%s\n       {\"id\": %d, \"card\": \"%s\", \"offered\": %d, \"picked\": %d, "
+                                    "\"win_delta\": %.4f, \"wave_delta\": %.3f, \"score_delta\": %.1f}",
+                             first ? "" : ",", (int)id, name, cs.offered, cs.picked,
+                             winW - winWo, waveW - waveWo, scW - scWo);
+                first = false;
+            }
+            if (!first) std::fprintf(fJson, "\n     ");
+        }
+        std::fprintf(fJson, "]}%s\n", gi + 1 < groups.size() ? "," : "");
+    }
+    std::fprintf(fJson, "  ]\n}\n");
+
+    std::fclose(fRuns);
+    std::fclose(fSurv);
+    std::fclose(fScores);
+    std::fclose(fCards);
+    std::fclose(fJson);
+
+    std::printf("\nwrote %s, %s, %s, %s, %s\n", runsPath.c_str(), survPath.c_str(), scoresPath.c_str(),
+                cardsPath.c_str(), jsonPath.c_str());
+    std::printf("throughput: %d runs (%lld steps) in %.3f s wall on %d thread(s) = %.1f runs/s, %.1f runs/s/core\n",
+                jobs, totalSteps, wall, threads, runsPerSec, runsPerSecCore);
+    return 0;
+}
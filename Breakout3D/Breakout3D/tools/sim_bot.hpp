@@ -0,0 +1,78 @@
+// sim_bot.hpp
+#pragma once
+
+#include "game/systems/SimulationSystem.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+/**
+ * @file sim_bot.hpp
+ * @brief Bot partilhado pelas ferramentas headless (breakout_sim, rogue_balance).
+ *
+ * Notas:
+ * - Segue a bola livre mais perto do paddle que vem na direcção dele (ou a mais funda), com um
+ *   desvio de pontaria que muda a cada toque no paddle; lança as bolas attached com um ângulo
+ *   aleatório. As cartas do Rogue ficam com quem usa o bot (cada ferramenta tem a sua política).
+ * - O mt19937 vem do seed do jogo: o bot é tão determinístico como a simulação.
+ * - A ordem dos sorteios (pontaria inicial, carta, lançamento, novo aim) faz parte do resultado:
+ *   mudá-la muda os checksums do breakout_sim.
+ */
+namespace simbot {
+
+constexpr float kStep = 1.0f / 240.0f;
+
+inline float autopilotDir(const game::GameState& s, float aimOffset) {
+    int best = -1;
+    float bestZ = -1e30f;
+    bool bestIncoming = false;
+    for (int i = 0; i < s.balls.size(); ++i) {
+        if (s.balls.attached(i)) continue;
+        bool incoming = s.balls.vel(i).z > 0.0f;
+        float z = s.balls.pos(i).z;
+        if ((incoming && !bestIncoming) || (incoming == bestIncoming && z > bestZ)) {
+            best = i;
+            bestZ = z;
+            bestIncoming = incoming;
+        }
+    }
+    if (best < 0) return 0.0f;
+
+    float dx = s.balls.pos(best).x + aimOffset - s.paddlePos.x;
+    if (std::abs(dx) < 0.15f) return 0.0f;
+    float dir = dx > 0.0f ? 1.0f : -1.0f;
+    return s.reverseTimer > 0.0f ? -dir : dir; // a curse inverte os controlos, o bot compensa
+}
+
+struct Bot {
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> uAim{-1.2f, 1.2f};
+    std::uniform_real_distribution<float> uLaunch{-0.5f, 0.5f};
+    float aim = 0.0f;
+
+    explicit Bot(std::uint64_t seed)
+        : rng((std::uint32_t)(seed ^ (seed >> 32)) * 7919u + 1u) {
+        aim = uAim(rng);
+    }
+
+    /// Antes de cada passo: lança as bolas attached e mete o input do paddle no estado.
+    /// @return nº de bolas lançadas (a direcção fica em s.launchInputDir, como no InputSystem).
+    int drive(game::GameState& s, const game::GameConfig& cfg) {
+        int launched = 0;
+        if (s.balls.attachedCount() > 0) {
+            float a = uLaunch(rng);
+            s.launchInputDir = glm::vec3(std::sin(a), 0.0f, -std::cos(a));
+            launched = game::SimulationSystem::launchAttached(s, cfg, s.launchInputDir);
+        }
+        s.paddleInputDir = autopilotDir(s, aim);
+        return launched;
+    }
+
+    /// Depois de cada passo: varia o ponto de impacto a cada toque no paddle.
+    void observe(const game::SimEvent& e) {
+        if (e.type == game::SimEventType::PaddleHit) aim = uAim(rng);
+    }
+};
+
+} // namespace simbot
@@ -0,0 +1,205 @@
+// snapbench.cpp
+// -----------------------------------------------------------------------------
+// snapbench.cpp
+//
+// Responsabilidade:
+//  - Benchmark do snapshot/restore do GameState (game/Snapshot.hpp) num campo Endless cheio:
+//    tempo de save, load e push no SnapshotRing, e bytes por snapshot.
+//  - Verifica que o restore é exacto: o checksum do replay bate certo e um estado reposto
+//    (por cima de outra run qualquer) continua passo a passo igual ao original.
+//
+// Uso:
+//  snapbench [--iters N] [--balls N] [--seed N] [--budget-us U]
+//    --iters      medições de cada operação (default 2000)
+//    --balls      bolas extra em voo (default 0: as do jogo)
+//    --budget-us  falha (exit 1) se a média do save ou do load passar disto (default 50)
+//
+// Notas:
+//  - "Campo cheio": rows do Endless até à última antes da linha de derrota, depois de o bot
+//    jogar uns segundos (slots reciclados, bricks com dano, powerups, streak).
+//  - Medições a quente: os buffers já têm capacidade (como no ring do jogo).
+// -----------------------------------------------------------------------------
+
+#include "game/Replay.hpp"
+#include "game/Snapshot.hpp"
+#include "game/systems/InitSystem.hpp"
+#include "sim_bot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using game::GameConfig;
+using game::GameMode;
+using game::GameState;
+using clock_type = std::chrono::steady_clock;
+
+struct Stats {
+    double mean = 0.0, p50 = 0.0, p99 = 0.0;
+};
+
+Stats summarize(std::vector<double>& us) {
+    Stats s;
+    if (us.empty()) return s;
+    for (double v : us) s.mean += v;
+    s.mean /= (double)us.size();
+    std::sort(us.begin(), us.end());
+    s.p50 = us[us.size() / 2];
+    s.p99 = us[std::min(us.size() - 1, us.size() * 99 / 100)];
+    return s;
+}
+
+template <class Fn>
+Stats measure(int iters, Fn&& fn) {
+    std::vector<double> us((std::size_t)iters);
+    for (int i = 0; i < iters; ++i) {
+        auto t0 = clock_type::now();
+        fn();
+        us[(std::size_t)i] = std::chrono::duration<double, std::micro>(clock_type::now() - t0).count();
+    }
+    return summarize(us);
+}
+
+// Rows do Endless até à última que ainda não perde (a seguinte passaria a linha do paddle).
+void fillField(GameState& s, const GameConfig& cfg) {
+    const float stepZ = 1.30f + 0.03f;
+    const float limitZ = s.paddlePos.z - 0.5f;
+    while (s.bricks.aliveCount() == 0 || s.bricks.deepestMaxZ() + stepZ < limitZ - 0.05f) {
+        game::InitSystem::spawnIncrementalBricks(s, cfg, 12, s.wave);
+    }
+}
+
+void play(GameState& s, const GameConfig& cfg, simbot::Bot& bot, int steps, game::SimEvents& events) {
+    for (int i = 0; i < steps && s.mode == GameMode::PLAYING; ++i) {
+        bot.drive(s, cfg);
+        events.clear();
+        game::SimulationSystem::step(s, cfg, simbot::kStep, events);
+        for (const auto& e : events) bot.observe(e);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iters = 2000, extraBalls = 0;
+    std::uint64_t seed = 1234;
+    double budgetUs = 50.0;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) iters = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--balls") && i + 1 < argc) extraBalls = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--budget-us") && i + 1 < argc) budgetUs = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: snapbench [--iters N] [--balls N] [--seed N] [--budget-us U]\n");
+            return 2;
+        }
+    }
+
+    const GameConfig cfg;
+    game::SimEvents events;
+    events.reserve(64);
+
+    // Estado de teste: Endless cheio, com uns segundos de jogo no meio.
+    GameState a;
+    a.gameType = game::GameType::ENDLESS;
+    game::InitSystem::initGame(a, cfg, seed);
+    a.mode = GameMode::PLAYING;
+    simbot::Bot botA(seed);
+    fillField(a, cfg);
+    play(a, cfg, botA, 240 * 5, events);
+    fillField(a, cfg);
+    for (int k = 0; k < extraBalls; ++k) {
+        game::Ball b;
+        float ang = -1.2f + 2.4f * a.rng.fx.uniform();
+        b.pos = glm::vec3(a.paddlePos.x, 0.0f, a.paddlePos.z - 3.0f);
+        b.vel = glm::vec3(std::sin(ang), 0.0f, -std::cos(ang)) * cfg.ballSpeed;
+        a.balls.add(b);
+    }
+    if (a.mode != GameMode::PLAYING) {
+        std::fprintf(stderr, "snapbench: the warm-up game ended, try another --seed\n");
+        return 2;
+    }
+
+    std::vector<std::uint8_t> buf;
+    { game::SnapshotWriter w(buf); game::saveSnapshot(a, w); }
+
+    std::printf("snapshot: %d bricks alive (%d slots), %d balls, %d powerups, %zu bytes\n",
+                a.bricks.aliveCount(), a.bricks.size(), a.balls.size(), (int)a.powerups.size(), buf.size());
+
+    // Restore por cima de outra run (Rogue, outro seed): o load tem de substituir tudo.
+    GameState b;
+    b.gameType = game::GameType::ROGUE;
+    game::InitSystem::initGame(b, cfg, seed + 99);
+    {
+        game::SnapshotReader r(buf);
+        if (!game::loadSnapshot(b, r)) {
+            std::fprintf(stderr, "snapbench: loadSnapshot failed\n");
+            return 1;
+        }
+    }
+
+    int failures = 0;
+    if (game::replayStateChecksum(a) != game::replayStateChecksum(b)) {
+        std::printf("restore: checksum differs right after load\n");
+        failures++;
+    }
+
+    // Os dois continuam com o mesmo bot (mesmo seed, mesmo estado interno): têm de ficar iguais.
+    {
+        GameState a2 = a;
+        simbot::Bot botA2 = botA, botB = botA;
+        const int steps = 240 * 20;
+        play(a2, cfg, botA2, steps, events);
+        play(b, cfg, botB, steps, events);
+        const bool same = game::replayStateChecksum(a2) == game::replayStateChecksum(b);
+        std::printf("restore: %d steps after load %s (score %d vs %d)\n",
+                    steps, same ? "match the original" : "DIVERGE", a2.score, b.score);
+        if (!same) failures++;
+    }
+
+    // Medições (buffers e estado de destino já aquecidos).
+    GameState dst = a;
+    Stats save = measure(iters, [&] { game::SnapshotWriter w(buf); game::saveSnapshot(a, w); });
+    Stats load = measure(iters, [&] { game::SnapshotReader r(buf); game::loadSnapshot(dst, r); });
+
+    game::SnapshotRing ring;
+    ring.reset(64, 1);
+    std::uint64_t tick = 0;
+    Stats push = measure(iters, [&] { ring.push(++tick, a); });
+
+    int idx = 0;
+    Stats restore = measure(iters, [&] {
+        game::SnapshotReader r = ring.reader(idx);
+        game::loadSnapshot(dst, r);
+        idx = (idx + 7) % ring.size();
+    });
+
+    std::printf("\n%-22s | %9s | %9s | %9s\n", "operation", "mean", "p50", "p99");
+    auto row = [](const char* name, const Stats& s) {
+        std::printf("%-22s | %6.2f us | %6.2f us | %6.2f us\n", name, s.mean, s.p50, s.p99);
+    };
+    row("save (saveSnapshot)", save);
+    row("load (loadSnapshot)", load);
+    row("ring push (64 slots)", push);
+    row("ring restore", restore);
+    std::printf("ring: %d snapshots, %zu KB reserved\n", ring.size(), ring.memoryBytes() / 1024);
+
+    if (save.mean > budgetUs || load.mean > budgetUs) {
+        std::printf("over budget: save/load must stay under %.0f us\n", budgetUs);
+        failures++;
+    } else {
+        std::printf("within budget (%.0f us)\n", budgetUs);
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "[snapbench] %d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}